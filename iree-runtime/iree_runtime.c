@@ -10,6 +10,53 @@ GENERATE_MODULE_STATUSES_STR(RUNTIME);
 
 extern const char *const MESSAGE_TYPE_STR[];
 
+/**
+ * Baudrate to fall back to if the baudrate change is not confirmed by valid message. It is 0 if there is no pending
+ * baudrate change
+ */
+ut_static uint32_t g_fallback_baudrate = 0;
+/**
+ * Time of the last baudrate change
+ */
+ut_static uint32_t g_baudrate_change_time = 0;
+/**
+ * True if UART and timer interrupts can wake the core up, so the runtime can sleep instead of polling when idle
+ */
+ut_static bool g_idle_enabled = false;
+
+/**
+ * Ring of the latest results of the inferences run on the input reader data
+ */
+ut_static inference_result_t g_result_ring[RESULT_RING_LEN];
+/**
+ * Index of the ring entry the next result is written into
+ */
+ut_static size_t g_result_ring_head = 0;
+/**
+ * Number of results in the ring that were not fetched by the client yet
+ */
+ut_static size_t g_result_ring_count = 0;
+/**
+ * Mode of pushing results to the client
+ */
+ut_static RESULT_MODE g_result_mode = RESULT_MODE_OFF;
+/**
+ * Top class of the last pushed result or RESULT_NO_CLASS if no result was pushed in the current mode
+ */
+ut_static uint32_t g_last_pushed_class = RESULT_NO_CLASS;
+/**
+ * Counters at the beginning of sending the last response. The response is sent in the background, so the send phase is
+ * recorded from the callback of the sent message
+ */
+ut_static profiler_timestamp_t g_response_send_start = {0};
+/**
+ * Numbers of model output parts queued for transmission straight from the result buffers and of the parts already
+ * sent. The result buffers cannot be released or overwritten while they differ. Each counter is written only by one
+ * side, so the sent parts can be counted from the interrupt handler without locking
+ */
+ut_static size_t g_model_output_parts_queued = 0;
+ut_static volatile size_t g_model_output_parts_sent = 0;
+
 ut_static callback_ptr g_msg_callback[NUM_MESSAGE_TYPES] = {
 #define ENTRY(msg_type, callback_func) callback_func,
     CALLBACKS(ENTRY)
@@ -32,6 +79,20 @@ static bool init_server();
  */
 static bool wait_for_message(message_t **msg);
 
+/**
+ * Checks if the next input should be read now. If the runtime can sleep, the input is not read before it is due, so
+ * that the input reader does not busy-wait for it
+ *
+ * @returns true if input should be read
+ */
+static bool is_input_due();
+
+/**
+ * Sleeps until an interrupt occurs if there is no pending message. The sleep is bounded by the time of the next input
+ * read and by the baudrate fallback timeout, which are armed as the timer alarm
+ */
+static void idle();
+
 /**
  * Handles received message
  *
@@ -39,6 +100,90 @@ static bool wait_for_message(message_t **msg);
  */
 static void handle_message(message_t *msg);
 
+/**
+ * Records the send phase once the response is moved to the UART. It may be called from the interrupt handler
+ *
+ * @param data sent data
+ * @param data_length size of the sent data
+ */
+static void response_sent(const uint8_t *data, const size_t data_length);
+
+/**
+ * Provides buffer for MODEL message so that the model weights are received straight into the model weights buffer
+ *
+ * @param msg_size size of the message
+ *
+ * @returns pointer to the message buffer or NULL if the weights cannot be received into the model weights buffer
+ */
+static message_t *get_model_message_buffer(const message_size_t msg_size);
+
+/**
+ * Sends model output as the response, streaming it straight from the result buffers. If next inputs are given, the
+ * model is run on each of them after the current output is sent and their outputs are appended to the response
+ *
+ * @param request incoming message. It is overwritten with NULL as the response is sent here, or by the ERROR message
+ * @param next_inputs concatenated model inputs, may be NULL if next_inputs_count is 0
+ * @param model_input_size size of a single model input
+ * @param next_inputs_count number of next inputs
+ *
+ * @returns error status of the runtime
+ */
+static status_t send_model_output(message_t **request, const uint8_t *next_inputs, const size_t model_input_size,
+                                  const size_t next_inputs_count);
+
+/**
+ * Queues part of the model output for transmission straight from the result buffer. The result buffers are host-local
+ * heap buffers, so the mapped memory stays valid until the buffers are released by the next inference or model unload,
+ * which wait for the queued parts to be sent
+ *
+ * @param payload part of the model output
+ * @param payload_size size of the part
+ *
+ * @returns error status of the protocol
+ */
+static status_t send_model_output_payload(const uint8_t *payload, const size_t payload_size);
+
+/**
+ * Counts sent part of the model output. It may be called from the interrupt handler
+ *
+ * @param data sent data
+ * @param data_length size of the sent data
+ */
+static void model_output_part_sent(const uint8_t *data, const size_t data_length);
+
+/**
+ * Waits until all parts of the model output queued for transmission are sent, so that the result buffers can be
+ * released or overwritten. It returns immediately if no part is queued
+ *
+ * @returns error status of the protocol
+ */
+static status_t wait_for_model_output_sent();
+
+/**
+ * Runs inference on the input read by the input reader and records its result in the result ring. Failure of recording
+ * the result is only logged, as it does not affect the model
+ *
+ * @returns error status of the model
+ */
+static status_t run_input_inference();
+
+/**
+ * Records result of the inference in the result ring and pushes it to the client according to the result mode
+ *
+ * @param inference_cycles number of cycles spent in the inference
+ *
+ * @returns error status of the runtime
+ */
+static status_t record_result(const uint32_t inference_cycles);
+
+/**
+ * Confirms pending baudrate change if valid message was received, or falls back to the previous baudrate if no valid
+ * message was received within BAUDRATE_FALLBACK_TIMEOUT_S
+ *
+ * @param message_received true if valid message was received
+ */
+static void check_baudrate_fallback(const bool message_received);
+
 #ifndef __UNIT_TEST__
 /**
  * Main Runtime function. It initializes UART and then handles messages in an infinite loop.
@@ -58,8 +203,8 @@ int main()
 
         do
         {
-            // read input if model is loaded
-            if (get_model_state() < MODEL_STATE_WEIGHTS_LOADED)
+            // read input if model is loaded and input is due
+            if (get_model_state() < MODEL_STATE_WEIGHTS_LOADED || !is_input_due())
             {
                 break;
             }
@@ -85,7 +230,7 @@ int main()
                 break;
             }
 
-            status = run_model();
+            status = run_input_inference();
 
             if (STATUS_OK != status)
             {
@@ -94,6 +239,12 @@ int main()
                 break;
             }
         } while (0);
+        // there is nothing to compute, so sleep until the message arrives or the next input is due
+        if (g_idle_enabled && !uart_rx_pending())
+        {
+            idle();
+            continue;
+        }
         if (wait_for_message(&msg))
         {
             handle_message(msg);
@@ -113,8 +264,34 @@ bool init_server()
         uart_config_t config = {.data_bits = 8, .stop_bits = 1, .parity = false, .baudrate = 115200};
         status = uart_init(&config);
         CHECK_INIT_STATUS_RET(status, "uart_init returned 0x%x (%s)", status, get_status_str(status));
+
+        // switch UART to interrupt-driven mode
+        status = interrupts_init();
+        CHECK_INIT_STATUS_RET(status, "interrupts_init returned 0x%x (%s)", status, get_status_str(status));
+        status = interrupts_register_handler(INTERRUPT_SOURCE_MACHINE_EXTERNAL, uart_irq_handler);
+        CHECK_INIT_STATUS_RET(status, "interrupts_register_handler returned 0x%x (%s)", status,
+                              get_status_str(status));
+        status = uart_irq_enable();
+        CHECK_INIT_STATUS_RET(status, "uart_irq_enable returned 0x%x (%s)", status, get_status_str(status));
+        status = interrupts_enable(INTERRUPT_SOURCE_MACHINE_EXTERNAL);
+        CHECK_INIT_STATUS_RET(status, "interrupts_enable returned 0x%x (%s)", status, get_status_str(status));
+
+        // wake up from idle on timer alarms
+        status = timer_init();
+        CHECK_INIT_STATUS_RET(status, "timer_init returned 0x%x (%s)", status, get_status_str(status));
+        status = interrupts_register_handler(INTERRUPT_SOURCE_MACHINE_TIMER, timer_irq_handler);
+        CHECK_INIT_STATUS_RET(status, "interrupts_register_handler returned 0x%x (%s)", status,
+                              get_status_str(status));
+        status = interrupts_enable(INTERRUPT_SOURCE_MACHINE_TIMER);
+        CHECK_INIT_STATUS_RET(status, "interrupts_enable returned 0x%x (%s)", status, get_status_str(status));
+        g_idle_enabled = true;
     }
 
+    // receive model weights without copying
+    status = register_message_buffer_provider(MESSAGE_TYPE_MODEL, get_model_message_buffer);
+    CHECK_INIT_STATUS_RET(status, "register_message_buffer_provider returned 0x%x (%s)", status,
+                          get_status_str(status));
+
     // initialize I2C
     if (i2c_init)
     {
@@ -129,6 +306,13 @@ bool init_server()
         status = sensor_init();
         CHECK_INIT_STATUS_RET(status, "sensor_init returned 0x%x (%s)", status, get_status_str(status));
     }
+
+    // pace sensor reads with the timer interrupt, so that the sampling rate does not depend on the main loop
+    if (sensor_start_sampling && g_idle_enabled)
+    {
+        status = sensor_start_sampling();
+        CHECK_INIT_STATUS_RET(status, "sensor_start_sampling returned 0x%x (%s)", status, get_status_str(status));
+    }
     LOG_INFO("Runtime started");
     return true;
 }
@@ -136,13 +320,25 @@ bool init_server()
 bool wait_for_message(message_t **msg)
 {
     status_t status = STATUS_OK;
+    profiler_timestamp_t start = {0};
 
     if (!IS_VALID_POINTER(msg))
     {
         return false;
     }
 
+    profiler_start(&start);
     status = receive_message(msg);
+    if (PROTOCOL_STATUS_DATA_READY == status && (*msg)->message_type >= NUM_MESSAGE_TYPES)
+    {
+        status = PROTOCOL_STATUS_DATA_INV;
+    }
+    if (PROTOCOL_STATUS_DATA_READY == status)
+    {
+        profiler_record(PROFILER_PHASE_RECEIVE, &start);
+    }
+    check_baudrate_fallback(PROTOCOL_STATUS_DATA_READY == status);
+
     if (PROTOCOL_STATUS_TIMEOUT == status)
     {
         LOG_WARN("Receive message timeout");
@@ -159,6 +355,62 @@ bool wait_for_message(message_t **msg)
     return true;
 }
 
+bool is_input_due()
+{
+    uint32_t input_time = 0;
+    uint32_t time = 0;
+
+    if (!g_idle_enabled || STATUS_OK != get_next_input_time(&input_time))
+    {
+        return true;
+    }
+    CSR_READ(time, CSR_TIME);
+
+    return TIME_REACHED(input_time, time);
+}
+
+void idle()
+{
+    uint32_t time = 0;
+    uint32_t wakeup_time = 0;
+    bool wakeup_time_set = false;
+    uint32_t irq_state = 0;
+
+    if (get_model_state() >= MODEL_STATE_WEIGHTS_LOADED && STATUS_OK == get_next_input_time(&wakeup_time))
+    {
+        wakeup_time_set = true;
+    }
+    if (0 != g_fallback_baudrate)
+    {
+        uint32_t fallback_time =
+            g_baudrate_change_time + (uint32_t)(BAUDRATE_FALLBACK_TIMEOUT_S * TIMER_CLOCK_FREQ) + 1;
+        if (!wakeup_time_set || TIME_REACHED(fallback_time, wakeup_time))
+        {
+            wakeup_time = fallback_time;
+        }
+        wakeup_time_set = true;
+    }
+    if (wakeup_time_set && STATUS_OK != timer_set_alarm(wakeup_time))
+    {
+        return;
+    }
+
+    // conditions are checked with interrupts locked, so that the interrupt cannot be handled between the check and wfi
+    irq_state = interrupts_lock();
+    CSR_READ(time, CSR_TIME);
+    if (!uart_rx_pending() && !(wakeup_time_set && TIME_REACHED(wakeup_time, time)))
+    {
+        interrupts_wait();
+    }
+    interrupts_unlock(irq_state);
+
+    if (wakeup_time_set)
+    {
+        timer_cancel_alarm();
+    }
+    check_baudrate_fallback(false);
+}
+
 void handle_message(message_t *msg)
 {
     status_t status = STATUS_OK;
@@ -177,7 +429,9 @@ void handle_message(message_t *msg)
     {
         LOG_DEBUG("Sending reponse. Size: %d, type: %d (%s)", msg->message_size, msg->message_type,
                   MESSAGE_TYPE_STR[msg->message_type]);
-        status = send_message(msg);
+        // the response is sent in the background, the message buffer is not reused until it is sent
+        profiler_start(&g_response_send_start);
+        status = send_message_async(msg, response_sent);
         if (STATUS_OK != status)
         {
             LOG_ERROR("Error sending message: 0x%x (%s)", status, get_status_str(status));
@@ -185,6 +439,208 @@ void handle_message(message_t *msg)
     }
 }
 
+void response_sent(const uint8_t *data, const size_t data_length)
+{
+    profiler_record(PROFILER_PHASE_SEND, &g_response_send_start);
+}
+
+message_t *get_model_message_buffer(const message_size_t msg_size)
+{
+    uint8_t *model_weights_buffer = NULL;
+
+    // loaded model is released, so its result buffers cannot be queued for transmission
+    if (STATUS_OK != wait_for_model_output_sent())
+    {
+        return NULL;
+    }
+
+    if (STATUS_OK != get_model_weights_buffer(MESSAGE_SIZE_PAYLOAD(msg_size), &model_weights_buffer))
+    {
+        return NULL;
+    }
+
+    // message header is placed in the space reserved in front of the weights
+    return (message_t *)(model_weights_buffer - sizeof(message_t));
+}
+
+status_t send_model_output(message_t **request, const uint8_t *next_inputs, const size_t model_input_size,
+                           const size_t next_inputs_count)
+{
+    status_t status = STATUS_OK;
+    size_t model_output_size = 0;
+    profiler_timestamp_t start = {0};
+
+    // output has to be available before the response header is sent
+    if (get_model_state() < MODEL_STATE_INFERENCE_DONE)
+    {
+        status = MODEL_STATUS_INV_STATE;
+    }
+    else
+    {
+        status = get_model_output_size(&model_output_size);
+    }
+
+    CHECK_STATUS_LOG(status, request, "get_model_output_size returned 0x%x (%s)", status, get_status_str(status));
+
+    // the response is sent here, so that outputs are streamed straight from the result buffers
+    *request = NULL;
+
+    status = send_message_header(MESSAGE_TYPE_OK, (next_inputs_count + 1) * model_output_size);
+    RETURN_ON_ERROR(status, status);
+
+    // the header is already sent, so in case of failure the response stays incomplete and the client times out
+    for (size_t i = 0; i <= next_inputs_count; ++i)
+    {
+        if (i > 0)
+        {
+            // result buffers of the previous output are overwritten by the inference
+            status = wait_for_model_output_sent();
+            BREAK_ON_ERROR(status);
+
+            status = load_model_input(next_inputs + (i - 1) * model_input_size, model_input_size);
+            BREAK_ON_ERROR(status);
+
+            status = run_model();
+            BREAK_ON_ERROR(status);
+        }
+        profiler_start(&start);
+        status = write_model_output(send_model_output_payload);
+        BREAK_ON_ERROR(status);
+        profiler_record(PROFILER_PHASE_GET_OUTPUT, &start);
+    }
+    if (STATUS_OK != status)
+    {
+        LOG_ERROR("Sending model output failed: 0x%x (%s)", status, get_status_str(status));
+        return status;
+    }
+    LOG_DEBUG("Model output sent");
+
+    return STATUS_OK;
+}
+
+status_t send_model_output_payload(const uint8_t *payload, const size_t payload_size)
+{
+    status_t status = STATUS_OK;
+
+    ++g_model_output_parts_queued;
+
+    status = send_message_payload_async(payload, payload_size, model_output_part_sent);
+    if (STATUS_OK != status)
+    {
+        // callback is not called for the part that was not queued
+        --g_model_output_parts_queued;
+    }
+
+    return status;
+}
+
+void model_output_part_sent(const uint8_t *data, const size_t data_length)
+{
+    ++g_model_output_parts_sent;
+}
+
+status_t wait_for_model_output_sent()
+{
+    status_t status = STATUS_OK;
+
+    while (g_model_output_parts_queued != g_model_output_parts_sent)
+    {
+        status = flush_messages();
+        RETURN_ON_ERROR(status, status);
+    }
+
+    return STATUS_OK;
+}
+
+status_t run_input_inference()
+{
+    status_t status = STATUS_OK;
+    uint32_t inference_start = 0;
+    uint32_t inference_end = 0;
+
+    // result buffers of the previous inference may still be queued for transmission
+    status = wait_for_model_output_sent();
+    RETURN_ON_ERROR(status, status);
+
+    CSR_READ(inference_start, CSR_CYCLE);
+    status = run_model();
+    CSR_READ(inference_end, CSR_CYCLE);
+    RETURN_ON_ERROR(status, status);
+
+    status = record_result(inference_end - inference_start);
+    if (STATUS_OK != status)
+    {
+        LOG_ERROR("record_result returned 0x%x (%s)", status, get_status_str(status));
+    }
+
+    return STATUS_OK;
+}
+
+status_t record_result(const uint32_t inference_cycles)
+{
+    status_t status = STATUS_OK;
+    inference_result_t *result = &g_result_ring[g_result_ring_head];
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+    uint32_t time = 0;
+
+    status = get_model_output_top_class(&top_class, &top_score);
+    RETURN_ON_ERROR(status, status);
+
+    CSR_READ(time, CSR_TIME);
+    result->timestamp = time;
+    result->inference_cycles = inference_cycles;
+    result->top_class = top_class;
+    result->top_score = top_score;
+
+    g_result_ring_head = (g_result_ring_head + 1) % RESULT_RING_LEN;
+    if (g_result_ring_count < RESULT_RING_LEN)
+    {
+        ++g_result_ring_count;
+    }
+
+    if (RESULT_MODE_OFF == g_result_mode ||
+        (RESULT_MODE_ON_CHANGE == g_result_mode && result->top_class == g_last_pushed_class))
+    {
+        return STATUS_OK;
+    }
+    g_last_pushed_class = result->top_class;
+
+    status = send_message_header(MESSAGE_TYPE_RESULT, sizeof(inference_result_t));
+    RETURN_ON_ERROR(status, status);
+
+    // the result is copied into the TX buffer, as the ring entry can be overwritten before the queued data is sent
+    return send_message_payload((uint8_t *)result, sizeof(inference_result_t));
+}
+
+void check_baudrate_fallback(const bool message_received)
+{
+    uint32_t time = 0;
+
+    if (0 == g_fallback_baudrate)
+    {
+        return;
+    }
+    if (message_received)
+    {
+        LOG_DEBUG("Baudrate change confirmed");
+        g_fallback_baudrate = 0;
+        return;
+    }
+
+    CSR_READ(time, CSR_TIME);
+    if (time - g_baudrate_change_time > (uint32_t)(BAUDRATE_FALLBACK_TIMEOUT_S * TIMER_CLOCK_FREQ))
+    {
+        LOG_WARN("Baudrate change not confirmed, falling back to %d", g_fallback_baudrate);
+        status_t status = uart_set_baudrate(g_fallback_baudrate);
+        if (STATUS_OK != status)
+        {
+            LOG_ERROR("uart_set_baudrate returned 0x%x (%s)", status, get_status_str(status));
+        }
+        g_fallback_baudrate = 0;
+    }
+}
+
 /**
  * Handles OK message
  *
@@ -253,6 +709,10 @@ status_t model_callback(message_t **request)
 
     VALIDATE_REQUEST(MESSAGE_TYPE_MODEL, request);
 
+    status = wait_for_model_output_sent();
+
+    CHECK_STATUS_LOG(status, request, "wait_for_model_output_sent returned 0x%x (%s)", status, get_status_str(status));
+
     status = load_model_weights((*request)->payload, MESSAGE_SIZE_PAYLOAD((*request)->message_size));
 
     CHECK_STATUS_LOG(status, request, "load_model_weights returned 0x%x (%s)", status, get_status_str(status));
@@ -276,6 +736,10 @@ status_t process_callback(message_t **request)
 
     VALIDATE_REQUEST(MESSAGE_TYPE_PROCESS, request);
 
+    status = wait_for_model_output_sent();
+
+    CHECK_STATUS_LOG(status, request, "wait_for_model_output_sent returned 0x%x (%s)", status, get_status_str(status));
+
     status = run_model();
 
     CHECK_STATUS_LOG(status, request, "run_model returned 0x%x (%s)", status, get_status_str(status));
@@ -287,32 +751,62 @@ status_t process_callback(message_t **request)
 }
 
 /**
- * Handles OUTPUT message. It retrieves model inference output and sends it back
+ * Handles OUTPUT message. It retrieves model inference output and streams it back straight from the result buffers.
+ * If the message contains output_reduction_t payload, the output is reduced on the device and only the selected classes
+ * with their scores are sent back
  *
- * @param request incoming message. It is overwritten by the response message (DATA message containig model output or
- *                ERROR message)
+ * @param request incoming message. It is overwritten with NULL as the response containing model output is sent here, or
+ *                by the response message (OK message containing selected classes or ERROR message)
  *
  * @returns error status of the runtime
  */
 status_t output_callback(message_t **request)
 {
     status_t status = STATUS_OK;
-    size_t model_output_size = 0;
+    output_reduction_t reduction = {0};
+    size_t num_classes = 0;
+    profiler_timestamp_t start = {0};
 
     VALIDATE_REQUEST(MESSAGE_TYPE_OUTPUT, request);
 
-    status = get_model_output(MAX_MESSAGE_SIZE_BYTES - sizeof(message_t), (*request)->payload, &model_output_size);
+    if (0 == MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        return send_model_output(request, NULL, 0, 0);
+    }
 
-    CHECK_STATUS_LOG(status, request, "get_model_output returned 0x%x (%s)", status, get_status_str(status));
+    if (sizeof(output_reduction_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        // the payload is overwritten by the selected classes
+        reduction = *((output_reduction_t *)(*request)->payload);
+        if (reduction.max_classes > OUTPUT_REDUCTION_MAX_CLASSES)
+        {
+            status = RUNTIME_STATUS_INV_ARG;
+        }
+        else
+        {
+            profiler_start(&start);
+            status = reduce_model_output(reduction.max_classes, reduction.threshold,
+                                         (model_class_score_t *)(*request)->payload, &num_classes);
+        }
+    }
+
+    CHECK_STATUS_LOG(status, request, "reduce_model_output returned 0x%x (%s)", status, get_status_str(status));
 
-    (*request)->message_size = model_output_size + sizeof(message_type_t);
+    profiler_record(PROFILER_PHASE_GET_OUTPUT, &start);
+
+    (*request)->message_size = num_classes * sizeof(model_class_score_t) + sizeof(message_type_t);
     (*request)->message_type = MESSAGE_TYPE_OK;
 
     return STATUS_OK;
 }
 
 /**
- * Handles STATS message. It retrieves model statistics
+ * Handles STATS message. It retrieves model statistics followed by the profiler statistics of the request handling
+ * phases
  *
  * @param request incoming message. It is overwritten by the response message (STATS message containig model
  *                statistics or ERROR message)
@@ -323,6 +817,7 @@ status_t stats_callback(message_t **request)
 {
     status_t status = STATUS_OK;
     size_t statistics_length = 0;
+    size_t profiler_stats_length = 0;
 
     VALIDATE_REQUEST(MESSAGE_TYPE_STATS, request);
 
@@ -331,7 +826,12 @@ status_t stats_callback(message_t **request)
 
     CHECK_STATUS_LOG(status, request, "get_statistics returned 0x%x (%s)", status, get_status_str(status));
 
-    (*request)->message_size = statistics_length + sizeof(message_type_t);
+    status = profiler_get_stats(MAX_MESSAGE_SIZE_BYTES - sizeof(message_t) - statistics_length,
+                                &(*request)->payload[statistics_length], &profiler_stats_length);
+
+    CHECK_STATUS_LOG(status, request, "profiler_get_stats returned 0x%x (%s)", status, get_status_str(status));
+
+    (*request)->message_size = statistics_length + profiler_stats_length + sizeof(message_type_t);
     (*request)->message_type = MESSAGE_TYPE_OK;
 
     return STATUS_OK;
@@ -354,6 +854,403 @@ status_t iospec_callback(message_t **request)
 
     CHECK_STATUS_LOG(status, request, "load_model_struct returned 0x%x (%s)", status, get_status_str(status));
 
+    // statistics of the previous model are not mixed with the new one
+    profiler_reset();
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles MODEL_BEGIN message that begins multi-part model upload. Its payload contains total size of the model data
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t model_begin_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_MODEL_BEGIN, request);
+
+    status = wait_for_model_output_sent();
+
+    CHECK_STATUS_LOG(status, request, "wait_for_model_output_sent returned 0x%x (%s)", status, get_status_str(status));
+
+    if (sizeof(uint32_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        status = begin_model_weights_upload(*((uint32_t *)(*request)->payload));
+    }
+
+    CHECK_STATUS_LOG(status, request, "begin_model_weights_upload returned 0x%x (%s)", status,
+                     get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles MODEL_CHUNK message that contains next part of the model data
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t model_chunk_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_MODEL_CHUNK, request);
+
+    status = load_model_weights_chunk((*request)->payload, MESSAGE_SIZE_PAYLOAD((*request)->message_size));
+
+    CHECK_STATUS_LOG(status, request, "load_model_weights_chunk returned 0x%x (%s)", status, get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles MODEL_COMMIT message that finishes multi-part model upload. It calls model's function that loads the model
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t model_commit_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_MODEL_COMMIT, request);
+
+    status = wait_for_model_output_sent();
+
+    CHECK_STATUS_LOG(status, request, "wait_for_model_output_sent returned 0x%x (%s)", status, get_status_str(status));
+
+    status = commit_model_weights_upload();
+
+    CHECK_STATUS_LOG(status, request, "commit_model_weights_upload returned 0x%x (%s)", status,
+                     get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles INFER message that contains one or more concatenated model inputs. For each input it loads the input, runs
+ * the model and sends back its output. Outputs of all inputs are sent back in a single response
+ *
+ * @param request incoming message. It is overwritten with NULL as the response containing model outputs is sent here,
+ *                or by the ERROR message
+ *
+ * @returns error status of the runtime
+ */
+status_t infer_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+    size_t model_input_size = 0;
+    size_t batch_size = 0;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_INFER, request);
+
+    const uint8_t *model_input = (*request)->payload;
+    const size_t payload_size = MESSAGE_SIZE_PAYLOAD((*request)->message_size);
+
+    status = get_model_input_size(&model_input_size);
+
+    CHECK_STATUS_LOG(status, request, "get_model_input_size returned 0x%x (%s)", status, get_status_str(status));
+
+    if (0 == model_input_size || 0 == payload_size || 0 != payload_size % model_input_size)
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+
+    CHECK_STATUS_LOG(status, request, "Batch size: %d, payload size: %d, input size: %d",
+                     model_input_size ? payload_size / model_input_size : 0, payload_size, model_input_size);
+
+    batch_size = payload_size / model_input_size;
+
+    status = wait_for_model_output_sent();
+
+    CHECK_STATUS_LOG(status, request, "wait_for_model_output_sent returned 0x%x (%s)", status, get_status_str(status));
+
+    // first input is processed before the response is sent, so that errors are reported with the ERROR message
+    status = load_model_input(model_input, model_input_size);
+
+    CHECK_STATUS_LOG(status, request, "load_model_input returned 0x%x (%s)", status, get_status_str(status));
+
+    status = run_model();
+
+    CHECK_STATUS_LOG(status, request, "run_model returned 0x%x (%s)", status, get_status_str(status));
+
+    // remaining inputs are run while the outputs are streamed
+    return send_model_output(request, model_input + model_input_size, model_input_size, batch_size - 1);
+}
+
+/**
+ * Handles BAUDRATE message which payload contains new UART baudrate. The response is sent at the current baudrate and
+ * then the baudrate is changed. If no valid message is received at the new baudrate, the previous one is restored
+ *
+ * @param request incoming message. It is overwritten with NULL as the OK response is sent here, or by the ERROR message
+ *
+ * @returns error status of the runtime
+ */
+status_t baudrate_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 0;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_BAUDRATE, request);
+
+    if (sizeof(uint32_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        baudrate = *((uint32_t *)(*request)->payload);
+        status = uart_check_baudrate(baudrate);
+    }
+
+    CHECK_STATUS_LOG(status, request, "uart_check_baudrate returned 0x%x (%s)", status, get_status_str(status));
+
+    // acknowledge at the current baudrate
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    status = send_message(*request);
+    *request = NULL;
+    RETURN_ON_ERROR(status, status);
+
+    uint32_t current_baudrate = uart_get_baudrate();
+
+    status = uart_set_baudrate(baudrate);
+    if (STATUS_OK != status)
+    {
+        LOG_ERROR("uart_set_baudrate returned 0x%x (%s)", status, get_status_str(status));
+        return status;
+    }
+    LOG_DEBUG("Baudrate changed to %d", baudrate);
+
+    // the change has to be confirmed by valid message received at the new baudrate
+    if (current_baudrate != baudrate)
+    {
+        g_fallback_baudrate = current_baudrate;
+        CSR_READ(g_baudrate_change_time, CSR_TIME);
+    }
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles SENSOR_CONFIG message which payload contains new output data rate and measurement range of the sensor
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t sensor_config_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_SENSOR_CONFIG, request);
+
+    if (!sensor_configure)
+    {
+        status = RUNTIME_STATUS_NOT_SUPPORTED;
+    }
+    else if (sizeof(sensor_config_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        sensor_config_t *config = (sensor_config_t *)(*request)->payload;
+        status = sensor_configure(config->data_rate, config->range);
+    }
+
+    CHECK_STATUS_LOG(status, request, "sensor_configure returned 0x%x (%s)", status, get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles INPUT_STRIDE message which payload contains number of new input samples after which the inference is run
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t input_stride_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_INPUT_STRIDE, request);
+
+    if (sizeof(uint32_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        status = set_input_stride(*((uint32_t *)(*request)->payload));
+    }
+
+    CHECK_STATUS_LOG(status, request, "set_input_stride returned 0x%x (%s)", status, get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles ACTIVITY_THRESHOLD message which payload contains input variance threshold below which the inference is
+ * skipped
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t activity_threshold_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_ACTIVITY_THRESHOLD, request);
+
+    if (sizeof(float) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        status = set_input_activity_threshold(*((float *)(*request)->payload));
+    }
+
+    CHECK_STATUS_LOG(status, request, "set_input_activity_threshold returned 0x%x (%s)", status,
+                     get_status_str(status));
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles RESULT message. It retrieves results of the inferences run on the input reader data that were not fetched
+ * yet, oldest first
+ *
+ * @param request incoming message. It is overwritten by the response message (OK message containing results or ERROR
+ *                message)
+ *
+ * @returns error status of the runtime
+ */
+status_t result_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_RESULT, request);
+
+    if (0 != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+
+    CHECK_STATUS_LOG(status, request, "Payload size: %d, status: 0x%x (%s)",
+                     MESSAGE_SIZE_PAYLOAD((*request)->message_size), status, get_status_str(status));
+
+    LOG_DEBUG("Results to fetch: %d", g_result_ring_count);
+
+    inference_result_t *results = (inference_result_t *)(*request)->payload;
+    size_t result_idx = (g_result_ring_head + RESULT_RING_LEN - g_result_ring_count) % RESULT_RING_LEN;
+    for (size_t i = 0; i < g_result_ring_count; ++i)
+    {
+        results[i] = g_result_ring[result_idx];
+        result_idx = (result_idx + 1) % RESULT_RING_LEN;
+    }
+
+    (*request)->message_size = g_result_ring_count * sizeof(inference_result_t) + sizeof(message_type_t);
+    (*request)->message_type = MESSAGE_TYPE_OK;
+
+    g_result_ring_count = 0;
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles RESULT_MODE message which payload contains mode of pushing results of the inferences run on the input reader
+ * data as RESULT messages
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t result_mode_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_RESULT_MODE, request);
+
+    if (sizeof(uint32_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size) ||
+        *((uint32_t *)(*request)->payload) >= NUM_RESULT_MODES)
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        g_result_mode = *((uint32_t *)(*request)->payload);
+        // the first result in the new mode is always pushed
+        g_last_pushed_class = RESULT_NO_CLASS;
+    }
+
+    CHECK_STATUS_LOG(status, request, "Result mode: %d", g_result_mode);
+
+    status = prepare_success_response(request);
+    RETURN_ON_ERROR(status, status);
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles PREPROCESSING message which payload contains configuration of the preprocessing of the model input
+ *
+ * @param request incoming message. It is overwritten by the response message (OK/ERROR message)
+ *
+ * @returns error status of the runtime
+ */
+status_t preprocessing_callback(message_t **request)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_REQUEST(MESSAGE_TYPE_PREPROCESSING, request);
+
+    if (sizeof(preprocessing_config_t) != MESSAGE_SIZE_PAYLOAD((*request)->message_size))
+    {
+        status = RUNTIME_STATUS_INV_ARG;
+    }
+    else
+    {
+        status = preprocessing_configure((preprocessing_config_t *)(*request)->payload);
+    }
+
+    CHECK_STATUS_LOG(status, request, "preprocessing_configure returned 0x%x (%s)", status, get_status_str(status));
+
     status = prepare_success_response(request);
     RETURN_ON_ERROR(status, status);
 
@@ -15,8 +15,12 @@
 
 #include "utils/i2c.h"
 #include "utils/input_reader.h"
+#include "utils/interrupts.h"
 #include "utils/model.h"
+#include "utils/preprocessing.h"
+#include "utils/profiler.h"
 #include "utils/protocol.h"
+#include "utils/timer.h"
 #include "utils/utils.h"
 
 #define VALIDATE_REQUEST(callback_message_type, request)       \
@@ -42,7 +46,9 @@
 /**
  * Runtime custom error codes
  */
-#define RUNTIME_STATUSES(STATUS) STATUS(RUNTIME_STATUS_INV_MSG_TYPE)
+#define RUNTIME_STATUSES(STATUS)      \
+    STATUS(RUNTIME_STATUS_INV_MSG_TYPE) \
+    STATUS(RUNTIME_STATUS_NOT_SUPPORTED)
 
 GENERATE_MODULE_STATUSES(RUNTIME);
 
@@ -54,6 +60,67 @@ GENERATE_MODULE_STATUSES(RUNTIME);
     }                                                          \
     LOG_DEBUG(log_format, ##log_args);
 
+/**
+ * Time after which UART falls back to the previous baudrate if no valid message is received at the new one
+ */
+#define BAUDRATE_FALLBACK_TIMEOUT_S (2.0F)
+
+/**
+ * Payload of SENSOR_CONFIG message
+ */
+typedef struct __attribute__((packed))
+{
+    float data_rate; /* output data rate in Hz */
+    uint32_t range;  /* measurement range, in units specific to the sensor */
+} sensor_config_t;
+
+/**
+ * Optional payload of OUTPUT message. If present, the model output is reduced on the device to up to max_classes
+ * classes with the highest scores not lower than threshold, i.e. max_classes = 1 gives argmax
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t max_classes; /* maximal number of returned classes */
+    float threshold;      /* minimal score of returned class */
+} output_reduction_t;
+
+/**
+ * Maximal number of classes returned in response to OUTPUT message with output_reduction_t payload
+ */
+#define OUTPUT_REDUCTION_MAX_CLASSES ((MAX_MESSAGE_SIZE_BYTES - sizeof(message_t)) / sizeof(model_class_score_t))
+
+/**
+ * Number of the latest inference results kept on the device
+ */
+#define RESULT_RING_LEN 16
+
+/**
+ * Top class value meaning that there is no class
+ */
+#define RESULT_NO_CLASS (0xFFFFFFFFu)
+
+/**
+ * Modes of pushing results of the inferences run on the input reader data to the client
+ */
+typedef enum
+{
+    RESULT_MODE_OFF = 0,       /* results are only kept in the result ring */
+    RESULT_MODE_ALL = 1,       /* result of each inference is pushed */
+    RESULT_MODE_ON_CHANGE = 2, /* result is pushed only when the top class changes */
+    NUM_RESULT_MODES
+} RESULT_MODE;
+
+/**
+ * Result of the inference run on the input reader data. It is the payload of RESULT message
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp;        /* time of the inference end in timer ticks */
+    uint32_t inference_cycles; /* number of cycles spent in the inference */
+    uint32_t top_class;        /* index of the model output element with the highest score */
+    float top_score;           /* score of that element */
+} inference_result_t;
+
 /**
  * Initializes UART
  *
@@ -79,6 +146,23 @@ status_t __attribute__((weak)) i2c_init(void *config);
  */
 status_t __attribute__((weak)) sensor_init(void);
 
+/**
+ * Starts sampling sensor periodically, paced by the timer interrupt
+ *
+ * @returns status of the sensor
+ */
+status_t __attribute__((weak)) sensor_start_sampling(void);
+
+/**
+ * Sets output data rate and measurement range of the sensor
+ *
+ * @param data_rate output data rate in Hz
+ * @param range measurement range
+ *
+ * @returns status of the sensor
+ */
+status_t __attribute__((weak)) sensor_configure(const float data_rate, const uint32_t range);
+
 /**
  * Type of callback function
  */
@@ -87,16 +171,27 @@ typedef status_t (*callback_ptr)(message_t **);
 /**
  * List of callbacks for each message type
  */
-#define CALLBACKS(ENTRY)                             \
-    /*    MessageType           Callback_function */ \
-    ENTRY(MESSAGE_TYPE_OK, ok_callback)              \
-    ENTRY(MESSAGE_TYPE_ERROR, error_callback)        \
-    ENTRY(MESSAGE_TYPE_DATA, data_callback)          \
-    ENTRY(MESSAGE_TYPE_MODEL, model_callback)        \
-    ENTRY(MESSAGE_TYPE_PROCESS, process_callback)    \
-    ENTRY(MESSAGE_TYPE_OUTPUT, output_callback)      \
-    ENTRY(MESSAGE_TYPE_STATS, stats_callback)        \
-    ENTRY(MESSAGE_TYPE_IOSPEC, iospec_callback)
+#define CALLBACKS(ENTRY)                                                \
+    /*    MessageType           Callback_function */                    \
+    ENTRY(MESSAGE_TYPE_OK, ok_callback)                                 \
+    ENTRY(MESSAGE_TYPE_ERROR, error_callback)                           \
+    ENTRY(MESSAGE_TYPE_DATA, data_callback)                             \
+    ENTRY(MESSAGE_TYPE_MODEL, model_callback)                           \
+    ENTRY(MESSAGE_TYPE_PROCESS, process_callback)                       \
+    ENTRY(MESSAGE_TYPE_OUTPUT, output_callback)                         \
+    ENTRY(MESSAGE_TYPE_STATS, stats_callback)                           \
+    ENTRY(MESSAGE_TYPE_IOSPEC, iospec_callback)                         \
+    ENTRY(MESSAGE_TYPE_MODEL_BEGIN, model_begin_callback)               \
+    ENTRY(MESSAGE_TYPE_MODEL_CHUNK, model_chunk_callback)               \
+    ENTRY(MESSAGE_TYPE_MODEL_COMMIT, model_commit_callback)             \
+    ENTRY(MESSAGE_TYPE_INFER, infer_callback)                           \
+    ENTRY(MESSAGE_TYPE_BAUDRATE, baudrate_callback)                     \
+    ENTRY(MESSAGE_TYPE_SENSOR_CONFIG, sensor_config_callback)           \
+    ENTRY(MESSAGE_TYPE_INPUT_STRIDE, input_stride_callback)             \
+    ENTRY(MESSAGE_TYPE_ACTIVITY_THRESHOLD, activity_threshold_callback) \
+    ENTRY(MESSAGE_TYPE_RESULT, result_callback)                         \
+    ENTRY(MESSAGE_TYPE_RESULT_MODE, result_mode_callback)               \
+    ENTRY(MESSAGE_TYPE_PREPROCESSING, preprocessing_callback)
 
 #define ENTRY(msg_type, callback_func) status_t callback_func(message_t **);
 CALLBACKS(ENTRY)
@@ -5,28 +5,250 @@
  */
 
 #include "adxl345.h"
+#include <math.h>
 
 GENERATE_MODULE_STATUSES_STR(ADXL345);
 
+/**
+ * Acceleration in mg per LSB for the current measurement range
+ */
+ut_static float g_adxl345_scale = ADXL345_SCALE_2G;
+
+/**
+ * Retrieves number of samples stored in the ADXL345 FIFO and checks if any samples were overwritten
+ *
+ * @param max_count maximal number of samples to be read
+ * @param entries number of samples to be read, up to max_count
+ * @param overrun set if the FIFO was full and older samples were overwritten
+ *
+ * @returns status of the sensor
+ */
+static status_t get_fifo_entries(const size_t max_count, size_t *entries, bool *overrun)
+{
+    status_t status = STATUS_OK;
+    uint8_t int_source = 0;
+    uint8_t fifo_status = 0;
+
+    // overrun bit is cleared when the data registers are read, so it is checked before the samples are popped
+    status = i2c_read_target_register(ADXL345_I2C_ADDRESS, ADXL345_INT_SOURCE, &int_source);
+    RETURN_ON_ERROR(status, status);
+
+    *overrun = 0 != GET_REG_FIELD(int_source, ADXL345_INT_SOURCE_OVERRUN_BITS);
+
+    status = i2c_read_target_register(ADXL345_I2C_ADDRESS, ADXL345_FIFO_STATUS, &fifo_status);
+    RETURN_ON_ERROR(status, status);
+
+    *entries = GET_REG_FIELD(fifo_status, ADXL345_FIFO_STATUS_ENTRIES_BITS);
+    if (*entries > max_count)
+    {
+        *entries = max_count;
+    }
+
+    return STATUS_OK;
+}
+
+/**
+ * Returns output data rate of the given BW_RATE rate code
+ *
+ * @param rate_code rate code
+ *
+ * @returns output data rate in Hz
+ */
+static float get_rate(const uint8_t rate_code)
+{
+    return ADXL345_MAX_DATA_RATE / (float)(1 << (ADXL345_MAX_DATA_RATE_CODE - rate_code));
+}
+
+status_t adxl345_read_raw_data(adxl345_raw_data_t *data)
+{
+    VALIDATE_POINTER(data, ADXL345_STATUS_INV_PTR);
+
+    // data registers hold little-endian 16-bit values, matching the layout of the struct
+    return i2c_read_target_registers(ADXL345_I2C_ADDRESS, ADXL345_DATA_X0, sizeof(*data), (uint8_t *)data);
+}
+
 status_t adxl345_read_data(adxl345_data_t *data)
 {
     status_t status = STATUS_OK;
+    adxl345_raw_data_t raw_data = {0};
 
     VALIDATE_POINTER(data, ADXL345_STATUS_INV_PTR);
 
-    struct
+    status = adxl345_read_raw_data(&raw_data);
+    RETURN_ON_ERROR(status, status);
+
+    data->x = g_adxl345_scale * (float)raw_data.x;
+    data->y = g_adxl345_scale * (float)raw_data.y;
+    data->z = g_adxl345_scale * (float)raw_data.z;
+
+    return STATUS_OK;
+}
+
+/**
+ * Finds BW_RATE rate code of the given output data rate
+ *
+ * @param data_rate output data rate in Hz
+ * @param rate_code found rate code
+ *
+ * @returns status of the sensor
+ */
+static status_t get_rate_code(const float data_rate, uint8_t *rate_code)
+{
+    // each lower rate code halves the output data rate, the rate is matched with tolerance as it may be computed by the
+    // client, NaN does not match any rate
+    for (*rate_code = ADXL345_MAX_RATE_CODE; *rate_code >= ADXL345_MIN_RATE_CODE; --(*rate_code))
+    {
+        if (fabsf(data_rate - get_rate(*rate_code)) <= ADXL345_DATA_RATE_TOLERANCE * get_rate(*rate_code))
+        {
+            return STATUS_OK;
+        }
+    }
+
+    return ADXL345_STATUS_INV_ARG;
+}
+
+/**
+ * Finds DATA_FORMAT range code of the given measurement range
+ *
+ * @param range measurement range in g
+ * @param range_code found range code
+ *
+ * @returns status of the sensor
+ */
+static status_t get_range_code(const uint32_t range, uint8_t *range_code)
+{
+    // range codes map to 2, 4, 8 and 16 g
+    for (*range_code = 0; *range_code <= GET_REG_FIELD(0xFF, ADXL345_DATA_FORMAT_RANGE_BITS); ++(*range_code))
     {
-        int16_t x;
-        int16_t y;
-        int16_t z;
-    } raw_data;
+        if ((2u << *range_code) == range)
+        {
+            return STATUS_OK;
+        }
+    }
+
+    return ADXL345_STATUS_INV_ARG;
+}
 
-    status = i2c_read_target_registers(ADXL345_I2C_ADDRESS, ADXL345_DATA_X0, sizeof(raw_data), (uint8_t *)&raw_data);
+status_t adxl345_validate_config(const float data_rate, const uint32_t range)
+{
+    status_t status = STATUS_OK;
+    uint8_t code = 0;
+
+    status = get_rate_code(data_rate, &code);
     RETURN_ON_ERROR(status, status);
 
-    data->x = 4 * (float)raw_data.x;
-    data->y = 4 * (float)raw_data.y;
-    data->z = 4 * (float)raw_data.z;
+    return get_range_code(range, &code);
+}
+
+status_t adxl345_set_data_rate(const float data_rate, float *applied_rate)
+{
+    status_t status = STATUS_OK;
+    uint8_t bw_rate = 0;
+    uint8_t rate_code = 0;
+
+    VALIDATE_POINTER(applied_rate, ADXL345_STATUS_INV_PTR);
+
+    status = get_rate_code(data_rate, &rate_code);
+    RETURN_ON_ERROR(status, status);
+
+    status = i2c_read_target_register(ADXL345_I2C_ADDRESS, ADXL345_BW_RATE, &bw_rate);
+    RETURN_ON_ERROR(status, status);
+
+    bw_rate = SET_REG_FIELD(bw_rate, ADXL345_BW_RATE_RATE_BITS, rate_code);
+
+    status = i2c_write_target_register(ADXL345_I2C_ADDRESS, ADXL345_BW_RATE, bw_rate);
+    RETURN_ON_ERROR(status, status);
+
+    *applied_rate = get_rate(rate_code);
+
+    return STATUS_OK;
+}
+
+status_t adxl345_set_range(const uint32_t range)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_format = 0;
+    uint8_t range_code = 0;
+
+    status = get_range_code(range, &range_code);
+    RETURN_ON_ERROR(status, status);
+
+    status = i2c_read_target_register(ADXL345_I2C_ADDRESS, ADXL345_DATA_FORMAT, &data_format);
+    RETURN_ON_ERROR(status, status);
+
+    data_format = SET_REG_FIELD(data_format, ADXL345_DATA_FORMAT_RANGE_BITS, range_code);
+
+    status = i2c_write_target_register(ADXL345_I2C_ADDRESS, ADXL345_DATA_FORMAT, data_format);
+    RETURN_ON_ERROR(status, status);
+
+    // data is 10-bit regardless of the range, so the resolution drops with the range
+    g_adxl345_scale = ADXL345_SCALE_2G * (float)(1 << range_code);
 
     return STATUS_OK;
 }
+
+status_t adxl345_set_fifo_mode(const ADXL345_FIFO_MODE mode, const uint8_t samples)
+{
+    uint8_t fifo_ctl = 0;
+
+    if (mode > ADXL345_FIFO_MODE_TRIGGER || samples > GET_REG_FIELD(0xFF, ADXL345_FIFO_CTL_SAMPLES_BITS))
+    {
+        return ADXL345_STATUS_INV_ARG;
+    }
+
+    fifo_ctl = SET_REG_FIELD(fifo_ctl, ADXL345_FIFO_CTL_MODE_BITS, mode);
+    fifo_ctl = SET_REG_FIELD(fifo_ctl, ADXL345_FIFO_CTL_SAMPLES_BITS, samples);
+
+    return i2c_write_target_register(ADXL345_I2C_ADDRESS, ADXL345_FIFO_CTL, fifo_ctl);
+}
+
+status_t adxl345_enable_fifo() { return adxl345_set_fifo_mode(ADXL345_FIFO_MODE_STREAM, ADXL345_FIFO_BURST_LEN); }
+
+status_t adxl345_read_fifo(adxl345_data_t *data, const size_t max_count, size_t *count)
+{
+    status_t status = STATUS_OK;
+    size_t entries = 0;
+    bool overrun = false;
+
+    VALIDATE_POINTER(data, ADXL345_STATUS_INV_PTR);
+    VALIDATE_POINTER(count, ADXL345_STATUS_INV_PTR);
+
+    *count = 0;
+
+    status = get_fifo_entries(max_count, &entries, &overrun);
+    RETURN_ON_ERROR(status, status);
+
+    // register address does not wrap around after the last data register, so every entry is read separately
+    for (size_t i = 0; i < entries; ++i)
+    {
+        status = adxl345_read_data(&data[i]);
+        RETURN_ON_ERROR(status, status);
+        ++(*count);
+    }
+
+    return overrun ? ADXL345_STATUS_FIFO_OVERRUN : STATUS_OK;
+}
+
+status_t adxl345_read_raw_fifo(adxl345_raw_data_t *data, const size_t max_count, size_t *count)
+{
+    status_t status = STATUS_OK;
+    size_t entries = 0;
+    bool overrun = false;
+
+    VALIDATE_POINTER(data, ADXL345_STATUS_INV_PTR);
+    VALIDATE_POINTER(count, ADXL345_STATUS_INV_PTR);
+
+    *count = 0;
+
+    status = get_fifo_entries(max_count, &entries, &overrun);
+    RETURN_ON_ERROR(status, status);
+
+    for (size_t i = 0; i < entries; ++i)
+    {
+        status = adxl345_read_raw_data(&data[i]);
+        RETURN_ON_ERROR(status, status);
+        ++(*count);
+    }
+
+    return overrun ? ADXL345_STATUS_FIFO_OVERRUN : STATUS_OK;
+}
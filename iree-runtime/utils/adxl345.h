@@ -13,7 +13,7 @@
 /**
  * ADXL345 custom error codes
  */
-#define ADXL345_STATUSES(STATUS)
+#define ADXL345_STATUSES(STATUS) STATUS(ADXL345_STATUS_FIFO_OVERRUN)
 
 GENERATE_MODULE_STATUSES(ADXL345);
 
@@ -22,12 +22,48 @@ GENERATE_MODULE_STATUSES(ADXL345);
 #define ADXL345_DEVICE_ID (0xE5)
 #define ADXL345_DATA_X0 (0x32)
 
+#define ADXL345_BW_RATE (0x2C)
+#define ADXL345_BW_RATE_RATE_BITS (0xF << 0)
+
+#define ADXL345_INT_SOURCE (0x30)
+#define ADXL345_INT_SOURCE_OVERRUN_BITS (0x1 << 0)
+
 #define ADXL345_DATA_FORMAT (0x31)
 #define ADXL345_DATA_FORMAT_RANGE_BITS (0x3 << 0)
 
+#define ADXL345_FIFO_CTL (0x38)
+#define ADXL345_FIFO_CTL_MODE_BITS (0x3 << 6)
+#define ADXL345_FIFO_CTL_SAMPLES_BITS (0x1F << 0)
+#define ADXL345_FIFO_STATUS (0x39)
+#define ADXL345_FIFO_STATUS_ENTRIES_BITS (0x3F << 0)
+
+#define ADXL345_FIFO_LEN (32)       /* number of samples stored in the FIFO */
+#define ADXL345_FIFO_BURST_LEN (16) /* number of samples accumulated in the FIFO between reads */
+
 #define ADXL345_BUFFER_LEN (128)
 
-#define ADXL345_READ_INTERVAL (0.01F) // 10 ms (100 Hz)
+#define ADXL345_READ_INTERVAL (0.01F) // 10 ms (100 Hz), default output data rate
+
+#define ADXL345_MAX_DATA_RATE (3200.0F)     /* output data rate for the highest BW_RATE rate code (0xF) */
+#define ADXL345_DATA_RATE_TOLERANCE (0.01F) /* relative tolerance of the requested output data rate */
+#define ADXL345_MAX_DATA_RATE_CODE (0xF)
+/* highest supported rate code (400 Hz), so that the FIFO drain keeps up with the sensor, see adxl345_read_fifo */
+#define ADXL345_MAX_RATE_CODE (0xC)
+/* lowest supported rate code (6.25 Hz), so that the FIFO burst period fits the timer alarm range */
+#define ADXL345_MIN_RATE_CODE (0x6)
+
+#define ADXL345_SCALE_2G (4.0F) /* acceleration in mg per LSB for +-2 g range, doubles with each range step */
+
+/**
+ * An enum with ADXL345 FIFO modes
+ */
+typedef enum
+{
+    ADXL345_FIFO_MODE_BYPASS,
+    ADXL345_FIFO_MODE_FIFO,
+    ADXL345_FIFO_MODE_STREAM,
+    ADXL345_FIFO_MODE_TRIGGER
+} ADXL345_FIFO_MODE;
 
 /**
  * A struct that contains acceleration data read from ADXL345
@@ -39,6 +75,16 @@ typedef struct __attribute__((packed))
     float z;
 } adxl345_data_t;
 
+/**
+ * A struct that contains raw acceleration data read from ADXL345, in LSB of the current measurement range
+ */
+typedef struct __attribute__((packed))
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+} adxl345_raw_data_t;
+
 /**
  * Reads data from ADXL345 sensor at given address
  *
@@ -49,4 +95,91 @@ typedef struct __attribute__((packed))
  */
 status_t adxl345_read_data(adxl345_data_t *data);
 
+/**
+ * Reads raw data from ADXL345 sensor, without scaling it to acceleration
+ *
+ * @param data output data buffer
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_read_raw_data(adxl345_raw_data_t *data);
+
+/**
+ * Checks if ADXL345 sensor supports both output data rate and measurement range, without writing them to the sensor
+ *
+ * @param data_rate output data rate in Hz
+ * @param range measurement range in g
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_validate_config(const float data_rate, const uint32_t range);
+
+/**
+ * Sets output data rate of ADXL345 sensor. The rate has to be one of the rates supported by the sensor, i.e. 3200 Hz
+ * divided by a power of two, within ADXL345_DATA_RATE_TOLERANCE. Only rates from 6.25 Hz up to 400 Hz are accepted, as
+ * the FIFO is not drained fast enough at higher rates (see adxl345_read_fifo)
+ *
+ * @param data_rate output data rate in Hz
+ * @param applied_rate output data rate set in the sensor, it may differ from data_rate within the tolerance
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_set_data_rate(const float data_rate, float *applied_rate);
+
+/**
+ * Sets measurement range of ADXL345 sensor and updates scaling of the read data accordingly
+ *
+ * @param range measurement range in g (2, 4, 8 or 16)
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_set_range(const uint32_t range);
+
+/**
+ * Sets FIFO mode of ADXL345 sensor
+ *
+ * @param mode FIFO mode
+ * @param samples number of samples that triggers watermark interrupt
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_set_fifo_mode(const ADXL345_FIFO_MODE mode, const uint8_t samples);
+
+/**
+ * Switches ADXL345 FIFO to stream mode, so that the samples accumulate in the FIFO and the oldest ones are overwritten
+ * when it is full
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_enable_fifo();
+
+/**
+ * Reads all samples stored in the ADXL345 FIFO, up to the size of the output buffer. The overrun flag and the number of
+ * stored samples are read once and then each sample is popped with a single multi-byte read of data registers. The
+ * sensor pops one FIFO entry per read of the data registers and its register address does not wrap around, so every
+ * sample costs a separate 6-byte I2C transaction, about 0.8 ms at the standard 100 kHz I2C speed. At 400 Hz the drain
+ * takes about a third of the bus time and the 32-entry FIFO holds 80 ms of samples, which bounds how long the FIFO can
+ * stay undrained. If older samples were overwritten in the meantime, the stored ones are still read, but
+ * ADXL345_STATUS_FIFO_OVERRUN is returned, as there is a gap before them
+ *
+ * @param data output data buffer
+ * @param max_count size of the output buffer in samples
+ * @param count number of read samples
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_read_fifo(adxl345_data_t *data, const size_t max_count, size_t *count);
+
+/**
+ * Reads all raw samples stored in the ADXL345 FIFO, up to the size of the output buffer, without scaling them to
+ * acceleration. Transfers and FIFO overrun reporting are the same as in adxl345_read_fifo
+ *
+ * @param data output data buffer
+ * @param max_count size of the output buffer in samples
+ * @param count number of read samples
+ *
+ * @returns status of the sensor
+ */
+status_t adxl345_read_raw_fifo(adxl345_raw_data_t *data, const size_t max_count, size_t *count);
+
 #endif // IREE_RUNTIME_UTILS_ADXL345_H_
@@ -9,3 +9,9 @@
 GENERATE_MODULE_STATUSES_STR(INPUT_READER);
 
 status_t read_input() { return INPUT_READER_NO_READ; }
+
+status_t get_next_input_time(uint32_t *time) { return INPUT_READER_NO_READ; }
+
+status_t set_input_stride(const uint32_t stride) { return INPUT_READER_STATUS_NOT_SUPPORTED; }
+
+status_t set_input_activity_threshold(const float threshold) { return INPUT_READER_STATUS_NOT_SUPPORTED; }
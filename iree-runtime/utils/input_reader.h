@@ -12,7 +12,9 @@
 /**
  * Input reader custom error codes
  */
-#define INPUT_READER_STATUSES(STATUS) STATUS(INPUT_READER_NO_READ)
+#define INPUT_READER_STATUSES(STATUS) \
+    STATUS(INPUT_READER_NO_READ)      \
+    STATUS(INPUT_READER_STATUS_NOT_SUPPORTED)
 
 GENERATE_MODULE_STATUSES(INPUT_READER);
 
@@ -23,4 +25,33 @@ GENERATE_MODULE_STATUSES(INPUT_READER);
  */
 status_t read_input();
 
+/**
+ * Retrieves time at which the next input should be read, so that the runtime can sleep until then
+ *
+ * @param time time of the next read in timer ticks
+ *
+ * @returns INPUT_READER_NO_READ if no input is expected, error status otherwise
+ */
+status_t get_next_input_time(uint32_t *time);
+
+/**
+ * Sets number of new input samples after which the input is loaded into model, so that the inference runs on the
+ * sliding window every stride samples instead of every sample
+ *
+ * @param stride number of new samples
+ *
+ * @returns error status
+ */
+status_t set_input_stride(const uint32_t stride);
+
+/**
+ * Sets activity threshold of the input. The model is not run on the inputs in which variance of every channel is not
+ * above the threshold, e.g. while the device with accelerometer is stationary
+ *
+ * @param threshold variance threshold in squared units of the input (LSB for raw sensor samples), 0 disables the check
+ *
+ * @returns error status
+ */
+status_t set_input_activity_threshold(const float threshold);
+
 #endif // IREE_RUNTIME_UTIL_INPUT_READER_H_
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "interrupts.h"
+
+#ifndef __UNIT_TEST__
+#include "springbok.h"
+#define TRAP_HANDLER_ATTRIBUTES __attribute__((interrupt("machine"), aligned(4)))
+#else // __UNIT_TEST__
+#include "mocks/springbok.h"
+#define TRAP_HANDLER_ATTRIBUTES
+#endif // __UNIT_TEST__
+
+GENERATE_MODULE_STATUSES_STR(INTERRUPTS);
+
+ut_static interrupt_handler_t g_interrupt_handlers[NUM_INTERRUPT_SOURCES] = {NULL};
+
+/**
+ * Handles all machine mode traps. Interrupts are dispatched to the registered handlers, exceptions are fatal
+ */
+ut_static void TRAP_HANDLER_ATTRIBUTES trap_handler()
+{
+    uint32_t mcause = 0;
+    CSR_READ(mcause, CSR_MCAUSE);
+
+    uint32_t code = mcause & MCAUSE_CODE_MASK;
+
+    if (mcause & MCAUSE_INTERRUPT)
+    {
+        if (code < NUM_INTERRUPT_SOURCES && IS_VALID_POINTER(g_interrupt_handlers[code]))
+        {
+            g_interrupt_handlers[code]();
+        }
+        else if (code < NUM_INTERRUPT_SOURCES)
+        {
+            // no handler, disable the source so that it does not fire again
+            CSR_CLEAR(CSR_MIE, 1u << code);
+        }
+        return;
+    }
+
+    LOG_ERROR("Unhandled exception 0x%x", code);
+#ifndef __UNIT_TEST__
+    while (1)
+    {
+    }
+#endif // __UNIT_TEST__
+}
+
+status_t interrupts_init()
+{
+    CSR_WRITE(CSR_MTVEC, ((uint32_t)(uintptr_t)trap_handler) | MTVEC_MODE_DIRECT);
+    CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+
+    return STATUS_OK;
+}
+
+status_t interrupts_register_handler(const interrupt_source_t source, interrupt_handler_t handler)
+{
+    if (source >= NUM_INTERRUPT_SOURCES)
+    {
+        return INTERRUPTS_STATUS_INV_SOURCE;
+    }
+    g_interrupt_handlers[source] = handler;
+
+    return STATUS_OK;
+}
+
+status_t interrupts_enable(const interrupt_source_t source)
+{
+    if (source >= NUM_INTERRUPT_SOURCES)
+    {
+        return INTERRUPTS_STATUS_INV_SOURCE;
+    }
+    if (!IS_VALID_POINTER(g_interrupt_handlers[source]))
+    {
+        return INTERRUPTS_STATUS_UNINIT;
+    }
+    CSR_SET(CSR_MIE, 1u << source);
+
+    return STATUS_OK;
+}
+
+status_t interrupts_disable(const interrupt_source_t source)
+{
+    if (source >= NUM_INTERRUPT_SOURCES)
+    {
+        return INTERRUPTS_STATUS_INV_SOURCE;
+    }
+    CSR_CLEAR(CSR_MIE, 1u << source);
+
+    return STATUS_OK;
+}
+
+uint32_t interrupts_lock()
+{
+    uint32_t mstatus = 0;
+    CSR_READ(mstatus, CSR_MSTATUS);
+    CSR_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+
+    return mstatus & MSTATUS_MIE;
+}
+
+void interrupts_unlock(const uint32_t state)
+{
+    if (state & MSTATUS_MIE)
+    {
+        CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+    }
+}
+
+void interrupts_wait()
+{
+#ifndef __UNIT_TEST__
+    __asm__ __volatile__("wfi" : /* outputs: none */ : /* inputs: none */ : "memory");
+#endif // __UNIT_TEST__
+}
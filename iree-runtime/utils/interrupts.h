@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IREE_RUNTIME_UTILS_INTERRUPTS_H_
+#define IREE_RUNTIME_UTILS_INTERRUPTS_H_
+
+#include "utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Interrupts custom error codes
+ */
+#define INTERRUPTS_STATUSES(STATUS) STATUS(INTERRUPTS_STATUS_INV_SOURCE)
+
+GENERATE_MODULE_STATUSES(INTERRUPTS);
+
+#define MSTATUS_MIE (1u << 3u)         /* machine interrupts global enable */
+#define MCAUSE_INTERRUPT (1u << 31u)   /* set if trap was caused by interrupt */
+#define MCAUSE_CODE_MASK (0x7FFFFFFFu) /* mask of the trap cause code */
+#define MTVEC_MODE_DIRECT (0u)         /* all traps set PC to mtvec base */
+#define NUM_INTERRUPT_SOURCES (32u)    /* number of interrupt sources that fit in mie register */
+
+/**
+ * Interrupt sources, values are equal to the mcause codes of these interrupts
+ */
+typedef enum
+{
+    INTERRUPT_SOURCE_MACHINE_SOFTWARE = 3,
+    INTERRUPT_SOURCE_MACHINE_TIMER = 7,
+    INTERRUPT_SOURCE_MACHINE_EXTERNAL = 11,
+} interrupt_source_t;
+
+/**
+ * Type of interrupt handler. It is called from the trap handler with interrupts disabled
+ */
+typedef void (*interrupt_handler_t)();
+
+/**
+ * Installs trap handler and enables machine interrupts globally. Particular interrupt sources have to be enabled with
+ * interrupts_enable
+ *
+ * @returns error status of interrupts initialization
+ */
+status_t interrupts_init();
+/**
+ * Registers handler of given interrupt source
+ *
+ * @param source interrupt source
+ * @param handler handler to be called when interrupt occurs or NULL to remove the handler
+ *
+ * @returns error status of handler registration
+ */
+status_t interrupts_register_handler(const interrupt_source_t source, interrupt_handler_t handler);
+/**
+ * Enables given interrupt source
+ *
+ * @param source interrupt source
+ *
+ * @returns error status of enabling interrupt
+ */
+status_t interrupts_enable(const interrupt_source_t source);
+/**
+ * Disables given interrupt source
+ *
+ * @param source interrupt source
+ *
+ * @returns error status of disabling interrupt
+ */
+status_t interrupts_disable(const interrupt_source_t source);
+/**
+ * Disables machine interrupts globally
+ *
+ * @returns previous state of the interrupts that should be passed to interrupts_unlock
+ */
+uint32_t interrupts_lock();
+/**
+ * Restores machine interrupts state saved by interrupts_lock
+ *
+ * @param state state returned by interrupts_lock
+ */
+void interrupts_unlock(const uint32_t state);
+/**
+ * Stalls the core until an enabled interrupt is pending. It returns also if the interrupts are disabled globally with
+ * interrupts_lock, so the wake-up condition can be checked with interrupts locked without missing the interrupt. The
+ * pending interrupt is then handled on interrupts_unlock
+ */
+void interrupts_wait();
+
+#endif // IREE_RUNTIME_UTILS_INTERRUPTS_H_
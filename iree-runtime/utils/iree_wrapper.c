@@ -20,6 +20,10 @@ static iree_hal_device_t *gp_device = NULL;
  * IREE execution context where modules are loaded
  */
 static iree_vm_context_t *gp_context = NULL;
+/**
+ * Model entry function resolved when the context is created
+ */
+static iree_vm_function_t g_main_function = {0};
 
 /**
  * Buffer for model inputs
@@ -30,11 +34,6 @@ static iree_vm_list_t *gp_model_inputs = NULL;
  */
 static iree_vm_list_t *gp_model_outputs = NULL;
 
-/**
- * Buffer for model weights
- */
-static uint8_t *gp_model_weights;
-
 /**
  * Struct describing model IO
  */
@@ -88,8 +87,11 @@ static iree_status_t create_device(iree_allocator_t host_allocator, iree_hal_dev
     return iree_status;
 }
 
-static void release_context()
+void release_context()
 {
+    // entry function is valid only as long as the context
+    memset(&g_main_function, 0, sizeof(g_main_function));
+
     // release resources if already allocated
     if (NULL != gp_context)
     {
@@ -101,11 +103,6 @@ static void release_context()
         iree_vm_instance_release(gp_instance);
         gp_instance = NULL;
     }
-    if (NULL != gp_model_weights)
-    {
-        free(gp_model_weights);
-        gp_model_weights = NULL;
-    }
 }
 
 status_t create_context(const uint8_t *model_data, const size_t model_data_size)
@@ -114,14 +111,18 @@ status_t create_context(const uint8_t *model_data, const size_t model_data_size)
     iree_vm_module_t *hal_module = NULL;
     iree_vm_module_t *module = NULL;
 
+    VALIDATE_POINTER(model_data, IREE_WRAPPER_STATUS_INV_PTR);
+
+    // module is created in place so model data has to be properly aligned
+    if (0 != ((uintptr_t)model_data % MODEL_WEIGHTS_ALIGNMENT))
+    {
+        return IREE_WRAPPER_STATUS_INV_ARG;
+    }
+
     release_context();
 
     do
     {
-        // prepare model weights
-        gp_model_weights = aligned_alloc(4, model_data_size);
-        memcpy(gp_model_weights, model_data, model_data_size);
-
         iree_allocator_t host_allocator = iree_allocator_system();
         iree_status = iree_vm_instance_create(host_allocator, &gp_instance);
         BREAK_ON_IREE_ERROR(iree_status);
@@ -138,7 +139,7 @@ status_t create_context(const uint8_t *model_data, const size_t model_data_size)
 
         // create bytecode module
         iree_status =
-            iree_vm_bytecode_module_create(gp_instance, iree_make_const_byte_span(gp_model_weights, model_data_size),
+            iree_vm_bytecode_module_create(gp_instance, iree_make_const_byte_span(model_data, model_data_size),
                                            iree_allocator_null(), host_allocator, &module);
         BREAK_ON_IREE_ERROR(iree_status);
 
@@ -152,6 +153,13 @@ status_t create_context(const uint8_t *model_data, const size_t model_data_size)
         // allocate context
         iree_status = iree_vm_context_create_with_modules(
             gp_instance, IREE_VM_CONTEXT_FLAG_NONE, IREE_ARRAYSIZE(modules), &modules[0], host_allocator, &gp_context);
+        BREAK_ON_IREE_ERROR(iree_status);
+
+        // resolve entry function once so that it is not looked up on each inference
+        const char *entry_func = (const char *)g_model_struct.entry_func;
+        iree_string_view_t entry_func_name =
+            iree_make_string_view(entry_func, strnlen(entry_func, MAX_LENGTH_ENTRY_FUNC_NAME));
+        iree_status = iree_vm_context_resolve_function(gp_context, entry_func_name, &g_main_function);
     } while (0);
 
     // cleanup
@@ -172,84 +180,155 @@ status_t create_context(const uint8_t *model_data, const size_t model_data_size)
     return STATUS_OK;
 }
 
-/**
- * Prepares model input HAL buffers
- *
- * @param model_input model input
- * @param arg_buffer_views output buffers views
- *
- * @returns error status
- */
-static iree_status_t prepare_input_hal_buffer_views(const uint8_t *model_input,
-                                                    iree_hal_buffer_view_t **arg_buffer_views)
+status_t allocate_input_buffer(const MlModel *model_struct)
 {
     iree_status_t iree_status = iree_ok_status();
 
-    iree_const_byte_span_t *byte_span[MAX_MODEL_INPUT_NUM] = {NULL};
-    size_t offset = 0;
+    VALIDATE_POINTER(model_struct, IREE_WRAPPER_STATUS_INV_PTR);
 
-    for (int i = 0; i < g_model_struct.num_input; ++i)
-    {
-        size_t size = g_model_struct.input_size_bytes[i] * g_model_struct.input_length[i];
-        byte_span[i] = malloc(sizeof(iree_const_byte_span_t));
-        *byte_span[i] = iree_make_const_byte_span(model_input + offset, size);
-        offset += size;
-    }
+    release_input_buffer();
 
+    iree_status = iree_vm_list_create(/*element_type=*/NULL, /*initial_capacity=*/model_struct->num_input,
+                                      iree_allocator_system(), &gp_model_inputs);
+    CHECK_IREE_STATUS(iree_status);
+
+    // buffers are written by the host before each inference, so they need to be mappable
     iree_hal_buffer_params_t buffer_params = {.type =
                                                   IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
-                                              .access = IREE_HAL_MEMORY_ACCESS_READ,
-                                              .usage = IREE_HAL_BUFFER_USAGE_DEFAULT};
-    for (int i = 0; i < g_model_struct.num_input; ++i)
+                                              .access = IREE_HAL_MEMORY_ACCESS_READ | IREE_HAL_MEMORY_ACCESS_WRITE,
+                                              .usage = IREE_HAL_BUFFER_USAGE_DEFAULT | IREE_HAL_BUFFER_USAGE_MAPPING};
+    for (int i = 0; i < model_struct->num_input; ++i)
     {
+        iree_hal_buffer_view_t *arg_buffer_view = NULL;
         iree_status = iree_hal_buffer_view_allocate_buffer(
-            iree_hal_device_allocator(gp_device), g_model_struct.num_input_dim[i], g_model_struct.input_shape[i],
-            g_model_struct.hal_element_type, IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, buffer_params, *byte_span[i],
-            &(arg_buffer_views[i]));
+            iree_hal_device_allocator(gp_device), model_struct->num_input_dim[i], model_struct->input_shape[i],
+            model_struct->hal_element_type, IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, buffer_params,
+            iree_const_byte_span_empty(), &arg_buffer_view);
         BREAK_ON_IREE_ERROR(iree_status);
-    }
 
-    for (int i = 0; i < g_model_struct.num_input; ++i)
+        iree_vm_ref_t arg_buffer_view_ref = iree_hal_buffer_view_move_ref(arg_buffer_view);
+        iree_status = iree_vm_list_push_ref_move(gp_model_inputs, &arg_buffer_view_ref);
+        BREAK_ON_IREE_ERROR(iree_status);
+    }
+    if (!iree_status_is_ok(iree_status))
     {
-        if (NULL != byte_span[i])
-        {
-            free(byte_span[i]);
-            byte_span[i] = NULL;
-        }
+        release_input_buffer();
     }
+    CHECK_IREE_STATUS(iree_status);
 
-    return iree_status;
+    return STATUS_OK;
 }
 
 status_t prepare_input_buffer(const MlModel *model_struct, const uint8_t *model_input)
 {
     iree_status_t iree_status = iree_ok_status();
 
-    iree_status = iree_vm_list_create(
-        /*element_type=*/NULL, /*initial_capacity=*/model_struct->num_input, iree_allocator_system(), &gp_model_inputs);
-    CHECK_IREE_STATUS(iree_status);
+    VALIDATE_POINTER(model_struct, IREE_WRAPPER_STATUS_INV_PTR);
+    VALIDATE_POINTER(model_input, IREE_WRAPPER_STATUS_INV_PTR);
+    VALIDATE_POINTER(gp_model_inputs, IREE_WRAPPER_STATUS_UNINIT);
 
-    iree_hal_buffer_view_t *arg_buffer_views[MAX_MODEL_INPUT_NUM] = {NULL};
-    iree_status = prepare_input_hal_buffer_views(model_input, arg_buffer_views);
-    CHECK_IREE_STATUS(iree_status);
+    size_t offset = 0;
+    for (int i = 0; i < model_struct->num_input; ++i)
+    {
+        size_t size = model_struct->input_size_bytes[i] * model_struct->input_length[i];
+        iree_hal_buffer_view_t *arg_buffer_view = (iree_hal_buffer_view_t *)iree_vm_list_get_ref_deref(
+            gp_model_inputs, i, iree_hal_buffer_view_get_descriptor());
+        VALIDATE_POINTER(arg_buffer_view, IREE_WRAPPER_STATUS_INV_PTR);
+
+        // write input in place into the preallocated buffer
+        iree_status = iree_hal_buffer_map_write(iree_hal_buffer_view_buffer(arg_buffer_view), 0, model_input + offset,
+                                                size);
+        CHECK_IREE_STATUS(iree_status);
+
+        offset += size;
+    }
+
+    return STATUS_OK;
+}
+
+status_t write_input_buffer(const MlModel *model_struct, model_input_writer_t writer)
+{
+    iree_status_t iree_status = iree_ok_status();
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(model_struct, IREE_WRAPPER_STATUS_INV_PTR);
+    VALIDATE_POINTER(writer, IREE_WRAPPER_STATUS_INV_PTR);
+    VALIDATE_POINTER(gp_model_inputs, IREE_WRAPPER_STATUS_UNINIT);
 
-    iree_vm_ref_t arg_buffer_view_ref;
     for (int i = 0; i < model_struct->num_input; ++i)
     {
-        arg_buffer_view_ref = iree_hal_buffer_view_move_ref(arg_buffer_views[i]);
-        iree_status = iree_vm_list_push_ref_move(gp_model_inputs, &arg_buffer_view_ref);
+        iree_hal_buffer_mapping_t mapped_memory = {0};
+        size_t size = model_struct->input_size_bytes[i] * model_struct->input_length[i];
+        iree_hal_buffer_view_t *arg_buffer_view = (iree_hal_buffer_view_t *)iree_vm_list_get_ref_deref(
+            gp_model_inputs, i, iree_hal_buffer_view_get_descriptor());
+        VALIDATE_POINTER(arg_buffer_view, IREE_WRAPPER_STATUS_INV_PTR);
+
+        // previous contents of the buffer are overwritten, so they are not read back
+        iree_status = iree_hal_buffer_map_range(iree_hal_buffer_view_buffer(arg_buffer_view),
+                                                IREE_HAL_MAPPING_MODE_SCOPED, IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, 0,
+                                                size, &mapped_memory);
         CHECK_IREE_STATUS(iree_status);
+
+        status = writer(mapped_memory.contents.data, size);
+
+        iree_hal_buffer_unmap_range(&mapped_memory);
+        RETURN_ON_ERROR(status, status);
     }
 
     return STATUS_OK;
 }
 
-status_t prepare_output_buffer()
+status_t allocate_output_buffer(const MlModel *model_struct)
 {
     iree_status_t iree_status = iree_ok_status();
+    iree_string_view_t arguments = iree_string_view_empty();
+    iree_string_view_t results = iree_string_view_empty();
+
+    VALIDATE_POINTER(model_struct, IREE_WRAPPER_STATUS_INV_PTR);
+    VALIDATE_POINTER(gp_model_inputs, IREE_WRAPPER_STATUS_UNINIT);
+    VALIDATE_POINTER(g_main_function.module, IREE_WRAPPER_STATUS_UNINIT);
+
+    release_output_buffer();
+
+    iree_status = iree_vm_list_create(/*element_type=*/NULL, /*initial_capacity=*/model_struct->num_output,
+                                      iree_allocator_system(), &gp_model_outputs);
+    CHECK_IREE_STATUS(iree_status);
+
+    // argument types of the entry function are read from its calling convention, e.g. "0rrr_r"
+    iree_vm_function_signature_t signature = iree_vm_function_signature(&g_main_function);
+    iree_status = iree_vm_function_call_get_cconv_fragments(&signature, &arguments, &results);
+    CHECK_IREE_STATUS(iree_status);
+
+    // entry function that takes a ref argument for each input and output writes results into caller-provided storage,
+    // otherwise results are allocated by the VM
+    if (arguments.size != (iree_host_size_t)(model_struct->num_input + model_struct->num_output) ||
+        IREE_STRING_VIEW_NPOS != iree_string_view_find_first_not_of(arguments, iree_make_cstring_view("r"), 0))
+    {
+        return STATUS_OK;
+    }
 
-    iree_status = iree_vm_list_create(
-        /*element_type=*/NULL, /*initial_capacity=*/1, iree_allocator_system(), &gp_model_outputs);
+    iree_hal_buffer_params_t buffer_params = {.type =
+                                                  IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+                                              .access = IREE_HAL_MEMORY_ACCESS_ALL,
+                                              .usage = IREE_HAL_BUFFER_USAGE_DEFAULT | IREE_HAL_BUFFER_USAGE_MAPPING};
+    for (int i = 0; i < model_struct->num_output; ++i)
+    {
+        iree_hal_buffer_t *output_storage = NULL;
+        iree_status = iree_hal_allocator_allocate_buffer(
+            iree_hal_device_allocator(gp_device), buffer_params,
+            model_struct->output_length[i] * model_struct->output_size_bytes, iree_const_byte_span_empty(),
+            &output_storage);
+        BREAK_ON_IREE_ERROR(iree_status);
+
+        // output storage is passed to the entry function right after the inputs
+        iree_vm_ref_t output_storage_ref = iree_hal_buffer_move_ref(output_storage);
+        iree_status = iree_vm_list_push_ref_move(gp_model_inputs, &output_storage_ref);
+        BREAK_ON_IREE_ERROR(iree_status);
+    }
+    if (!iree_status_is_ok(iree_status))
+    {
+        iree_status_ignore(iree_vm_list_resize(gp_model_inputs, model_struct->num_input));
+    }
     CHECK_IREE_STATUS(iree_status);
 
     return STATUS_OK;
@@ -258,14 +337,17 @@ status_t prepare_output_buffer()
 status_t run_inference()
 {
     iree_status_t iree_status = iree_ok_status();
-    iree_vm_function_t main_function;
 
-    iree_status =
-        iree_vm_context_resolve_function(gp_context, iree_make_cstring_view(g_model_struct.entry_func), &main_function);
+    VALIDATE_POINTER(g_main_function.module, IREE_WRAPPER_STATUS_UNINIT);
+    VALIDATE_POINTER(gp_model_inputs, IREE_WRAPPER_STATUS_UNINIT);
+    VALIDATE_POINTER(gp_model_outputs, IREE_WRAPPER_STATUS_UNINIT);
+
+    // release results of the previous inference, the list itself is reused
+    iree_status = iree_vm_list_resize(gp_model_outputs, 0);
     CHECK_IREE_STATUS(iree_status);
 
     // invoke model
-    iree_status = iree_vm_invoke(gp_context, main_function,
+    iree_status = iree_vm_invoke(gp_context, g_main_function,
                                  IREE_VM_INVOCATION_FLAG_NONE /*IREE_VM_INVOCATION_FLAG_TRACE_EXECUTION*/,
                                  /*policy=*/NULL, gp_model_inputs, gp_model_outputs, iree_allocator_system());
     CHECK_IREE_STATUS(iree_status);
@@ -273,40 +355,36 @@ status_t run_inference()
     return STATUS_OK;
 }
 
-status_t get_output(uint8_t *model_output)
+status_t write_output(model_output_writer_t writer)
 {
     iree_status_t iree_status = iree_ok_status();
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(writer, IREE_WRAPPER_STATUS_INV_PTR);
 
-    size_t model_output_idx = 0;
     for (int output_idx = 0; output_idx < g_model_struct.num_output; ++output_idx)
     {
         iree_hal_buffer_mapping_t mapped_memory = {0};
-        iree_hal_buffer_view_t *ret_buffer_view = NULL;
-        // get the result buffers from the invocation.
-        ret_buffer_view = (iree_hal_buffer_view_t *)iree_vm_list_get_ref_deref(gp_model_outputs, output_idx,
-                                                                               iree_hal_buffer_view_get_descriptor());
-        if (NULL == ret_buffer_view)
-        {
-            return IREE_WRAPPER_STATUS_INV_PTR;
-        }
+        iree_hal_buffer_view_t *ret_buffer_view = (iree_hal_buffer_view_t *)iree_vm_list_get_ref_deref(
+            gp_model_outputs, output_idx, iree_hal_buffer_view_get_descriptor());
+        VALIDATE_POINTER(ret_buffer_view, IREE_WRAPPER_STATUS_INV_PTR);
+
+        size_t output_size = g_model_struct.output_size_bytes * g_model_struct.output_length[output_idx];
+
         iree_status =
             iree_hal_buffer_map_range(iree_hal_buffer_view_buffer(ret_buffer_view), IREE_HAL_MAPPING_MODE_SCOPED,
                                       IREE_HAL_MEMORY_ACCESS_READ, 0, IREE_WHOLE_BUFFER, &mapped_memory);
         CHECK_IREE_STATUS(iree_status);
 
-        if ((output_idx > g_model_struct.num_output ||
-             mapped_memory.contents.data_length / g_model_struct.output_size_bytes !=
-                 g_model_struct.output_length[output_idx]) &&
-            NULL == ret_buffer_view)
+        if (mapped_memory.contents.data_length < output_size)
         {
-            return IREE_WRAPPER_STATUS_INV_PTR;
+            iree_hal_buffer_unmap_range(&mapped_memory);
+            return IREE_WRAPPER_STATUS_INV_ARG;
         }
-        memcpy(&model_output[model_output_idx], mapped_memory.contents.data,
-               g_model_struct.output_size_bytes * g_model_struct.output_length[output_idx]);
-
-        model_output_idx += g_model_struct.output_size_bytes * g_model_struct.output_length[output_idx];
+        status = writer(mapped_memory.contents.data, output_size);
 
         iree_hal_buffer_unmap_range(&mapped_memory);
+        RETURN_ON_ERROR(status, status);
     }
 
     return STATUS_OK;
@@ -8,6 +8,7 @@
 #define IREE_RUNTIME_UTIL_IREE_WRAPPER_H_
 
 #include "utils.h"
+#include <string.h>
 
 #ifndef __UNIT_TEST__
 #include "iree/hal/drivers/local_sync/sync_device.h"
@@ -47,6 +48,11 @@ GENERATE_MODULE_STATUSES(IREE_WRAPPER);
 #define MAX_LENGTH_ENTRY_FUNC_NAME 20
 #define MAX_LENGTH_MODEL_NAME 20
 
+/**
+ * Required alignment of the model weights. The bytecode module is created in place over them
+ */
+#define MODEL_WEIGHTS_ALIGNMENT 64
+
 /**
  * A struct that contains model parameters
  */
@@ -65,6 +71,16 @@ typedef struct __attribute__((packed))
     uint8_t model_name[MAX_LENGTH_MODEL_NAME];
 } MlModel;
 
+/**
+ * Type of function that consumes consecutive parts of the model output
+ */
+typedef status_t (*model_output_writer_t)(const uint8_t *, const size_t);
+
+/**
+ * Type of function that writes model input straight into the mapped input buffer
+ */
+typedef status_t (*model_input_writer_t)(uint8_t *, const size_t);
+
 #define BREAK_ON_IREE_ERROR(status) \
     if (!iree_status_is_ok(status)) \
     {                               \
@@ -78,7 +94,9 @@ typedef struct __attribute__((packed))
     }
 
 /**
- * Creates context that hold modules' state
+ * Creates context that hold modules' state. The model data is not copied, the bytecode module is created in place over
+ * it, so it has to be aligned to MODEL_WEIGHTS_ALIGNMENT and stay unchanged until the context is released. The entry
+ * function from the model struct is resolved here, so model struct has to be loaded before
  *
  * @param model_data compiled model data
  * @param model_data_size size of compiled model data
@@ -88,7 +106,21 @@ typedef struct __attribute__((packed))
 status_t create_context(const uint8_t *model_data, const size_t model_data_size);
 
 /**
- * Prepares model input buffer
+ * Releases context and modules created from the model data
+ */
+void release_context();
+
+/**
+ * Allocates model input buffer. The buffer is allocated once per loaded model and reused by subsequent inferences
+ *
+ * @param model_struct struct that contains model params
+ *
+ * @returns error status
+ */
+status_t allocate_input_buffer(const MlModel *model_struct);
+
+/**
+ * Writes model input into the allocated model input buffer
  *
  * @param model_struct struct that contains model params
  * @param model_input model input
@@ -98,11 +130,25 @@ status_t create_context(const uint8_t *model_data, const size_t model_data_size)
 status_t prepare_input_buffer(const MlModel *model_struct, const uint8_t *model_input);
 
 /**
- * Prepares model output buffer
+ * Passes each model input buffer mapped for writing to the given writer, so that the input can be written straight
+ * into it
+ *
+ * @param model_struct struct that contains model params
+ * @param writer function that writes the input
+ *
+ * @returns error status
+ */
+status_t write_input_buffer(const MlModel *model_struct, model_input_writer_t writer);
+
+/**
+ * Allocates model output buffer. The buffer is allocated once per loaded model and reused by subsequent inferences. If
+ * the entry function accepts storage for the outputs, the storage is allocated too and passed along with the inputs
+ *
+ * @param model_struct struct that contains model params
  *
  * @returns error status
  */
-status_t prepare_output_buffer();
+status_t allocate_output_buffer(const MlModel *model_struct);
 
 /**
  * Runs model inference
@@ -112,13 +158,13 @@ status_t prepare_output_buffer();
 status_t run_inference();
 
 /**
- * Returns model output
+ * Passes each model output to the given writer straight from the mapped result buffer, without copying it
  *
- * @param model_output buffer to save model output into
+ * @param writer function that consumes the output
  *
  * @returns error status
  */
-status_t get_output(uint8_t *model_output);
+status_t write_output(model_output_writer_t writer);
 
 /**
  * Returns model stats
@@ -132,12 +178,12 @@ status_t get_output(uint8_t *model_output);
 status_t get_model_stats(const size_t statistics_buffer_size, uint8_t *statistics_buffer, size_t *statistics_size);
 
 /**
- * Clears model input buffer
+ * Releases model input buffer
  */
 void release_input_buffer();
 
 /**
- * Clears model output buffer
+ * Releases model output buffer
  */
 void release_output_buffer();
 
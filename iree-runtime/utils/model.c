@@ -12,6 +12,54 @@ MlModel g_model_struct;
 
 ut_static MODEL_STATE g_model_state = MODEL_STATE_UNINITIALIZED;
 
+/**
+ * Buffer for model weights. The model is executed in place from it, the space in front of the weights is reserved for
+ * the caller, so that the weights can be received straight into this buffer
+ */
+ut_static uint8_t __attribute__((aligned(MODEL_WEIGHTS_ALIGNMENT)))
+g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM + MAX_MODEL_WEIGHTS_SIZE_BYTES];
+
+/**
+ * Total size of the model weights being uploaded in multi-part mode or 0 if there is no upload in progress
+ */
+ut_static size_t g_model_weights_upload_size = 0;
+
+/**
+ * Size of the model weights already written in multi-part mode
+ */
+ut_static size_t g_model_weights_upload_offset = 0;
+
+/**
+ * Input being preprocessed and index of its next element. Model inputs are preprocessed one by one
+ */
+ut_static const float *gp_preprocessing_input = NULL;
+ut_static size_t g_preprocessing_input_idx = 0;
+
+/**
+ * State of the model output reduction. Outputs are passed to the reduction part by part, so the index of the next
+ * element is kept along with the classes selected so far, sorted by score in descending order
+ */
+ut_static uint32_t g_output_element_idx = 0;
+ut_static model_class_score_t *gp_output_classes = NULL;
+ut_static size_t g_output_max_classes = 0;
+ut_static size_t g_output_num_classes = 0;
+ut_static float g_output_threshold = 0.0F;
+
+/**
+ * Model output element types that can be converted to float and their C types
+ */
+#define OUTPUT_ELEMENT_TYPES(OUTPUT_ELEMENT_TYPE)               \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_INT_8, int8_t)     \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_UINT_8, uint8_t)   \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_INT_16, int16_t)   \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_UINT_16, uint16_t) \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_INT_32, int32_t)   \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_UINT_32, uint32_t) \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_INT_64, int64_t)   \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_UINT_64, uint64_t) \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_FLOAT_32, float)   \
+    OUTPUT_ELEMENT_TYPE(IREE_HAL_ELEMENT_TYPE_FLOAT_64, double)
+
 MODEL_STATE get_model_state() { return g_model_state; }
 
 void reset_model_state() { g_model_state = MODEL_STATE_UNINITIALIZED; }
@@ -70,9 +118,112 @@ status_t load_model_struct(const uint8_t *model_struct_data, const size_t data_s
     return status;
 }
 
+/**
+ * Frees resources of currently loaded model
+ */
+static void unload_model()
+{
+    release_output_buffer();
+    release_input_buffer();
+    release_context();
+
+    // any upload in progress is abandoned
+    g_model_weights_upload_size = 0;
+    g_model_weights_upload_offset = 0;
+
+    if (g_model_state > MODEL_STATE_STRUCT_LOADED)
+    {
+        g_model_state = MODEL_STATE_STRUCT_LOADED;
+    }
+}
+
+status_t get_model_weights_buffer(const size_t model_data_size, uint8_t **model_weights_buffer)
+{
+    VALIDATE_POINTER(model_weights_buffer, MODEL_STATUS_INV_PTR);
+
+    if (g_model_state < MODEL_STATE_STRUCT_LOADED)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+    if (model_data_size > MAX_MODEL_WEIGHTS_SIZE_BYTES)
+    {
+        LOG_ERROR("Model too big: %d. Max size: %d", model_data_size, MAX_MODEL_WEIGHTS_SIZE_BYTES);
+        return MODEL_STATUS_INV_ARG;
+    }
+
+    // weights of the loaded model are going to be overwritten
+    unload_model();
+
+    *model_weights_buffer = &g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM];
+
+    return STATUS_OK;
+}
+
+status_t begin_model_weights_upload(const size_t model_data_size)
+{
+    status_t status = STATUS_OK;
+    uint8_t *model_weights_buffer = NULL;
+
+    if (0 == model_data_size)
+    {
+        return MODEL_STATUS_INV_ARG;
+    }
+
+    status = get_model_weights_buffer(model_data_size, &model_weights_buffer);
+    RETURN_ON_ERROR(status, status);
+
+    g_model_weights_upload_size = model_data_size;
+    g_model_weights_upload_offset = 0;
+
+    LOG_DEBUG("Began model weights upload. Size: %d", model_data_size);
+
+    return STATUS_OK;
+}
+
+status_t load_model_weights_chunk(const uint8_t *chunk, const size_t chunk_size)
+{
+    VALIDATE_POINTER(chunk, MODEL_STATUS_INV_PTR);
+
+    if (g_model_state < MODEL_STATE_STRUCT_LOADED || 0 == g_model_weights_upload_size)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+    if (chunk_size > g_model_weights_upload_size - g_model_weights_upload_offset)
+    {
+        LOG_ERROR("Model weights chunk too big: %d. Remaining size: %d", chunk_size,
+                  g_model_weights_upload_size - g_model_weights_upload_offset);
+        return MODEL_STATUS_INV_ARG;
+    }
+
+    memcpy(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM + g_model_weights_upload_offset], chunk, chunk_size);
+    g_model_weights_upload_offset += chunk_size;
+
+    return STATUS_OK;
+}
+
+status_t commit_model_weights_upload()
+{
+    size_t model_data_size = g_model_weights_upload_size;
+
+    if (g_model_state < MODEL_STATE_STRUCT_LOADED || 0 == model_data_size)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+    if (g_model_weights_upload_offset != model_data_size)
+    {
+        LOG_ERROR("Model weights upload incomplete. Received: %d. Expected: %d", g_model_weights_upload_offset,
+                  model_data_size);
+        return MODEL_STATUS_INV_ARG;
+    }
+
+    // weights are already in place, so they are not copied
+    return load_model_weights(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], model_data_size);
+}
+
 status_t load_model_weights(const uint8_t *model_weights_data, const size_t data_size)
 {
     status_t status = STATUS_OK;
+    uint8_t *model_weights_buffer = &g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM];
 
     VALIDATE_POINTER(model_weights_data, MODEL_STATUS_INV_PTR);
 
@@ -80,12 +231,28 @@ status_t load_model_weights(const uint8_t *model_weights_data, const size_t data
     {
         return MODEL_STATUS_INV_STATE;
     }
+    if (data_size > MAX_MODEL_WEIGHTS_SIZE_BYTES)
+    {
+        LOG_ERROR("Model too big: %d. Max size: %d", data_size, MAX_MODEL_WEIGHTS_SIZE_BYTES);
+        return MODEL_STATUS_INV_ARG;
+    }
 
-    // free input/output resources
-    release_output_buffer();
-    release_input_buffer();
+    unload_model();
+
+    // weights received elsewhere need to be moved to the weights buffer
+    if (model_weights_data != model_weights_buffer)
+    {
+        memmove(model_weights_buffer, model_weights_data, data_size);
+    }
+
+    status = create_context(model_weights_buffer, data_size);
+    RETURN_ON_ERROR(status, status);
+
+    // IO buffers are allocated once and reused by each inference
+    status = allocate_input_buffer(&g_model_struct);
+    RETURN_ON_ERROR(status, status);
 
-    status = create_context(model_weights_data, data_size);
+    status = allocate_output_buffer(&g_model_struct);
     RETURN_ON_ERROR(status, status);
 
     LOG_DEBUG("Loaded model weights");
@@ -106,11 +273,13 @@ status_t get_model_input_size(size_t *model_input_size)
         return MODEL_STATUS_INV_STATE;
     }
 
-    // compute input size
+    // compute input size, preprocessed input consists of float elements
     size_t size = 0;
+    bool preprocessing_enabled = 0 != preprocessing_get_output_element_size();
     for (int i = 0; i < g_model_struct.num_input; ++i)
     {
-        size += g_model_struct.input_length[i] * g_model_struct.input_size_bytes[i];
+        size += g_model_struct.input_length[i] *
+                (preprocessing_enabled ? sizeof(float) : g_model_struct.input_size_bytes[i]);
     }
 
     *model_input_size = size;
@@ -118,9 +287,47 @@ status_t get_model_input_size(size_t *model_input_size)
     return status;
 }
 
+status_t get_model_input_element_type(iree_hal_element_type_t *element_type)
+{
+    VALIDATE_POINTER(element_type, MODEL_STATUS_INV_PTR);
+
+    if (g_model_state < MODEL_STATE_STRUCT_LOADED)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+
+    *element_type = 0 != preprocessing_get_output_element_size() ? IREE_HAL_ELEMENT_TYPE_FLOAT_32
+                                                                  : g_model_struct.hal_element_type;
+
+    return STATUS_OK;
+}
+
+/**
+ * Model input writer that preprocesses next part of the input straight into the model input buffer
+ *
+ * @param model_input_buffer mapped model input buffer
+ * @param buffer_size size of the buffer
+ *
+ * @returns status of the model
+ */
+static status_t preprocess_model_input(uint8_t *model_input_buffer, const size_t buffer_size)
+{
+    status_t status = STATUS_OK;
+
+    size_t num_elements = buffer_size / preprocessing_get_output_element_size();
+    status = preprocess(&gp_preprocessing_input[g_preprocessing_input_idx], num_elements, g_preprocessing_input_idx,
+                        model_input_buffer);
+    RETURN_ON_ERROR(status, status);
+
+    g_preprocessing_input_idx += num_elements;
+
+    return STATUS_OK;
+}
+
 status_t load_model_input(const uint8_t *model_input, const size_t model_input_size)
 {
     status_t status = STATUS_OK;
+    profiler_timestamp_t start = {0};
 
     VALIDATE_POINTER(model_input, MODEL_STATUS_INV_PTR);
 
@@ -140,12 +347,33 @@ status_t load_model_input(const uint8_t *model_input, const size_t model_input_s
         return MODEL_STATUS_INV_ARG;
     }
 
-    // free resources
-    release_input_buffer();
-
-    // setup buffers for inputs
-    status = prepare_input_buffer(&g_model_struct, model_input);
+    // write input into the allocated buffers
+    size_t preprocessing_element_size = preprocessing_get_output_element_size();
+    if (0 != preprocessing_element_size)
+    {
+        // preprocessing output has to match the model input element
+        for (int i = 0; i < g_model_struct.num_input; ++i)
+        {
+            if (g_model_struct.input_size_bytes[i] != preprocessing_element_size)
+            {
+                LOG_ERROR("Preprocessing output element size %d does not match model input element size %d",
+                          preprocessing_element_size, g_model_struct.input_size_bytes[i]);
+                return MODEL_STATUS_INV_ARG;
+            }
+        }
+        gp_preprocessing_input = (const float *)model_input;
+        g_preprocessing_input_idx = 0;
+        profiler_start(&start);
+        status = write_input_buffer(&g_model_struct, preprocess_model_input);
+        gp_preprocessing_input = NULL;
+    }
+    else
+    {
+        profiler_start(&start);
+        status = prepare_input_buffer(&g_model_struct, model_input);
+    }
     RETURN_ON_ERROR(status, status);
+    profiler_record(PROFILER_PHASE_LOAD_INPUT, &start);
 
     LOG_DEBUG("Loaded model input");
 
@@ -157,22 +385,18 @@ status_t load_model_input(const uint8_t *model_input, const size_t model_input_s
 status_t run_model()
 {
     status_t status = STATUS_OK;
+    profiler_timestamp_t start = {0};
 
     if (g_model_state < MODEL_STATE_INPUT_LOADED)
     {
         return MODEL_STATUS_INV_STATE;
     }
 
-    // free resources
-    release_output_buffer();
-
-    // setup buffers for outputs
-    status = prepare_output_buffer();
-    RETURN_ON_ERROR(status, status);
-
     // perform inference
+    profiler_start(&start);
     status = run_inference();
     RETURN_ON_ERROR(status, status);
+    profiler_record(PROFILER_PHASE_INFERENCE, &start);
 
     LOG_DEBUG("Model inference done");
 
@@ -181,36 +405,167 @@ status_t run_model()
     return status;
 }
 
-status_t get_model_output(const size_t buffer_size, uint8_t *model_output, size_t *model_output_size)
+status_t get_model_output_size(size_t *model_output_size)
+{
+    VALIDATE_POINTER(model_output_size, MODEL_STATUS_INV_PTR);
+
+    if (g_model_state < MODEL_STATE_STRUCT_LOADED)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+
+    size_t size = 0;
+    for (int i = 0; i < g_model_struct.num_output; ++i)
+    {
+        size += g_model_struct.output_length[i] * g_model_struct.output_size_bytes;
+    }
+
+    *model_output_size = size;
+
+    return STATUS_OK;
+}
+
+status_t write_model_output(model_output_writer_t writer)
 {
     status_t status = STATUS_OK;
 
-    VALIDATE_POINTER(model_output, MODEL_STATUS_INV_PTR);
-    VALIDATE_POINTER(model_output_size, MODEL_STATUS_INV_PTR);
+    VALIDATE_POINTER(writer, MODEL_STATUS_INV_PTR);
 
     if (g_model_state < MODEL_STATE_INFERENCE_DONE)
     {
         return MODEL_STATUS_INV_STATE;
     }
 
-    size_t output_size = 0;
-    for (int i = 0; i < g_model_struct.num_output; ++i)
+    status = write_output(writer);
+    RETURN_ON_ERROR(status, status);
+
+    LOG_DEBUG("Model output written");
+
+    return status;
+}
+
+/**
+ * Converts model output element to float
+ *
+ * @param element pointer to the element
+ * @param value returned value of the element
+ *
+ * @returns true if the element type of the model output is supported
+ */
+static bool output_element_to_float(const uint8_t *element, float *value)
+{
+    switch (g_model_struct.hal_element_type)
     {
-        output_size += g_model_struct.output_length[i] * g_model_struct.output_size_bytes;
+#define CONVERT_OUTPUT_ELEMENT(element_type, c_type)            \
+    case element_type:                                          \
+        if (sizeof(c_type) != g_model_struct.output_size_bytes) \
+        {                                                       \
+            return false;                                       \
+        }                                                       \
+        *value = (float)*((const c_type *)element);             \
+        return true;
+        OUTPUT_ELEMENT_TYPES(CONVERT_OUTPUT_ELEMENT)
+#undef CONVERT_OUTPUT_ELEMENT
+    default:
+        return false;
     }
-    if (buffer_size < output_size)
+}
+
+/**
+ * Model output writer that selects classes with the highest scores from the part of the model output
+ *
+ * @param output part of the model output
+ * @param output_size size of the part
+ *
+ * @returns status of the model
+ */
+static status_t reduce_output(const uint8_t *output, const size_t output_size)
+{
+    float score = 0.0F;
+
+    for (size_t offset = 0; offset < output_size; offset += g_model_struct.output_size_bytes, ++g_output_element_idx)
+    {
+        if (!output_element_to_float(&output[offset], &score))
+        {
+            return MODEL_STATUS_INV_ARG;
+        }
+        // NaN scores are never selected
+        if (!(score >= g_output_threshold))
+        {
+            continue;
+        }
+        if (g_output_num_classes < g_output_max_classes)
+        {
+            ++g_output_num_classes;
+        }
+        else if (score <= gp_output_classes[g_output_num_classes - 1].score)
+        {
+            continue;
+        }
+        // insert the class after the classes with not lower score, so that the earlier class wins a tie
+        size_t class_idx = g_output_num_classes - 1;
+        while (class_idx > 0 && gp_output_classes[class_idx - 1].score < score)
+        {
+            gp_output_classes[class_idx] = gp_output_classes[class_idx - 1];
+            --class_idx;
+        }
+        gp_output_classes[class_idx].class_idx = g_output_element_idx;
+        gp_output_classes[class_idx].score = score;
+    }
+
+    return STATUS_OK;
+}
+
+status_t reduce_model_output(const size_t max_classes, const float threshold, model_class_score_t *classes,
+                             size_t *num_classes)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(classes, MODEL_STATUS_INV_PTR);
+    VALIDATE_POINTER(num_classes, MODEL_STATUS_INV_PTR);
+
+    if (0 == max_classes)
     {
-        LOG_ERROR("Buffer is too small. Buffer size: %d. Model output size: %d", buffer_size, output_size);
         return MODEL_STATUS_INV_ARG;
     }
-    *model_output_size = output_size;
 
-    status = get_output(model_output);
+    g_output_element_idx = 0;
+    gp_output_classes = classes;
+    g_output_max_classes = max_classes;
+    g_output_num_classes = 0;
+    g_output_threshold = threshold;
+
+    // scores are read straight from the result buffers
+    status = write_model_output(reduce_output);
+    gp_output_classes = NULL;
     RETURN_ON_ERROR(status, status);
 
-    LOG_DEBUG("Model output retrieved");
+    *num_classes = g_output_num_classes;
 
-    return status;
+    return STATUS_OK;
+}
+
+status_t get_model_output_top_class(uint32_t *top_class, float *top_score)
+{
+    status_t status = STATUS_OK;
+    model_class_score_t top = {0};
+    size_t num_classes = 0;
+
+    VALIDATE_POINTER(top_class, MODEL_STATUS_INV_PTR);
+    VALIDATE_POINTER(top_score, MODEL_STATUS_INV_PTR);
+
+    status = reduce_model_output(1, -FLT_MAX, &top, &num_classes);
+    RETURN_ON_ERROR(status, status);
+
+    if (0 == num_classes)
+    {
+        return MODEL_STATUS_INV_ARG;
+    }
+
+    *top_class = top.class_idx;
+    *top_score = top.score;
+
+    return STATUS_OK;
 }
 
 status_t get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer, size_t *statistics_size)
@@ -8,10 +8,14 @@
 #define IREE_RUNTIME_UTIL_MODEL_H_
 
 #include "utils.h"
+#include <float.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "iree_wrapper.h"
+#include "preprocessing.h"
+#include "profiler.h"
 #if !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
 #include "springbok.h"
 #else // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
@@ -25,6 +29,12 @@
 
 GENERATE_MODULE_STATUSES(MODEL);
 
+/**
+ * Model weights buffer constraints
+ */
+#define MAX_MODEL_WEIGHTS_SIZE_BYTES (4 * 1024 * 1024) // 4 MB
+#define MODEL_WEIGHTS_HEADROOM MODEL_WEIGHTS_ALIGNMENT
+
 /**
  * An enum that describes model state
  */
@@ -37,6 +47,15 @@ typedef enum
     MODEL_STATE_INFERENCE_DONE = 4,
 } MODEL_STATE;
 
+/**
+ * Class selected from the model output along with its score
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t class_idx; /* index of the model output element */
+    float score;        /* value of that element */
+} model_class_score_t;
+
 /**
  * Returns current model state
  *
@@ -60,7 +79,47 @@ void reset_model_state();
 status_t load_model_struct(const uint8_t *model_struct_data, const size_t data_size);
 
 /**
- * Loads model weights from given buffer
+ * Returns buffer that model weights should be written into so that they can be loaded without copying. As the weights
+ * of currently loaded model are going to be overwritten, the model is unloaded
+ *
+ * @param model_data_size size of the model weights that are going to be written
+ * @param model_weights_buffer returned buffer. MODEL_WEIGHTS_HEADROOM bytes in front of it can be used by the caller
+ *                             (i.e. for message header)
+ *
+ * @returns status of the model
+ */
+status_t get_model_weights_buffer(const size_t model_data_size, uint8_t **model_weights_buffer);
+
+/**
+ * Begins multi-part upload of the model weights. The model is unloaded and the weights are written into the model
+ * weights buffer chunk by chunk
+ *
+ * @param model_data_size total size of the model weights
+ *
+ * @returns status of the model
+ */
+status_t begin_model_weights_upload(const size_t model_data_size);
+
+/**
+ * Writes next chunk of the model weights uploaded in multi-part mode
+ *
+ * @param chunk buffer that contains the chunk of model weights
+ * @param chunk_size size of the chunk
+ *
+ * @returns status of the model
+ */
+status_t load_model_weights_chunk(const uint8_t *chunk, const size_t chunk_size);
+
+/**
+ * Finishes multi-part upload of the model weights and loads the model from them
+ *
+ * @returns status of the model
+ */
+status_t commit_model_weights_upload();
+
+/**
+ * Loads model weights from given buffer. If the weights are not placed in the buffer returned by
+ * get_model_weights_buffer, they are copied there first
  *
  * @param model_weights_data buffer that contains model weights
  * @param model_data_size size of the buffer
@@ -70,7 +129,8 @@ status_t load_model_struct(const uint8_t *model_struct_data, const size_t data_s
 status_t load_model_weights(const uint8_t *model_weights_data, const size_t model_data_size);
 
 /**
- * Calculates model input size based on data from model struct
+ * Calculates model input size based on data from model struct. If input preprocessing is enabled, the input consists
+ * of float elements that are preprocessed into the model input
  *
  * @param model_input_size output value
  *
@@ -79,7 +139,17 @@ status_t load_model_weights(const uint8_t *model_weights_data, const size_t mode
 status_t get_model_input_size(size_t *model_input_size);
 
 /**
- * Loads model input from given buffer
+ * Retrieves type of the model input elements. If input preprocessing is enabled, the input consists of float elements
+ *
+ * @param element_type output value
+ *
+ * @returns status of the model
+ */
+status_t get_model_input_element_type(iree_hal_element_type_t *element_type);
+
+/**
+ * Loads model input from given buffer. If input preprocessing is enabled, the input is preprocessed straight into the
+ * model input buffer
  *
  * @param model_input buffer that contains model input
  * @param model_input_size size of the buffer
@@ -96,15 +166,47 @@ status_t load_model_input(const uint8_t *model_input, const size_t model_input_s
 status_t run_model();
 
 /**
- * Writes model output to given buffer
+ * Returns size of the model output
+ *
+ * @param model_output_size returned size of the model output
+ *
+ * @returns status of the model
+ */
+status_t get_model_output_size(size_t *model_output_size);
+
+/**
+ * Passes model output to the given writer without copying it into intermediate buffer
+ *
+ * @param writer function that consumes consecutive parts of the model output
+ *
+ * @returns status of the model
+ */
+status_t write_model_output(model_output_writer_t writer);
+
+/**
+ * Reduces model output to the classes with the highest scores. All outputs are treated as a single vector of class
+ * scores. Up to max_classes classes which scores are not lower than the threshold are selected, sorted by score in
+ * descending order, so that argmax, top-k and thresholded scores can be computed on the device
+ *
+ * @param max_classes maximal number of selected classes
+ * @param threshold minimal score of selected class
+ * @param classes buffer for at least max_classes selected classes
+ * @param num_classes returned number of selected classes
+ *
+ * @returns status of the model
+ */
+status_t reduce_model_output(const size_t max_classes, const float threshold, model_class_score_t *classes,
+                             size_t *num_classes);
+
+/**
+ * Finds the model output element with the highest score. All outputs are treated as a single vector of class scores
  *
- * @param buffer_size size of the buffer
- * @param model_output buffer to save model output
- * @param model_output_size actual size of the saved data
+ * @param top_class returned index of the element with the highest score
+ * @param top_score returned score of that element
  *
  * @returns status of the model
  */
-status_t get_model_output(const size_t buffer_size, uint8_t *model_output, size_t *model_output_size);
+status_t get_model_output_top_class(uint32_t *top_class, float *top_score);
 
 /**
  * Retrieves model statistics
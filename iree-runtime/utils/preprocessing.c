@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "preprocessing.h"
+#include <math.h>
+
+#if defined(__riscv_vector)
+#if !defined(__UNIT_TEST__)
+#include <riscv_vector.h>
+#else // !defined(__UNIT_TEST__)
+#include "mocks/riscv_vector.h"
+#endif // !defined(__UNIT_TEST__)
+#endif // defined(__riscv_vector)
+
+GENERATE_MODULE_STATUSES_STR(PREPROCESSING);
+
+ut_static preprocessing_config_t g_preprocessing_config = {0};
+
+/**
+ * Per-channel scale and offset repeated for each element of the block. They are longer than the block by the number of
+ * channels, so that the block can start at any channel
+ */
+ut_static float g_preprocessing_scale[PREPROCESSING_BLOCK_LEN + PREPROCESSING_MAX_CHANNELS];
+ut_static float g_preprocessing_offset[PREPROCESSING_BLOCK_LEN + PREPROCESSING_MAX_CHANNELS];
+ut_static size_t g_preprocessing_block_len = 0;
+
+/**
+ * Clamp bounds, narrowed to the int8 range for int8 output
+ */
+ut_static float g_preprocessing_clamp_min = 0.0F;
+ut_static float g_preprocessing_clamp_max = 0.0F;
+
+#if !defined(__riscv_vector) || defined(__UNIT_TEST__)
+/**
+ * Preprocesses block of input elements
+ *
+ * @param input input elements
+ * @param num_elements number of the elements
+ * @param scale scale of each element
+ * @param offset offset of each element
+ * @param output buffer for preprocessed elements
+ */
+ut_static void preprocess_block_scalar(const float *input, const size_t num_elements, const float *scale,
+                                       const float *offset, uint8_t *output)
+{
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        float value = input[i] * scale[i] + offset[i];
+
+        // negation clamps NaN to the lower bound, as vector min/max instructions do
+        if (!(value >= g_preprocessing_clamp_min))
+        {
+            value = g_preprocessing_clamp_min;
+        }
+        if (value > g_preprocessing_clamp_max)
+        {
+            value = g_preprocessing_clamp_max;
+        }
+
+        if (PREPROCESSING_OUTPUT_I8 == g_preprocessing_config.output_type)
+        {
+            ((int8_t *)output)[i] = (int8_t)lrintf(value);
+        }
+        else
+        {
+            ((float *)output)[i] = value;
+        }
+    }
+}
+#endif // !defined(__riscv_vector) || defined(__UNIT_TEST__)
+
+#if defined(__riscv_vector)
+/**
+ * Preprocesses block of input elements with RISC-V vector instructions (Zve32f)
+ *
+ * @param input input elements
+ * @param num_elements number of the elements
+ * @param scale scale of each element
+ * @param offset offset of each element
+ * @param output buffer for preprocessed elements
+ */
+ut_static void preprocess_block_vector(const float *input, const size_t num_elements, const float *scale,
+                                       const float *offset, uint8_t *output)
+{
+    size_t vl = 0;
+
+    for (size_t i = 0; i < num_elements; i += vl)
+    {
+        vl = __riscv_vsetvl_e32m8(num_elements - i);
+
+        vfloat32m8_t value = __riscv_vle32_v_f32m8(&input[i], vl);
+        value = __riscv_vfmadd_vv_f32m8(value, __riscv_vle32_v_f32m8(&scale[i], vl),
+                                        __riscv_vle32_v_f32m8(&offset[i], vl), vl);
+        // NaN is clamped to the lower bound
+        value = __riscv_vfmax_vf_f32m8(value, g_preprocessing_clamp_min, vl);
+        value = __riscv_vfmin_vf_f32m8(value, g_preprocessing_clamp_max, vl);
+
+        if (PREPROCESSING_OUTPUT_I8 == g_preprocessing_config.output_type)
+        {
+            // values are already in the int8 range, so narrowing does not saturate
+            vint16m4_t value_i16 = __riscv_vfncvt_x_f_w_i16m4(value, vl);
+            __riscv_vse8_v_i8m2((int8_t *)&output[i], __riscv_vncvt_x_x_w_i8m2(value_i16, vl), vl);
+        }
+        else
+        {
+            __riscv_vse32_v_f32m8((float *)&output[i * sizeof(float)], value, vl);
+        }
+    }
+}
+#endif // defined(__riscv_vector)
+
+status_t preprocessing_configure(const preprocessing_config_t *config)
+{
+    VALIDATE_POINTER(config, PREPROCESSING_STATUS_INV_PTR);
+
+    if (config->num_channels > PREPROCESSING_MAX_CHANNELS || config->output_type >= NUM_PREPROCESSING_OUTPUTS)
+    {
+        return PREPROCESSING_STATUS_INV_ARG;
+    }
+
+    float clamp_min = config->clamp_min;
+    float clamp_max = config->clamp_max;
+    if (PREPROCESSING_OUTPUT_I8 == config->output_type)
+    {
+        clamp_min = clamp_min > INT8_MIN ? clamp_min : INT8_MIN;
+        clamp_max = clamp_max < INT8_MAX ? clamp_max : INT8_MAX;
+    }
+    // negation catches NaN as well
+    if (config->num_channels > 0 && !(clamp_min <= clamp_max))
+    {
+        return PREPROCESSING_STATUS_INV_ARG;
+    }
+
+    g_preprocessing_config = *config;
+    g_preprocessing_clamp_min = clamp_min;
+    g_preprocessing_clamp_max = clamp_max;
+    g_preprocessing_block_len = 0;
+
+    if (0 == config->num_channels)
+    {
+        LOG_DEBUG("Preprocessing disabled");
+        return STATUS_OK;
+    }
+
+    g_preprocessing_block_len = PREPROCESSING_BLOCK_LEN / config->num_channels * config->num_channels;
+    for (size_t i = 0; i < g_preprocessing_block_len + config->num_channels; ++i)
+    {
+        g_preprocessing_scale[i] = config->scale[i % config->num_channels];
+        g_preprocessing_offset[i] = config->offset[i % config->num_channels];
+    }
+
+    LOG_DEBUG("Preprocessing configured. Channels: %d, output type: %d", config->num_channels, config->output_type);
+
+    return STATUS_OK;
+}
+
+size_t preprocessing_get_output_element_size()
+{
+    if (0 == g_preprocessing_config.num_channels)
+    {
+        return 0;
+    }
+    return PREPROCESSING_OUTPUT_I8 == g_preprocessing_config.output_type ? sizeof(int8_t) : sizeof(float);
+}
+
+status_t preprocess(const float *input, const size_t num_elements, const size_t first_element, uint8_t *output)
+{
+    VALIDATE_POINTER(input, PREPROCESSING_STATUS_INV_PTR);
+    VALIDATE_POINTER(output, PREPROCESSING_STATUS_INV_PTR);
+
+    if (0 == g_preprocessing_config.num_channels)
+    {
+        return PREPROCESSING_STATUS_UNINIT;
+    }
+
+    // blocks are multiples of the number of channels, so each block starts at the same channel
+    const size_t channel = first_element % g_preprocessing_config.num_channels;
+    const size_t output_element_size = preprocessing_get_output_element_size();
+
+    for (size_t i = 0; i < num_elements; i += g_preprocessing_block_len)
+    {
+        size_t block_len = num_elements - i < g_preprocessing_block_len ? num_elements - i : g_preprocessing_block_len;
+#if defined(__riscv_vector)
+        preprocess_block_vector(&input[i], block_len, &g_preprocessing_scale[channel], &g_preprocessing_offset[channel],
+                                &output[i * output_element_size]);
+#else  // defined(__riscv_vector)
+        preprocess_block_scalar(&input[i], block_len, &g_preprocessing_scale[channel], &g_preprocessing_offset[channel],
+                                &output[i * output_element_size]);
+#endif // defined(__riscv_vector)
+    }
+
+    return STATUS_OK;
+}
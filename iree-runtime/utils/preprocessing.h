@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IREE_RUNTIME_UTILS_PREPROCESSING_H_
+#define IREE_RUNTIME_UTILS_PREPROCESSING_H_
+
+#if !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+#include "springbok.h"
+#else // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+#include "mocks/springbok.h"
+#endif // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+
+#include "utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Preprocessing custom error codes
+ */
+#define PREPROCESSING_STATUSES(STATUS)
+
+GENERATE_MODULE_STATUSES(PREPROCESSING);
+
+/**
+ * Maximal number of interleaved input channels with separate scale and offset
+ */
+#define PREPROCESSING_MAX_CHANNELS 8
+
+/**
+ * Number of elements processed with the same expanded per-channel parameters. It is rounded down to the multiple of the
+ * number of channels
+ */
+#define PREPROCESSING_BLOCK_LEN 64
+
+/**
+ * Types of the preprocessing output
+ */
+typedef enum
+{
+    PREPROCESSING_OUTPUT_F32 = 0, /* float */
+    PREPROCESSING_OUTPUT_I8 = 1,  /* int8 rounded to the nearest, ties to even */
+    NUM_PREPROCESSING_OUTPUTS
+} PREPROCESSING_OUTPUT;
+
+/**
+ * Preprocessing configuration. Each float input element x of channel c is transformed into
+ * clamp(x * scale[c] + offset[c], clamp_min, clamp_max) and converted to the output type. The int8 output is
+ * additionally saturated to its range
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t num_channels; /* number of interleaved input channels, 0 disables preprocessing */
+    uint32_t output_type;  /* PREPROCESSING_OUTPUT */
+    float scale[PREPROCESSING_MAX_CHANNELS];
+    float offset[PREPROCESSING_MAX_CHANNELS];
+    float clamp_min;
+    float clamp_max;
+} preprocessing_config_t;
+
+/**
+ * Sets preprocessing configuration
+ *
+ * @param config preprocessing configuration
+ *
+ * @returns error status of the preprocessing
+ */
+status_t preprocessing_configure(const preprocessing_config_t *config);
+
+/**
+ * Returns size of the preprocessing output element
+ *
+ * @returns size of the output element in bytes or 0 if preprocessing is disabled
+ */
+size_t preprocessing_get_output_element_size();
+
+/**
+ * Preprocesses float input elements. Elements are assigned to the channels in the interleaved order, starting from
+ * the given element index
+ *
+ * @param input input elements
+ * @param num_elements number of the elements
+ * @param first_element index of the first element, used to assign elements to the channels
+ * @param output buffer for preprocessed elements
+ *
+ * @returns error status of the preprocessing
+ */
+status_t preprocess(const float *input, const size_t num_elements, const size_t first_element, uint8_t *output);
+
+#endif // IREE_RUNTIME_UTILS_PREPROCESSING_H_
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "profiler.h"
+#include <string.h>
+
+GENERATE_MODULE_STATUSES_STR(PROFILER);
+
+/**
+ * Running statistics of the phase. The sums are kept for the averages
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min[NUM_PROFILER_COUNTERS];
+    uint32_t max[NUM_PROFILER_COUNTERS];
+    uint64_t sum[NUM_PROFILER_COUNTERS];
+    uint32_t cycles_histogram[PROFILER_HISTOGRAM_BINS];
+} profiler_phase_t;
+
+ut_static profiler_phase_t g_profiler_phases[NUM_PROFILER_PHASES] = {0};
+
+/**
+ * Reads counters
+ *
+ * @param timestamp returned values of the counters
+ */
+static void read_counters(profiler_timestamp_t *timestamp)
+{
+    CSR_READ(timestamp->counters[PROFILER_COUNTER_CYCLE], CSR_CYCLE);
+    CSR_READ(timestamp->counters[PROFILER_COUNTER_TIME], CSR_TIME);
+    CSR_READ(timestamp->counters[PROFILER_COUNTER_INSTRET], CSR_INSTRET);
+}
+
+/**
+ * Returns histogram bin of the cycles
+ *
+ * @param cycles number of cycles
+ *
+ * @returns index of the bin
+ */
+static size_t get_histogram_bin(uint32_t cycles)
+{
+    size_t bin = 0;
+
+    while (cycles >> PROFILER_HISTOGRAM_BIN_SHIFT && bin < PROFILER_HISTOGRAM_BINS - 1)
+    {
+        cycles >>= PROFILER_HISTOGRAM_BIN_SHIFT;
+        ++bin;
+    }
+
+    return bin;
+}
+
+void profiler_start(profiler_timestamp_t *timestamp)
+{
+    if (IS_VALID_POINTER(timestamp))
+    {
+        read_counters(timestamp);
+    }
+}
+
+status_t profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp)
+{
+    profiler_timestamp_t end = {0};
+    uint32_t irq_state = 0;
+
+    // counters are read first, so that the phase does not include validation
+    read_counters(&end);
+
+    VALIDATE_POINTER(timestamp, PROFILER_STATUS_INV_PTR);
+
+    if (phase >= NUM_PROFILER_PHASES)
+    {
+        return PROFILER_STATUS_INV_ARG;
+    }
+
+    profiler_phase_t *stats = &g_profiler_phases[phase];
+
+    // phase may be recorded from the interrupt handler
+    irq_state = interrupts_lock();
+    for (size_t i = 0; i < NUM_PROFILER_COUNTERS; ++i)
+    {
+        // counters overflow, so deltas are computed modulo 2^32
+        uint32_t delta = end.counters[i] - timestamp->counters[i];
+
+        if (0 == stats->count || delta < stats->min[i])
+        {
+            stats->min[i] = delta;
+        }
+        if (0 == stats->count || delta > stats->max[i])
+        {
+            stats->max[i] = delta;
+        }
+        stats->sum[i] += delta;
+    }
+    ++stats->cycles_histogram[get_histogram_bin(end.counters[PROFILER_COUNTER_CYCLE] -
+                                                timestamp->counters[PROFILER_COUNTER_CYCLE])];
+    ++stats->count;
+    interrupts_unlock(irq_state);
+
+    return STATUS_OK;
+}
+
+status_t profiler_get_stats(const size_t buffer_size, uint8_t *buffer, size_t *stats_size)
+{
+    profiler_phase_stats_t phase_stats = {0};
+    uint32_t irq_state = 0;
+
+    VALIDATE_POINTER(buffer, PROFILER_STATUS_INV_PTR);
+    VALIDATE_POINTER(stats_size, PROFILER_STATUS_INV_PTR);
+
+    if (buffer_size < NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t))
+    {
+        return PROFILER_STATUS_INV_ARG;
+    }
+
+    for (size_t phase = 0; phase < NUM_PROFILER_PHASES; ++phase)
+    {
+        const profiler_phase_t *stats = &g_profiler_phases[phase];
+
+        irq_state = interrupts_lock();
+        phase_stats.count = stats->count;
+        for (size_t i = 0; i < NUM_PROFILER_COUNTERS; ++i)
+        {
+            phase_stats.counters[i].min = stats->min[i];
+            phase_stats.counters[i].avg = stats->count ? (uint32_t)(stats->sum[i] / stats->count) : 0;
+            phase_stats.counters[i].max = stats->max[i];
+        }
+        memcpy(phase_stats.cycles_histogram, stats->cycles_histogram, sizeof(phase_stats.cycles_histogram));
+        interrupts_unlock(irq_state);
+
+        // buffer does not have to be aligned
+        memcpy(&buffer[phase * sizeof(profiler_phase_stats_t)], &phase_stats, sizeof(profiler_phase_stats_t));
+    }
+    *stats_size = NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t);
+
+    return STATUS_OK;
+}
+
+void profiler_reset()
+{
+    uint32_t irq_state = interrupts_lock();
+
+    memset(g_profiler_phases, 0, sizeof(g_profiler_phases));
+
+    interrupts_unlock(irq_state);
+
+    LOG_DEBUG("Profiler statistics cleared");
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IREE_RUNTIME_UTILS_PROFILER_H_
+#define IREE_RUNTIME_UTILS_PROFILER_H_
+
+#if !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+#include "springbok.h"
+#else // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+#include "mocks/springbok.h"
+#endif // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
+
+#include "interrupts.h"
+#include "utils.h"
+#include <stdint.h>
+
+/**
+ * Profiler custom error codes
+ */
+#define PROFILER_STATUSES(STATUS)
+
+GENERATE_MODULE_STATUSES(PROFILER);
+
+/**
+ * Number of bins of the cycles histogram. Bin i counts phases that took [4^i, 4^(i+1)) cycles, bin 0 counts phases
+ * shorter than 4 cycles
+ */
+#define PROFILER_HISTOGRAM_BINS 16
+#define PROFILER_HISTOGRAM_BIN_SHIFT 2
+
+/**
+ * Profiled phases of handling requests
+ */
+typedef enum
+{
+    PROFILER_PHASE_RECEIVE = 0,    /* receiving the request message */
+    PROFILER_PHASE_LOAD_INPUT = 1, /* writing model input into the input buffer */
+    PROFILER_PHASE_INFERENCE = 2,  /* invoking the model */
+    PROFILER_PHASE_GET_OUTPUT = 3, /* reading model output requested by the client, including the output writer */
+    PROFILER_PHASE_SEND = 4,       /* sending the response message */
+    NUM_PROFILER_PHASES
+} PROFILER_PHASE;
+
+/**
+ * Counters read at the beginning and at the end of each phase
+ */
+typedef enum
+{
+    PROFILER_COUNTER_CYCLE = 0,   /* cycle CSR */
+    PROFILER_COUNTER_TIME = 1,    /* time CSR, in timer ticks */
+    PROFILER_COUNTER_INSTRET = 2, /* instret CSR */
+    NUM_PROFILER_COUNTERS
+} PROFILER_COUNTER;
+
+/**
+ * Values of the counters at the beginning of the phase
+ */
+typedef struct
+{
+    uint32_t counters[NUM_PROFILER_COUNTERS];
+} profiler_timestamp_t;
+
+/**
+ * Statistics of the counter deltas. All values are 0 if the phase was not recorded
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+} profiler_counter_stats_t;
+
+/**
+ * Statistics of the phase
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t count; /* number of recorded phases */
+    profiler_counter_stats_t counters[NUM_PROFILER_COUNTERS];
+    uint32_t cycles_histogram[PROFILER_HISTOGRAM_BINS];
+} profiler_phase_stats_t;
+
+/**
+ * Reads counters at the beginning of the phase
+ *
+ * @param timestamp returned values of the counters
+ */
+void profiler_start(profiler_timestamp_t *timestamp);
+
+/**
+ * Reads counters at the end of the phase and updates its statistics. It can be called from the interrupt handler
+ *
+ * @param phase recorded phase
+ * @param timestamp values of the counters at the beginning of the phase, as returned by profiler_start
+ *
+ * @returns error status of the profiler
+ */
+status_t profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp);
+
+/**
+ * Writes statistics of all phases, as an array of profiler_phase_stats_t indexed by PROFILER_PHASE
+ *
+ * @param buffer_size size of the buffer
+ * @param buffer buffer for the statistics
+ * @param stats_size returned size of the statistics
+ *
+ * @returns error status of the profiler
+ */
+status_t profiler_get_stats(const size_t buffer_size, uint8_t *buffer, size_t *stats_size);
+
+/**
+ * Clears statistics of all phases
+ */
+void profiler_reset();
+
+#endif // IREE_RUNTIME_UTILS_PROFILER_H_
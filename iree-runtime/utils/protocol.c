@@ -11,18 +11,66 @@ const char *const MESSAGE_TYPE_STR[] = {MESSAGE_TYPES(GENERATE_STR)};
 
 static uint8_t __attribute__((aligned(4))) g_message_buffer[MAX_MESSAGE_SIZE_BYTES + 2];
 
+ut_static message_buffer_provider_t g_message_buffer_providers[NUM_MESSAGE_TYPES] = {NULL};
+
+/**
+ * Set while the message placed in the default message buffer is queued for transmission
+ */
+ut_static volatile bool g_message_buffer_queued = false;
+
+/**
+ * Callback of the message queued from the default message buffer
+ */
+static message_sent_callback_t g_message_buffer_sent_callback = NULL;
+
+/**
+ * Releases the default message buffer once the message queued from it is sent
+ *
+ * @param data sent data
+ * @param data_length size of the sent data
+ */
+static void message_buffer_sent(const uint8_t *data, const size_t data_length)
+{
+    g_message_buffer_queued = false;
+    if (IS_VALID_POINTER(g_message_buffer_sent_callback))
+    {
+        g_message_buffer_sent_callback(data, data_length);
+    }
+}
+
 /**
- * Returns pointer to a message buffer with payload aligned to 4 bytes
+ * Returns pointer to a message buffer with payload aligned to 4 bytes. If the message from the buffer is still queued
+ * for transmission, it waits until the message is sent
  *
  * @returns pointer to a message buffer
  */
 static message_t *get_message_buffer()
 {
+    while (g_message_buffer_queued)
+    {
+        if (STATUS_OK != uart_flush())
+        {
+            return NULL;
+        }
+    }
+
     // payload should be aligned to 4 bytes and as header (msg size and msg type) are
     // total 6 bytes, we need to shift msg buffer pointer 2 bytes
     return (message_t *)(g_message_buffer + 2);
 }
 
+status_t register_message_buffer_provider(const MESSAGE_TYPE msg_type, message_buffer_provider_t provider)
+{
+    if (msg_type >= NUM_MESSAGE_TYPES)
+    {
+        return PROTOCOL_STATUS_INV_ARG;
+    }
+
+    g_message_buffer_providers[msg_type] = provider;
+
+    return STATUS_OK;
+}
+
 status_t receive_message(message_t **msg)
 {
     status_t status = STATUS_OK;
@@ -38,18 +86,25 @@ status_t receive_message(message_t **msg)
 
     msg_size = *((message_size_t *)data);
 
-    if (msg_size > MAX_MESSAGE_SIZE_BYTES)
-    {
-        return PROTOCOL_STATUS_MSG_TOO_BIG;
-    }
-
     // read type of the message
     status = uart_read(data, sizeof(message_type_t));
     CHECK_UART_STATUS(status);
     msg_type = *((message_type_t *)data);
 
     // get pointer to the message buffer
-    *msg = get_message_buffer();
+    *msg = NULL;
+    if (msg_type < NUM_MESSAGE_TYPES && IS_VALID_POINTER(g_message_buffer_providers[msg_type]))
+    {
+        *msg = g_message_buffer_providers[msg_type](msg_size);
+    }
+    if (!IS_VALID_POINTER(*msg))
+    {
+        if (msg_size > MAX_MESSAGE_SIZE_BYTES)
+        {
+            return PROTOCOL_STATUS_MSG_TOO_BIG;
+        }
+        *msg = get_message_buffer();
+    }
     VALIDATE_POINTER(*msg, PROTOCOL_STATUS_INV_PTR);
 
     (*msg)->message_size = msg_size;
@@ -79,6 +134,84 @@ status_t send_message(const message_t *msg)
     return status;
 }
 
+status_t send_message_async(const message_t *msg, message_sent_callback_t callback)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(msg, PROTOCOL_STATUS_INV_PTR);
+
+    // default message buffer is reused only after the message is sent
+    if ((const uint8_t *)msg == g_message_buffer + 2)
+    {
+        g_message_buffer_sent_callback = callback;
+        g_message_buffer_queued = true;
+        callback = message_buffer_sent;
+    }
+
+    status = uart_write_async((const uint8_t *)msg, MESSAGE_SIZE_FULL(msg->message_size), callback);
+    if (STATUS_OK != status && message_buffer_sent == callback)
+    {
+        g_message_buffer_queued = false;
+    }
+
+    CHECK_UART_STATUS(status);
+
+    return status;
+}
+
+status_t send_message_header(const MESSAGE_TYPE msg_type, const size_t payload_size)
+{
+    status_t status = STATUS_OK;
+    message_t header;
+
+    header.message_size = sizeof(message_type_t) + payload_size;
+    header.message_type = msg_type;
+
+    status = uart_write((uint8_t *)&header, sizeof(message_t));
+
+    CHECK_UART_STATUS(status);
+
+    return status;
+}
+
+status_t send_message_payload(const uint8_t *payload, const size_t payload_size)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(payload, PROTOCOL_STATUS_INV_PTR);
+
+    status = uart_write(payload, payload_size);
+
+    CHECK_UART_STATUS(status);
+
+    return status;
+}
+
+status_t send_message_payload_async(const uint8_t *payload, const size_t payload_size,
+                                    message_sent_callback_t callback)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(payload, PROTOCOL_STATUS_INV_PTR);
+
+    status = uart_write_async(payload, payload_size, callback);
+
+    CHECK_UART_STATUS(status);
+
+    return status;
+}
+
+status_t flush_messages()
+{
+    status_t status = STATUS_OK;
+
+    status = uart_flush();
+
+    CHECK_UART_STATUS(status);
+
+    return status;
+}
+
 status_t prepare_success_response(message_t **response)
 {
     VALIDATE_POINTER(response, PROTOCOL_STATUS_INV_PTR);
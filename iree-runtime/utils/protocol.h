@@ -19,7 +19,7 @@
         return PROTOCOL_STATUS_CLIENT_DISCONNECTED; \
     }
 
-#define MAX_MESSAGE_SIZE_BYTES (5 * 256 * 1024) // 1.25 MB
+#define MAX_MESSAGE_SIZE_BYTES (128 * 1024) // 128 KB
 
 #define MESSAGE_SIZE_PAYLOAD(msg_size) ((msg_size) - sizeof(message_type_t))
 #define MESSAGE_SIZE_FULL(msg_size) (sizeof(message_t) + MESSAGE_SIZE_PAYLOAD(msg_size))
@@ -27,15 +27,26 @@
 /**
  * An enum that describes message type
  */
-#define MESSAGE_TYPES(TYPE)    \
-    TYPE(MESSAGE_TYPE_OK)      \
-    TYPE(MESSAGE_TYPE_ERROR)   \
-    TYPE(MESSAGE_TYPE_DATA)    \
-    TYPE(MESSAGE_TYPE_MODEL)   \
-    TYPE(MESSAGE_TYPE_PROCESS) \
-    TYPE(MESSAGE_TYPE_OUTPUT)  \
-    TYPE(MESSAGE_TYPE_STATS)   \
-    TYPE(MESSAGE_TYPE_IOSPEC)  \
+#define MESSAGE_TYPES(TYPE)               \
+    TYPE(MESSAGE_TYPE_OK)                 \
+    TYPE(MESSAGE_TYPE_ERROR)              \
+    TYPE(MESSAGE_TYPE_DATA)               \
+    TYPE(MESSAGE_TYPE_MODEL)              \
+    TYPE(MESSAGE_TYPE_PROCESS)            \
+    TYPE(MESSAGE_TYPE_OUTPUT)             \
+    TYPE(MESSAGE_TYPE_STATS)              \
+    TYPE(MESSAGE_TYPE_IOSPEC)             \
+    TYPE(MESSAGE_TYPE_MODEL_BEGIN)        \
+    TYPE(MESSAGE_TYPE_MODEL_CHUNK)        \
+    TYPE(MESSAGE_TYPE_MODEL_COMMIT)       \
+    TYPE(MESSAGE_TYPE_INFER)              \
+    TYPE(MESSAGE_TYPE_BAUDRATE)           \
+    TYPE(MESSAGE_TYPE_SENSOR_CONFIG)      \
+    TYPE(MESSAGE_TYPE_INPUT_STRIDE)       \
+    TYPE(MESSAGE_TYPE_ACTIVITY_THRESHOLD) \
+    TYPE(MESSAGE_TYPE_RESULT)             \
+    TYPE(MESSAGE_TYPE_RESULT_MODE)        \
+    TYPE(MESSAGE_TYPE_PREPROCESSING)      \
     TYPE(NUM_MESSAGE_TYPES)
 
 typedef enum
@@ -70,6 +81,28 @@ typedef struct __attribute__((packed))
     uint8_t payload[0];
 } message_t;
 
+/**
+ * Type of function that provides buffer for the incoming message. It should return NULL if the message of given size
+ * cannot be received into the buffer
+ */
+typedef message_t *(*message_buffer_provider_t)(const message_size_t);
+
+/**
+ * Type of function called when the message queued with send_message_async is sent and its buffer can be reused
+ */
+typedef uart_write_callback_t message_sent_callback_t;
+
+/**
+ * Registers function that provides buffer for messages of given type. Messages of that type are received straight into
+ * the provided buffer instead of the default message buffer. If the provider returns NULL, the default message buffer
+ * is used
+ *
+ * @param msg_type type of the message
+ * @param provider function that provides the buffer or NULL to use the default message buffer
+ *
+ * @returns status of the protocol
+ */
+status_t register_message_buffer_provider(const MESSAGE_TYPE msg_type, message_buffer_provider_t provider);
 /**
  * Waits for a message to be received
  *
@@ -86,6 +119,52 @@ status_t receive_message(message_t **msg);
  * @returns status of the protocol
  */
 status_t send_message(const message_t *msg);
+/**
+ * Queues given message for transmission without copying it and returns without waiting for the transmission. The
+ * message must not be modified until the callback is called. Messages placed in the default message buffer are
+ * protected by the protocol, so that the buffer is not reused before the message is sent
+ *
+ * @param msg message to be sent
+ * @param callback function called when the message buffer can be reused or NULL
+ *
+ * @returns status of the protocol
+ */
+status_t send_message_async(const message_t *msg, message_sent_callback_t callback);
+/**
+ * Sends header of the message which payload is going to be sent in parts with send_message_payload
+ *
+ * @param msg_type type of the message
+ * @param payload_size total size of the payload
+ *
+ * @returns status of the protocol
+ */
+status_t send_message_header(const MESSAGE_TYPE msg_type, const size_t payload_size);
+/**
+ * Sends part of the payload of the message which header was sent with send_message_header
+ *
+ * @param payload part of the payload
+ * @param payload_size size of the part
+ *
+ * @returns status of the protocol
+ */
+status_t send_message_payload(const uint8_t *payload, const size_t payload_size);
+/**
+ * Queues part of the payload of the message which header was sent with send_message_header without copying it
+ *
+ * @param payload part of the payload
+ * @param payload_size size of the part
+ * @param callback function called when the payload buffer can be reused or NULL
+ *
+ * @returns status of the protocol
+ */
+status_t send_message_payload_async(const uint8_t *payload, const size_t payload_size,
+                                    message_sent_callback_t callback);
+/**
+ * Waits until all queued messages are sent
+ *
+ * @returns status of the protocol
+ */
+status_t flush_messages();
 /**
  * Create a message that indicates an successful action
  *
@@ -8,9 +8,240 @@
 
 GENERATE_MODULE_STATUSES_STR(SENSOR);
 
-ut_static sensor_data_t g_sensor_data_buffer[SENSOR_BUFFER_LEN];
+#ifdef SENSOR_FIFO_LEN
+/* period of the timer interrupt, the samples accumulate in the sensor FIFO in the meantime */
+#define SENSOR_SAMPLING_PERIOD (g_sensor_read_interval * SENSOR_FIFO_BURST_LEN)
+#else // SENSOR_FIFO_LEN
+#define SENSOR_SAMPLING_PERIOD (g_sensor_read_interval)
+#endif // SENSOR_FIFO_LEN
+
+/**
+ * Sensor data ring buffer. Every sample is stored twice, SENSOR_BUFFER_LEN samples apart, so that the last
+ * SENSOR_BUFFER_LEN samples are always contiguous, starting at g_sensor_data_buffer_idx
+ */
+ut_static sensor_buffer_t g_sensor_data_buffer;
 ut_static size_t g_sensor_data_buffer_idx = 0;
-static uint32_t g_sensor_last_read_time = 0;
+/**
+ * Format of the buffered samples
+ */
+ut_static SENSOR_SAMPLE_FORMAT g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_FLOAT;
+ut_static uint32_t g_sensor_last_read_time = 0;
+/**
+ * Interval between sensor reads in timer ticks, it follows the output data rate of the sensor
+ */
+ut_static uint32_t g_sensor_read_interval = (uint32_t)(SENSOR_READ_INTERVAL * TIMER_CLOCK_FREQ);
+/**
+ * True if the sensor is sampled periodically, paced by the timer interrupt
+ */
+ut_static bool g_sensor_sampling = false;
+/**
+ * Number of new samples after which the buffered data is ready
+ */
+ut_static size_t g_sensor_stride = 1;
+/**
+ * Number of samples stored since the buffered data was last taken
+ */
+ut_static size_t g_sensor_new_samples = 0;
+/**
+ * Number of sampling periods elapsed since the sampling started, it is incremented only by the timer interrupt. The
+ * samples of the elapsed periods are read by sensor_read_data_into_buffer from the main loop, so that the I2C transfers
+ * do not run with interrupts disabled
+ */
+ut_static volatile uint32_t g_sensor_sampling_ticks = 0;
+/**
+ * Number of sampling periods whose samples were read, it is updated only from the main loop. Ticks of the periods that
+ * elapsed while the main loop was busy stay queued until they are caught up
+ */
+ut_static uint32_t g_sensor_sampling_ticks_read = 0;
+/**
+ * Time of the last timer interrupt, so that the read time does not depend on when the main loop gets to the samples
+ */
+ut_static volatile uint32_t g_sensor_last_tick_time = 0;
+
+/**
+ * Appends sample to the buffer
+ *
+ * @param sensor_data sample to be appended
+ */
+static void store_sample(const sensor_data_t *sensor_data)
+{
+    // write data to the buffer and its mirror
+    g_sensor_data_buffer.data[g_sensor_data_buffer_idx] = *sensor_data;
+    g_sensor_data_buffer.data[g_sensor_data_buffer_idx + SENSOR_BUFFER_LEN] = *sensor_data;
+
+    // increment buffer index
+    ++g_sensor_data_buffer_idx;
+    g_sensor_data_buffer_idx %= SENSOR_BUFFER_LEN;
+}
+
+/**
+ * Appends raw sample to the buffer
+ *
+ * @param sensor_data raw sample to be appended
+ */
+static void store_raw_sample(const sensor_raw_data_t *sensor_data)
+{
+    // write data to the buffer and its mirror
+    g_sensor_data_buffer.raw_data[g_sensor_data_buffer_idx] = *sensor_data;
+    g_sensor_data_buffer.raw_data[g_sensor_data_buffer_idx + SENSOR_BUFFER_LEN] = *sensor_data;
+
+    // increment buffer index
+    ++g_sensor_data_buffer_idx;
+    g_sensor_data_buffer_idx %= SENSOR_BUFFER_LEN;
+}
+
+/**
+ * Returns size of the buffered sample in the current sample format
+ *
+ * @returns size of the sample
+ */
+static size_t get_sample_size()
+{
+    return SENSOR_SAMPLE_FORMAT_RAW == g_sensor_sample_format ? sizeof(sensor_raw_data_t) : sizeof(sensor_data_t);
+}
+
+/**
+ * Returns window of the last SENSOR_BUFFER_LEN buffered samples, starting from the oldest one
+ *
+ * @returns pointer to the window
+ */
+static const uint8_t *get_window()
+{
+    if (SENSOR_SAMPLE_FORMAT_RAW == g_sensor_sample_format)
+    {
+        return (const uint8_t *)&g_sensor_data_buffer.raw_data[g_sensor_data_buffer_idx];
+    }
+    return (const uint8_t *)&g_sensor_data_buffer.data[g_sensor_data_buffer_idx];
+}
+
+/**
+ * Reads single sample from the sensor and appends it to the buffer
+ *
+ * @returns status of the sensor
+ */
+static status_t read_sample()
+{
+    status_t status = STATUS_OK;
+
+    if (SENSOR_SAMPLE_FORMAT_RAW == g_sensor_sample_format)
+    {
+        sensor_raw_data_t sensor_data = {0};
+        status_t (*read_raw_data_function)(sensor_raw_data_t *) = SENSOR_READ_RAW_DATA_FUN;
+
+        status = read_raw_data_function(&sensor_data);
+        RETURN_ON_ERROR(status, status);
+
+        store_raw_sample(&sensor_data);
+    }
+    else
+    {
+        sensor_data_t sensor_data = {0};
+        status_t (*read_data_function)(sensor_data_t *) = SENSOR_READ_DATA_FUN;
+
+        status = read_data_function(&sensor_data);
+        RETURN_ON_ERROR(status, status);
+
+        store_sample(&sensor_data);
+    }
+
+    return STATUS_OK;
+}
+
+#ifdef SENSOR_FIFO_LEN
+/**
+ * Reads all samples stored in the sensor FIFO and appends them to the buffer
+ *
+ * @param count number of read samples
+ *
+ * @returns status of the sensor
+ */
+static status_t read_fifo_samples(size_t *count)
+{
+    status_t status = STATUS_OK;
+
+    // samples read before the failure are still valid
+    if (SENSOR_SAMPLE_FORMAT_RAW == g_sensor_sample_format)
+    {
+        sensor_raw_data_t samples[SENSOR_FIFO_LEN];
+        status_t (*read_raw_fifo_function)(sensor_raw_data_t *, const size_t, size_t *) = SENSOR_READ_RAW_FIFO_FUN;
+
+        status = read_raw_fifo_function(samples, SENSOR_FIFO_LEN, count);
+        for (size_t i = 0; i < *count; ++i)
+        {
+            store_raw_sample(&samples[i]);
+        }
+    }
+    else
+    {
+        sensor_data_t samples[SENSOR_FIFO_LEN];
+        status_t (*read_fifo_function)(sensor_data_t *, const size_t, size_t *) = SENSOR_READ_FIFO_FUN;
+
+        status = read_fifo_function(samples, SENSOR_FIFO_LEN, count);
+        for (size_t i = 0; i < *count; ++i)
+        {
+            store_sample(&samples[i]);
+        }
+    }
+
+    return status;
+}
+#endif // SENSOR_FIFO_LEN
+
+/**
+ * Reads samples of the sampling periods elapsed since the last call and appends them to the buffer. If the sensor has
+ * FIFO, all samples accumulated in it are read, regardless of the number of elapsed periods. Otherwise a single sample
+ * is read per elapsed period, up to SENSOR_BUFFER_LEN samples, as the older ones would be overwritten anyway. Samples
+ * of the periods missed while the main loop was busy are then read back to back
+ *
+ * @returns status of the sensor
+ */
+ut_static status_t sensor_sample()
+{
+    status_t status = STATUS_OK;
+    size_t count = 0;
+    // ticks are read once, so that the periods elapsing in the meantime are left for the next call
+    uint32_t ticks = g_sensor_sampling_ticks;
+    uint32_t tick_time = g_sensor_last_tick_time;
+
+#ifdef SENSOR_FIFO_LEN
+    status = read_fifo_samples(&count);
+#else  // SENSOR_FIFO_LEN
+    uint32_t due_samples = ticks - g_sensor_sampling_ticks_read;
+    if (due_samples > SENSOR_BUFFER_LEN)
+    {
+        due_samples = SENSOR_BUFFER_LEN;
+    }
+    while (count < due_samples && STATUS_OK == status)
+    {
+        status = read_sample();
+        count += STATUS_OK == status ? 1 : 0;
+    }
+#endif // SENSOR_FIFO_LEN
+
+    // periods are marked as read also on failure, so that the failed reads are not retried in a loop
+    g_sensor_sampling_ticks_read = ticks;
+
+    if (count > 0)
+    {
+        g_sensor_last_read_time = tick_time;
+        g_sensor_new_samples += count;
+    }
+
+    return status;
+}
+
+/**
+ * Queues samples of the elapsed sampling period, it is called from the timer interrupt
+ */
+ut_static void sensor_sample_due()
+{
+    uint32_t time = 0;
+
+    CSR_READ(time, CSR_TIME);
+
+    g_sensor_last_tick_time = time;
+    ++g_sensor_sampling_ticks;
+}
 
 status_t sensor_init()
 {
@@ -42,7 +273,100 @@ status_t sensor_get_data_size(size_t *data_size)
 {
     VALIDATE_POINTER(data_size, SENSOR_STATUS_INV_PTR);
 
-    *data_size = sizeof(sensor_data_t);
+    *data_size = get_sample_size();
+
+    return STATUS_OK;
+}
+
+status_t sensor_set_sample_format(const SENSOR_SAMPLE_FORMAT format)
+{
+    if (format >= NUM_SENSOR_SAMPLE_FORMATS)
+    {
+        return SENSOR_STATUS_INV_ARG;
+    }
+    if (format == g_sensor_sample_format)
+    {
+        return STATUS_OK;
+    }
+
+    // samples in the previous format are discarded
+    g_sensor_sample_format = format;
+    memset(&g_sensor_data_buffer, 0, sizeof(g_sensor_data_buffer));
+    g_sensor_data_buffer_idx = 0;
+    g_sensor_new_samples = 0;
+
+    LOG_DEBUG("Sensor sample format: %d", format);
+
+    return STATUS_OK;
+}
+
+status_t sensor_configure(const float data_rate, const uint32_t range)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 0.0F;
+
+    status_t (*validate_config_function)(const float, const uint32_t) = SENSOR_VALIDATE_CONFIG_FUN;
+    status_t (*set_range_function)(const uint32_t) = SENSOR_SET_RANGE_FUN;
+    status_t (*set_data_rate_function)(const float, float *) = SENSOR_SET_DATA_RATE_FUN;
+
+    // an invalid value leaves the sensor unchanged
+    status = validate_config_function(data_rate, range);
+    RETURN_ON_ERROR(status, status);
+
+    // range does not affect the read interval, so it is set first and the interval is only updated with the rate
+    status = set_range_function(range);
+    RETURN_ON_ERROR(status, status);
+
+    status = set_data_rate_function(data_rate, &applied_rate);
+    RETURN_ON_ERROR(status, status);
+
+    g_sensor_read_interval = (uint32_t)(TIMER_CLOCK_FREQ / applied_rate);
+    LOG_DEBUG("Sensor configured. Read interval: %u", g_sensor_read_interval);
+
+    // sampling period follows the read interval
+    if (g_sensor_sampling)
+    {
+        status = timer_set_periodic_callback(SENSOR_SAMPLING_PERIOD, sensor_sample_due);
+        if (STATUS_OK != status)
+        {
+            g_sensor_sampling = false;
+        }
+    }
+
+    return status;
+}
+
+status_t sensor_start_sampling()
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_new_samples = 0;
+    // ticks that elapsed before are dropped, the counter itself is written only by the timer interrupt
+    g_sensor_sampling_ticks_read = g_sensor_sampling_ticks;
+
+#ifdef SENSOR_FIFO_LEN
+    status_t (*enable_fifo_function)() = SENSOR_ENABLE_FIFO_FUN;
+
+    status = enable_fifo_function();
+    RETURN_ON_ERROR(status, status);
+#endif // SENSOR_FIFO_LEN
+
+    status = timer_set_periodic_callback(SENSOR_SAMPLING_PERIOD, sensor_sample_due);
+    RETURN_ON_ERROR(status, status);
+
+    g_sensor_sampling = true;
+
+    return STATUS_OK;
+}
+
+status_t sensor_set_stride(const size_t stride)
+{
+    if (0 == stride || stride > SENSOR_BUFFER_LEN)
+    {
+        return SENSOR_STATUS_INV_ARG;
+    }
+
+    g_sensor_stride = stride;
 
     return STATUS_OK;
 }
@@ -50,50 +374,79 @@ status_t sensor_get_data_size(size_t *data_size)
 status_t sensor_read_data_into_buffer()
 {
     status_t status = STATUS_OK;
-    sensor_data_t sensor_data = {0};
 
-    LOG_DEBUG("Reading sensor data into buffer. Buffer idx: %d", g_sensor_data_buffer_idx);
+    if (g_sensor_sampling)
+    {
+        // the timer interrupt only queues the samples, so they are read here
+        if (g_sensor_sampling_ticks != g_sensor_sampling_ticks_read)
+        {
+            status = sensor_sample();
+            RETURN_ON_ERROR(status, status);
+        }
 
-    status_t (*read_data_function)(sensor_data_t *) = SENSOR_READ_DATA_FUN;
+        return g_sensor_new_samples >= g_sensor_stride ? STATUS_OK : SENSOR_STATUS_NO_DATA;
+    }
+
+    LOG_DEBUG("Reading sensor data into buffer. Buffer idx: %d", g_sensor_data_buffer_idx);
 
     register uint32_t timer;
 
     do
     {
         CSR_READ(timer, CSR_TIME);
-    } while (timer - g_sensor_last_read_time < (int)(SENSOR_READ_INTERVAL * TIMER_CLOCK_FREQ));
+    } while (timer - g_sensor_last_read_time < g_sensor_read_interval);
     g_sensor_last_read_time = timer;
 
-    // read data
-    status = read_data_function(&sensor_data);
+    status = read_sample();
     RETURN_ON_ERROR(status, status);
+    ++g_sensor_new_samples;
 
-    // write data to the buffer
-    g_sensor_data_buffer[g_sensor_data_buffer_idx] = sensor_data;
+    return g_sensor_new_samples >= g_sensor_stride ? STATUS_OK : SENSOR_STATUS_NO_DATA;
+}
 
-    // increment buffer index
-    ++g_sensor_data_buffer_idx;
-    g_sensor_data_buffer_idx %= SENSOR_BUFFER_LEN;
+status_t sensor_get_next_read_time(uint32_t *time)
+{
+    VALIDATE_POINTER(time, SENSOR_STATUS_INV_PTR);
 
-    return status;
+    *time = g_sensor_last_read_time;
+    if (!g_sensor_sampling)
+    {
+        *time += g_sensor_read_interval;
+    }
+    // due samples and enough new samples can be read right away
+    else if (g_sensor_sampling_ticks == g_sensor_sampling_ticks_read && g_sensor_new_samples < g_sensor_stride)
+    {
+        *time += SENSOR_SAMPLING_PERIOD;
+    }
+
+    return STATUS_OK;
 }
 
 status_t sensor_get_buffered_data(size_t output_size, uint8_t *output)
 {
     VALIDATE_POINTER(output, SENSOR_STATUS_INV_PTR);
 
-    if (SENSOR_BUFFER_LEN * sizeof(sensor_data_t) != output_size)
+    if (SENSOR_BUFFER_LEN * get_sample_size() != output_size)
     {
         return SENSOR_STATUS_INV_ARG;
     }
 
-    // as we don't shift buffer during read we need to copy the sensor data so that the indices of buffer are mapped
-    // like [0, ..., len - 1] -> [g_sensor_data_buffer_idx, ..., len - 1, 0, ..., g_sensor_data_buffer_idx - 1]
-    memcpy(output, &g_sensor_data_buffer[g_sensor_data_buffer_idx], SENSOR_BUFFER_LEN - g_sensor_data_buffer_idx);
-    if (g_sensor_data_buffer_idx > 0)
-    {
-        memcpy(&output[g_sensor_data_buffer_idx], g_sensor_data_buffer, g_sensor_data_buffer_idx);
-    }
+    memcpy(output, get_window(), output_size);
+    g_sensor_new_samples = 0;
 
     return STATUS_OK;
-}
\ No newline at end of file
+}
+
+status_t sensor_consume_buffered_data(sensor_data_consumer_t consumer)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(consumer, SENSOR_STATUS_INV_PTR);
+
+    // the buffer is written only from the main loop, so the window does not change while it is consumed
+    status = consumer(get_window(), SENSOR_BUFFER_LEN * get_sample_size());
+    // the window is taken also if the consumer skips it or fails, so that it is not passed again
+    g_sensor_new_samples = 0;
+
+    return status;
+}
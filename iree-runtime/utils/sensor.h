@@ -14,6 +14,7 @@
 #endif // !(defined(__UNIT_TEST__) || defined(__CLANG_TIDY__))
 
 #include "i2c.h"
+#include "timer.h"
 
 #if defined(__UNIT_TEST__)
 #include "mocks/sensor_mock.h"
@@ -35,7 +36,17 @@
 #define SENSOR_BUFFER_LEN SENSOR_MOCK_BUFFER_LEN
 #define SENSOR_READ_INTERVAL SENSOR_MOCK_READ_INTERVAL
 typedef sensor_mock_data_t sensor_data_t;
+typedef sensor_mock_raw_data_t sensor_raw_data_t;
 #define SENSOR_READ_DATA_FUN sensor_mock_read_data
+#define SENSOR_READ_RAW_DATA_FUN sensor_mock_read_raw_data
+#define SENSOR_FIFO_LEN SENSOR_MOCK_FIFO_LEN
+#define SENSOR_FIFO_BURST_LEN SENSOR_MOCK_FIFO_BURST_LEN
+#define SENSOR_ENABLE_FIFO_FUN sensor_mock_enable_fifo
+#define SENSOR_READ_FIFO_FUN sensor_mock_read_fifo
+#define SENSOR_READ_RAW_FIFO_FUN sensor_mock_read_raw_fifo
+#define SENSOR_VALIDATE_CONFIG_FUN sensor_mock_validate_config
+#define SENSOR_SET_DATA_RATE_FUN sensor_mock_set_data_rate
+#define SENSOR_SET_RANGE_FUN sensor_mock_set_range
 
 #elif defined(I2C_ADXL345) // adxl345 accelerometer
 
@@ -44,19 +55,55 @@ typedef sensor_mock_data_t sensor_data_t;
 #define SENSOR_BUFFER_LEN ADXL345_BUFFER_LEN
 #define SENSOR_READ_INTERVAL ADXL345_READ_INTERVAL
 typedef adxl345_data_t sensor_data_t;
+typedef adxl345_raw_data_t sensor_raw_data_t;
 #define SENSOR_READ_DATA_FUN adxl345_read_data
+#define SENSOR_READ_RAW_DATA_FUN adxl345_read_raw_data
+#define SENSOR_FIFO_LEN ADXL345_FIFO_LEN
+#define SENSOR_FIFO_BURST_LEN ADXL345_FIFO_BURST_LEN
+#define SENSOR_ENABLE_FIFO_FUN adxl345_enable_fifo
+#define SENSOR_READ_FIFO_FUN adxl345_read_fifo
+#define SENSOR_READ_RAW_FIFO_FUN adxl345_read_raw_fifo
+#define SENSOR_VALIDATE_CONFIG_FUN adxl345_validate_config
+#define SENSOR_SET_DATA_RATE_FUN adxl345_set_data_rate
+#define SENSOR_SET_RANGE_FUN adxl345_set_range
 
 #endif
 
 /**
  * Sensor custom error codes
  */
-#define SENSOR_STATUSES(STATUS)      \
-    STATUS(SENSOR_STATUS_INV_SENSOR) \
-    STATUS(SENSOR_STATUS_NO_SENSOR_AVAILABLE)
+#define SENSOR_STATUSES(STATUS)               \
+    STATUS(SENSOR_STATUS_INV_SENSOR)          \
+    STATUS(SENSOR_STATUS_NO_SENSOR_AVAILABLE) \
+    STATUS(SENSOR_STATUS_NO_DATA)
 
 GENERATE_MODULE_STATUSES(SENSOR);
 
+/**
+ * Formats of the buffered sensor samples
+ */
+typedef enum
+{
+    SENSOR_SAMPLE_FORMAT_FLOAT = 0, /* sensor_data_t, channels scaled to physical units */
+    SENSOR_SAMPLE_FORMAT_RAW = 1,   /* sensor_raw_data_t, int16 channels as read from the sensor */
+    NUM_SENSOR_SAMPLE_FORMATS
+} SENSOR_SAMPLE_FORMAT;
+
+/**
+ * Sensor data ring buffer, it holds samples in the current sample format. The format is chosen at runtime, so the
+ * buffer is always sized for float samples and raw samples use only half of it
+ */
+typedef union
+{
+    sensor_data_t data[2 * SENSOR_BUFFER_LEN];
+    sensor_raw_data_t raw_data[2 * SENSOR_BUFFER_LEN];
+} sensor_buffer_t;
+
+/**
+ * Type of function that consumes window of the buffered sensor data
+ */
+typedef status_t (*sensor_data_consumer_t)(const uint8_t *data, const size_t data_size);
+
 /**
  * Retrieves device ID from the sensor
  *
@@ -67,7 +114,7 @@ GENERATE_MODULE_STATUSES(SENSOR);
 status_t sensor_get_device_id(uint8_t *device_id);
 
 /**
- * Retrieves single data sample size
+ * Retrieves single data sample size in the current sample format
  *
  * @param data_size single data sample size
  *
@@ -76,12 +123,72 @@ status_t sensor_get_device_id(uint8_t *device_id);
 status_t sensor_get_data_size(size_t *data_size);
 
 /**
- * Reads data from the sensor into buffer
+ * Sets format of the buffered samples. Raw samples are half the size of the float ones and skip the conversion, so
+ * they suit int16 models. Changing the format discards the buffered samples.
+ *
+ * Two limits apply. The ring buffer stays sized for float samples, so the raw format halves the window passed to the
+ * model, but not the memory of the ring buffer. There is also no int8 format, as the sensor data is wider than 8 bits:
+ * int8 models take float samples and depend on the preprocessing stage to quantize them
+ *
+ * @param format format of the samples
+ *
+ * @returns status of the sensor
+ */
+status_t sensor_set_sample_format(const SENSOR_SAMPLE_FORMAT format);
+
+/**
+ * Sets output data rate and measurement range of the sensor. Both values are validated before any of them is written.
+ * The read interval, as well as the sampling period if the sensor is sampled periodically, follows the data rate
+ * applied by the sensor, which may differ slightly from the requested one
+ *
+ * @param data_rate output data rate in Hz
+ * @param range measurement range, in units specific to the sensor
+ *
+ * @returns status of the sensor
+ */
+status_t sensor_configure(const float data_rate, const uint32_t range);
+
+/**
+ * Starts sampling the sensor every read interval (SENSOR_READ_INTERVAL by default). The timer interrupt only counts the
+ * elapsed sampling periods and sensor_read_data_into_buffer reads their samples into the sensor buffer from the main
+ * loop. If the sensor has FIFO, the samples accumulate in it at the sensor data rate and are read in bursts of
+ * SENSOR_FIFO_BURST_LEN, so that they are not lost while the main loop is busy. Without FIFO, the samples of the
+ * periods that elapsed while the main loop was busy are read back to back once it gets to them, so their count follows
+ * the read interval, but they are taken later than due. Timer has to be initialized and its interrupt enabled
+ *
+ * @returns status of the sensor
+ */
+status_t sensor_start_sampling();
+
+/**
+ * Sets number of new samples after which the buffered data is reported as ready, so that the consumer of the data
+ * skips the windows that overlap the most
+ *
+ * @param stride number of new samples, from 1 up to SENSOR_BUFFER_LEN
+ *
+ * @returns status of the sensor
+ */
+status_t sensor_set_stride(const size_t stride);
+
+/**
+ * Reads data from the sensor into buffer. If the sensor is sampled periodically, it reads only the samples of the
+ * sampling periods counted by the timer interrupt. In both cases it returns SENSOR_STATUS_NO_DATA until stride new
+ * samples are stored since the buffered data was last taken with sensor_get_buffered_data or
+ * sensor_consume_buffered_data
  *
  * @returns status of the sensor
  */
 status_t sensor_read_data_into_buffer();
 
+/**
+ * Retrieves time at which the next sensor read is due. sensor_read_data_into_buffer called earlier waits for that time
+ *
+ * @param time time of the next read in timer ticks
+ *
+ * @returns status of the sensor
+ */
+status_t sensor_get_next_read_time(uint32_t *time);
+
 /**
  * Writes buffered sensor data into provided buffer
  *
@@ -92,4 +199,16 @@ status_t sensor_read_data_into_buffer();
  */
 status_t sensor_get_buffered_data(size_t output_size, uint8_t *output);
 
+/**
+ * Passes window of the buffered sensor data to the consumer straight from the sensor buffer, without copying it. The
+ * window contains the last SENSOR_BUFFER_LEN samples, from the oldest one. The consumer runs with interrupts enabled,
+ * as the samples are stored only by sensor_read_data_into_buffer from the main loop. The samples are marked as
+ * consumed regardless of the consumer status
+ *
+ * @param consumer function that consumes the window, e.g. loads it into the model input
+ *
+ * @returns status of the sensor or error status of the consumer
+ */
+status_t sensor_consume_buffered_data(sensor_data_consumer_t consumer);
+
 #endif // IREE_RUNTIME_UTILS_SENSOR_H_
@@ -10,12 +10,110 @@
 
 GENERATE_MODULE_STATUSES_STR(INPUT_READER);
 
+/**
+ * Minimum variance of any sensor channel over the window for which the model is run, 0 if the activity gate is disabled
+ */
+ut_static float g_activity_threshold = 0.0F;
+/**
+ * Format of the sensor samples, raw samples are used for models with int16 input
+ */
+ut_static SENSOR_SAMPLE_FORMAT g_sample_format = SENSOR_SAMPLE_FORMAT_FLOAT;
+
+/**
+ * Retrieves value of the sensor sample channel
+ *
+ * @param channel pointer to the channel of the sample
+ *
+ * @returns value of the channel
+ */
+static float get_channel_value(const uint8_t *channel)
+{
+    if (SENSOR_SAMPLE_FORMAT_RAW == g_sample_format)
+    {
+        int16_t raw_value = 0;
+        memcpy(&raw_value, channel, sizeof(int16_t));
+        return (float)raw_value;
+    }
+
+    float value = 0.0F;
+    memcpy(&value, channel, sizeof(float));
+    return value;
+}
+
+/**
+ * Checks if there is activity in the window of sensor data, i.e. if variance of any of its channels exceeds the
+ * activity threshold. Samples are expected to consist of float or int16 channels, depending on the sample format
+ *
+ * @param window window of sensor data
+ * @param window_size size of the window
+ *
+ * @returns true if there is activity in the window
+ */
+static bool is_window_active(const uint8_t *window, const size_t window_size)
+{
+    const size_t sample_size = window_size / SENSOR_BUFFER_LEN;
+    const size_t channel_size = SENSOR_SAMPLE_FORMAT_RAW == g_sample_format ? sizeof(int16_t) : sizeof(float);
+
+    for (size_t channel_offset = 0; channel_offset + channel_size <= sample_size; channel_offset += channel_size)
+    {
+        float sum = 0.0F;
+        float sum_sq = 0.0F;
+
+        // values are shifted by the first one, so that the variance does not get lost in the offset (e.g. gravity)
+        const float shift = get_channel_value(window + channel_offset);
+        for (size_t i = 0; i < SENSOR_BUFFER_LEN; ++i)
+        {
+            float value = get_channel_value(window + i * sample_size + channel_offset) - shift;
+            sum += value;
+            sum_sq += value * value;
+        }
+
+        float mean = sum / SENSOR_BUFFER_LEN;
+        if (sum_sq / SENSOR_BUFFER_LEN - mean * mean > g_activity_threshold)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Loads window of sensor data into model input if there is activity in it. It is the consumer of the sensor buffer,
+ * which runs with interrupts enabled, so the variance pass of the activity gate does not delay interrupt handling
+ *
+ * @param window window of sensor data
+ * @param window_size size of the window
+ *
+ * @returns INPUT_READER_NO_READ if the window is skipped, error status of the model otherwise
+ */
+static status_t load_active_window(const uint8_t *window, const size_t window_size)
+{
+    if (g_activity_threshold > 0.0F && !is_window_active(window, window_size))
+    {
+        LOG_DEBUG("No activity in the window, skipping inference");
+        return INPUT_READER_NO_READ;
+    }
+
+    return load_model_input(window, window_size);
+}
+
 status_t read_input()
 {
     status_t status = STATUS_OK;
     size_t sensor_data_size = 0;
     size_t model_input_size = 0;
-    uint8_t *sensor_data = NULL;
+    iree_hal_element_type_t element_type = IREE_HAL_ELEMENT_TYPE_FLOAT_32;
+
+    // int16 models take raw sensor samples, which skips their conversion to float and halves the window
+    status = get_model_input_element_type(&element_type);
+    RETURN_ON_ERROR(status, status);
+
+    SENSOR_SAMPLE_FORMAT sample_format =
+        IREE_HAL_ELEMENT_TYPE_INT_16 == element_type ? SENSOR_SAMPLE_FORMAT_RAW : SENSOR_SAMPLE_FORMAT_FLOAT;
+    status = sensor_set_sample_format(sample_format);
+    RETURN_ON_ERROR(status, status);
+    g_sample_format = sample_format;
 
     status = sensor_get_data_size(&sensor_data_size);
     RETURN_ON_ERROR(status, status);
@@ -28,29 +126,36 @@ status_t read_input()
         return INPUT_READER_STATUS_INV_ARG;
     }
 
-    do
+    status = sensor_read_data_into_buffer();
+    // no new samples since the last read
+    if (SENSOR_STATUS_NO_DATA == status)
     {
-        status = sensor_read_data_into_buffer();
-        BREAK_ON_ERROR(status);
+        return INPUT_READER_NO_READ;
+    }
+    RETURN_ON_ERROR(status, status);
 
-        sensor_data = malloc(model_input_size);
-        if (!IS_VALID_POINTER(sensor_data))
-        {
-            status = INPUT_READER_STATUS_INV_PTR;
-            break;
-        }
+    // window is written straight from the sensor buffer into the model input buffer, unless there is no activity in it
+    return sensor_consume_buffered_data(load_active_window);
+}
 
-        status = sensor_get_buffered_data(model_input_size, sensor_data);
-        BREAK_ON_ERROR(status);
+status_t get_next_input_time(uint32_t *time)
+{
+    VALIDATE_POINTER(time, INPUT_READER_STATUS_INV_PTR);
+
+    return sensor_get_next_read_time(time);
+}
 
-        status = load_model_input((uint8_t *)sensor_data, model_input_size);
-        BREAK_ON_ERROR(status);
-    } while (0);
+status_t set_input_stride(const uint32_t stride) { return sensor_set_stride(stride); }
 
-    if (IS_VALID_POINTER(sensor_data))
+status_t set_input_activity_threshold(const float threshold)
+{
+    // negation catches NaN as well
+    if (!(threshold >= 0.0F))
     {
-        free(sensor_data);
+        return INPUT_READER_STATUS_INV_ARG;
     }
 
-    return status;
+    g_activity_threshold = threshold;
+
+    return STATUS_OK;
 }
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "timer.h"
+
+GENERATE_MODULE_STATUSES_STR(TIMER);
+
+ut_static clint_timer_t g_timer = {.initialized = false};
+
+/**
+ * Reads 64-bit mtime register. The high word is read twice to detect overflow of the low word between reads
+ *
+ * @returns value of the mtime register
+ */
+static uint64_t read_mtime()
+{
+    uint32_t hi = 0;
+    uint32_t lo = 0;
+
+    do
+    {
+        hi = g_timer.registers->MTIME_HI;
+        lo = g_timer.registers->MTIME_LO;
+    } while (hi != g_timer.registers->MTIME_HI);
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * Sets compare register to the earlier of the alarm and the periodic callback time. It has to be called with the
+ * interrupts locked
+ */
+static void update_mtimecmp()
+{
+    uint64_t mtimecmp = g_timer.alarm_time < g_timer.periodic_time ? g_timer.alarm_time : g_timer.periodic_time;
+
+    // disarm first, so that the intermediate compare value does not trigger the interrupt
+    g_timer.registers->MTIMECMP_HI = MTIMECMP_DISABLED;
+    g_timer.registers->MTIMECMP_LO = (uint32_t)mtimecmp;
+    g_timer.registers->MTIMECMP_HI = (uint32_t)(mtimecmp >> 32);
+}
+
+status_t timer_init()
+{
+    g_timer.registers = (clint_registers_t *)CLINT_ADDRESS;
+    g_timer.alarm_time = TIMER_DISABLED;
+    g_timer.periodic_time = TIMER_DISABLED;
+    g_timer.period = 0;
+    g_timer.periodic_callback = NULL;
+    update_mtimecmp();
+    g_timer.initialized = true;
+
+    return STATUS_OK;
+}
+
+status_t timer_set_alarm(const uint32_t time)
+{
+    if (!g_timer.initialized)
+    {
+        return TIMER_STATUS_UNINIT;
+    }
+
+    uint32_t irq_state = interrupts_lock();
+
+    uint64_t mtime = read_mtime();
+    // time CSR holds the low word of mtime, so the alarm is set relative to the current time
+    int32_t delta = (int32_t)(time - (uint32_t)mtime);
+    g_timer.alarm_time = delta > 0 ? mtime + (uint32_t)delta : mtime;
+    update_mtimecmp();
+
+    interrupts_unlock(irq_state);
+
+    return STATUS_OK;
+}
+
+status_t timer_cancel_alarm()
+{
+    if (!g_timer.initialized)
+    {
+        return TIMER_STATUS_UNINIT;
+    }
+
+    uint32_t irq_state = interrupts_lock();
+
+    g_timer.alarm_time = TIMER_DISABLED;
+    update_mtimecmp();
+
+    interrupts_unlock(irq_state);
+
+    return STATUS_OK;
+}
+
+status_t timer_set_periodic_callback(const uint32_t period, timer_callback_t callback)
+{
+    if (!g_timer.initialized)
+    {
+        return TIMER_STATUS_UNINIT;
+    }
+    if (IS_VALID_POINTER(callback) && 0 == period)
+    {
+        return TIMER_STATUS_INV_ARG;
+    }
+
+    uint32_t irq_state = interrupts_lock();
+
+    g_timer.periodic_callback = callback;
+    g_timer.period = period;
+    g_timer.periodic_time = IS_VALID_POINTER(callback) ? read_mtime() + period : TIMER_DISABLED;
+    update_mtimecmp();
+
+    interrupts_unlock(irq_state);
+
+    return STATUS_OK;
+}
+
+void timer_irq_handler()
+{
+    if (!g_timer.initialized)
+    {
+        return;
+    }
+
+    uint64_t mtime = read_mtime();
+
+    if (IS_VALID_POINTER(g_timer.periodic_callback) && mtime >= g_timer.periodic_time)
+    {
+        g_timer.periodic_callback();
+        // stay on the grid, skipping the missed periods, unless the callback stopped the periodic calls
+        while (IS_VALID_POINTER(g_timer.periodic_callback) && mtime >= g_timer.periodic_time)
+        {
+            g_timer.periodic_time += g_timer.period;
+        }
+    }
+    if (mtime >= g_timer.alarm_time)
+    {
+        g_timer.alarm_time = TIMER_DISABLED;
+    }
+    update_mtimecmp();
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IREE_RUNTIME_UTILS_TIMER_H_
+#define IREE_RUNTIME_UTILS_TIMER_H_
+
+#include "interrupts.h"
+#include "utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Timer custom error codes
+ */
+#define TIMER_STATUSES(STATUS)
+
+GENERATE_MODULE_STATUSES(TIMER);
+
+/**
+ * A struct that contains CLINT registers used by the timer
+ */
+typedef volatile struct __attribute__((packed, aligned(4)))
+{
+    uint32_t MSIP;               /* 0x0 Machine software interrupt pending register */
+    uint32_t _reserved0[0xFFF];  /* 0x4 - 0x3FFC reserved */
+    uint32_t MTIMECMP_LO;        /* 0x4000 Machine timer compare register (low word) */
+    uint32_t MTIMECMP_HI;        /* 0x4004 Machine timer compare register (high word) */
+    uint32_t _reserved1[0x1FFC]; /* 0x4008 - 0xBFF4 reserved */
+    uint32_t MTIME_LO;           /* 0xBFF8 Machine timer register (low word) */
+    uint32_t MTIME_HI;           /* 0xBFFC Machine timer register (high word) */
+} clint_registers_t;
+
+/**
+ * Type of function called periodically from the timer interrupt handler
+ */
+typedef void (*timer_callback_t)();
+
+/**
+ * A struct that contains timer informations. Alarm and periodic callback share the compare register, which is set to
+ * the earlier of them. Times are absolute mtime values, TIMER_DISABLED if not used
+ */
+typedef struct
+{
+    clint_registers_t *registers;
+    bool initialized;
+    uint64_t alarm_time;
+    uint64_t periodic_time;
+    uint32_t period;
+    timer_callback_t periodic_callback;
+} clint_timer_t;
+
+#ifndef __UNIT_TEST__
+#define CLINT_ADDRESS (0x02000000) /* address of CLINT registers */
+#else                              // __UNIT_TEST__
+extern clint_registers_t g_mock_clint_registers;
+#define CLINT_ADDRESS (&g_mock_clint_registers)
+#endif // __UNIT_TEST__
+
+#define MTIMECMP_DISABLED (0xFFFFFFFFu)          /* value of both mtimecmp words that never triggers the interrupt */
+#define TIMER_DISABLED (0xFFFFFFFFFFFFFFFFull) /* mtimecmp value that never triggers the interrupt */
+
+/* checks if given time in timer ticks is reached, handles the timer overflow */
+#define TIME_REACHED(time, now) ((int32_t)((uint32_t)(time) - (uint32_t)(now)) <= 0)
+
+/**
+ * Initializes timer and disarms the alarm. The timer interrupt has to be handled with timer_irq_handler
+ *
+ * @returns error status of timer initialization
+ */
+status_t timer_init();
+/**
+ * Arms alarm that triggers the machine timer interrupt at given time. Alarm set in the past triggers immediately
+ *
+ * @param time time in timer ticks, as read from the time CSR
+ *
+ * @returns error status of setting alarm
+ */
+status_t timer_set_alarm(const uint32_t time);
+/**
+ * Disarms the alarm
+ *
+ * @returns error status of cancelling alarm
+ */
+status_t timer_cancel_alarm();
+/**
+ * Sets callback that is called from the timer interrupt every given period. The calls are kept on the grid of the
+ * first call, periods missed due to the interrupts being locked are skipped
+ *
+ * @param period period in timer ticks
+ * @param callback function to be called or NULL to stop the periodic calls
+ *
+ * @returns error status of setting callback
+ */
+status_t timer_set_periodic_callback(const uint32_t period, timer_callback_t callback);
+/**
+ * Handles machine timer interrupt. It calls the periodic callback if it is due and disarms the expired alarm
+ */
+void timer_irq_handler();
+
+#endif // IREE_RUNTIME_UTILS_TIMER_H_
@@ -10,6 +10,196 @@ GENERATE_MODULE_STATUSES_STR(UART);
 
 ut_static uart_t g_uart = {.initialized = false};
 
+static uint8_t g_uart_rx_buffer_data[UART_RX_BUFFER_SIZE];
+static uint8_t g_uart_tx_buffer_data[UART_TX_BUFFER_SIZE];
+
+/**
+ * Returns number of bytes stored in the ring buffer
+ *
+ * @param ring_buffer ring buffer
+ *
+ * @returns number of stored bytes
+ */
+static inline uint32_t ring_buffer_count(const uart_ring_buffer_t *ring_buffer)
+{
+    return ring_buffer->head - ring_buffer->tail;
+}
+
+/**
+ * Appends byte to the ring buffer. Only the producer of the ring buffer can call it
+ *
+ * @param ring_buffer ring buffer
+ * @param c byte to be appended
+ *
+ * @returns true if byte was appended, false if the ring buffer is full
+ */
+static inline bool ring_buffer_push(uart_ring_buffer_t *ring_buffer, const uint8_t c)
+{
+    uint32_t head = ring_buffer->head;
+    if (head - ring_buffer->tail >= ring_buffer->size)
+    {
+        return false;
+    }
+    ring_buffer->data[head & (ring_buffer->size - 1)] = c;
+    ring_buffer->head = head + 1;
+    return true;
+}
+
+/**
+ * Takes byte from the ring buffer. Only the consumer of the ring buffer can call it
+ *
+ * @param ring_buffer ring buffer
+ * @param c taken byte
+ *
+ * @returns true if byte was taken, false if the ring buffer is empty
+ */
+static inline bool ring_buffer_pop(uart_ring_buffer_t *ring_buffer, uint8_t *c)
+{
+    uint32_t tail = ring_buffer->tail;
+    if (ring_buffer->head == tail)
+    {
+        return false;
+    }
+    *c = ring_buffer->data[tail & (ring_buffer->size - 1)];
+    ring_buffer->tail = tail + 1;
+    return true;
+}
+
+/**
+ * Returns number of buffers queued with uart_write_async
+ *
+ * @returns number of queued buffers
+ */
+static inline uint32_t tx_queue_count() { return g_uart.tx_queue_head - g_uart.tx_queue_tail; }
+
+/**
+ * Moves bytes from the TX ring buffer and then from the queued buffers to the transmit FIFO and enables TX interrupt if
+ * any bytes are left. UART interrupts are masked meanwhile, so it can be called both from the handler and the main loop
+ */
+static void uart_tx_kick()
+{
+    uint32_t imsc = g_uart.registers->IMSC;
+    g_uart.registers->IMSC = 0;
+
+    for (int i = 0; i < UART_FIFO_DEPTH && !(g_uart.registers->FR & FR_TXFF); ++i)
+    {
+        uint8_t c = 0;
+        if (ring_buffer_pop(&g_uart.tx_buffer, &c))
+        {
+            g_uart.registers->DR = c;
+            continue;
+        }
+        if (0 == tx_queue_count())
+        {
+            break;
+        }
+
+        uart_tx_descriptor_t *descriptor = &g_uart.tx_queue[g_uart.tx_queue_tail % UART_TX_QUEUE_LENGTH];
+        g_uart.registers->DR = descriptor->data[g_uart.tx_queue_offset++];
+        if (g_uart.tx_queue_offset == descriptor->data_length)
+        {
+            g_uart.tx_queue_offset = 0;
+            g_uart.tx_queue_tail++;
+            if (IS_VALID_POINTER(descriptor->callback))
+            {
+                descriptor->callback(descriptor->data, descriptor->data_length);
+            }
+        }
+    }
+
+    if (ring_buffer_count(&g_uart.tx_buffer) > 0 || tx_queue_count() > 0)
+    {
+        imsc |= INT_TX;
+    }
+    else
+    {
+        imsc &= ~INT_TX;
+    }
+    g_uart.registers->IMSC = imsc;
+}
+
+/**
+ * Writes baudrate divisor registers. UART has to be disabled and the divisor is latched by the next LCRH write
+ *
+ * @param baudrate baudrate to be set
+ */
+static void write_baudrate_divisor(const uint32_t baudrate)
+{
+    double intpart = 0;
+    double fractpart = 0;
+    double baudrate_divisor = (double)REF_CLOCK / (16U * baudrate);
+    fractpart = modf(baudrate_divisor, &intpart);
+
+    g_uart.registers->IBRD = (uint16_t)intpart;
+    g_uart.registers->FBRD = (uint8_t)lround((fractpart * 64U) + 0.5);
+}
+
+/**
+ * Reads bytes that are already received in a single burst. The receive FIFO (or the RX ring buffer in
+ * interrupt-driven mode) is drained in a tight loop. Error flags of the read characters are accumulated and checked
+ * once per burst
+ *
+ * @param data buffer for results
+ * @param data_length length of the buffer
+ * @param read number of bytes read
+ *
+ * @returns status of read action
+ */
+static status_t uart_read_burst(uint8_t *data, const size_t data_length, size_t *read)
+{
+    size_t i = 0;
+
+    if (g_uart.irq_enabled)
+    {
+        uart_ring_buffer_t *rx_buffer = &g_uart.rx_buffer;
+        uint32_t tail = rx_buffer->tail;
+        size_t count = ring_buffer_count(rx_buffer);
+        if (count > data_length)
+        {
+            count = data_length;
+        }
+
+        // received bytes may wrap around the end of the ring buffer
+        size_t offset = tail & (rx_buffer->size - 1);
+        size_t first_chunk = rx_buffer->size - offset;
+        if (first_chunk > count)
+        {
+            first_chunk = count;
+        }
+        memcpy(data, &rx_buffer->data[offset], first_chunk);
+        memcpy(&data[first_chunk], rx_buffer->data, count - first_chunk);
+        rx_buffer->tail = tail + count;
+
+        *read = count;
+
+        if (g_uart.rx_error)
+        {
+            g_uart.rx_error = false;
+            return UART_STATUS_RECV_ERROR;
+        }
+        return STATUS_OK;
+    }
+
+    uart_registers_t *registers = g_uart.registers;
+    uint32_t dr_flags = 0;
+    while (i < data_length && !(registers->FR & FR_RXFE))
+    {
+        uint32_t dr = registers->DR;
+        data[i] = dr & DR_DATA_MASK;
+        dr_flags |= dr;
+        ++i;
+    }
+    *read = i;
+
+    // RSRECR reflects only the last read character, so errors are taken from the data register of each character
+    if (dr_flags & DR_ERR_MASK)
+    {
+        registers->RSRECR = RSRECR_ERR_MASK;
+        return UART_STATUS_RECV_ERROR;
+    }
+    return STATUS_OK;
+}
+
 status_t uart_init(const uart_config_t *config)
 {
     if (g_uart.initialized)
@@ -29,12 +219,10 @@ status_t uart_init(const uart_config_t *config)
     {
         return UART_STATUS_INV_ARG_STOP_BITS;
     }
-#define CHECK_UART(baudrate_value) ((baudrate_value) == config->baudrate) ||
-    if (!(BAUDRATE_VALUES(CHECK_UART) false))
+    if (STATUS_OK != uart_check_baudrate(config->baudrate))
     {
         return UART_STATUS_INV_ARG_BAUDRATE;
     }
-#undef CHECK_UART
 
     g_uart.registers->CR &= ~CR_UARTEN;
     while (g_uart.registers->FR & FR_BUSY)
@@ -42,13 +230,7 @@ status_t uart_init(const uart_config_t *config)
     }
     g_uart.registers->LCRH &= ~LCRH_FEN;
 
-    double intpart = 0;
-    double fractpart = 0;
-    double baudrate_divisor = (double)REF_CLOCK / (16U * config->baudrate);
-    fractpart = modf(baudrate_divisor, &intpart);
-
-    g_uart.registers->IBRD = (uint16_t)intpart;
-    g_uart.registers->FBRD = (uint8_t)lround((fractpart * 64U) + 0.5);
+    write_baudrate_divisor(config->baudrate);
 
     uint32_t lcrh = 0U;
 
@@ -96,6 +278,7 @@ status_t uart_init(const uart_config_t *config)
 
     g_uart.registers->CR |= CR_UARTEN;
 
+    g_uart.baudrate = config->baudrate;
     g_uart.initialized = true;
 
     return STATUS_OK;
@@ -107,6 +290,17 @@ status_t uart_putchar(const uint8_t c)
     {
         return UART_STATUS_UNINIT;
     }
+    if (g_uart.irq_enabled)
+    {
+        // queued buffers are sent first to keep the order of the data, TX FIFO is filled here as well so that full TX
+        // buffer does not block if interrupts are disabled
+        while (tx_queue_count() > 0 || !ring_buffer_push(&g_uart.tx_buffer, c))
+        {
+            uart_tx_kick();
+        }
+        uart_tx_kick();
+        return STATUS_OK;
+    }
     while (g_uart.registers->FR & FR_TXFF)
     {
     }
@@ -145,6 +339,19 @@ status_t uart_getchar(uint8_t *c)
     {
         return UART_STATUS_UNINIT;
     }
+    if (g_uart.irq_enabled)
+    {
+        if (g_uart.rx_error)
+        {
+            g_uart.rx_error = false;
+            return UART_STATUS_RECV_ERROR;
+        }
+        if (!ring_buffer_pop(&g_uart.rx_buffer, c))
+        {
+            return UART_STATUS_NO_DATA;
+        }
+        return STATUS_OK;
+    }
     if (g_uart.registers->FR & FR_RXFE)
     {
         return UART_STATUS_NO_DATA;
@@ -161,7 +368,7 @@ status_t uart_getchar(uint8_t *c)
 
 status_t uart_read(uint8_t *data, size_t data_length)
 {
-    int i = 0;
+    size_t i = 0;
     register uint32_t start_timer;
     register uint32_t end_timer;
 
@@ -175,23 +382,257 @@ status_t uart_read(uint8_t *data, size_t data_length)
     CSR_READ(start_timer, CSR_TIME);
     while (i < data_length)
     {
-        uint8_t c = 0;
-        status_t status = uart_getchar(&c);
-        CSR_READ(end_timer, CSR_TIME);
-        if (STATUS_OK == status)
+        size_t read = 0;
+        status_t status = uart_read_burst(&data[i], data_length - i, &read);
+        RETURN_ON_ERROR(status, status);
+
+        if (read > 0)
         {
+            // FIFO ran dry, timeout is counted from the end of the burst
+            i += read;
             CSR_READ(start_timer, CSR_TIME);
-            data[i] = c;
+            continue;
+        }
+        CSR_READ(end_timer, CSR_TIME);
+        if (end_timer - start_timer > (int)(UART_TIMEOUT_S * TIMER_CLOCK_FREQ))
+        {
+            return UART_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+status_t uart_write_nonblocking(const uint8_t *data, size_t data_length, size_t *written)
+{
+    VALIDATE_POINTER(data, UART_STATUS_INV_PTR);
+    VALIDATE_POINTER(written, UART_STATUS_INV_PTR);
+
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+
+    size_t i = 0;
+    if (g_uart.irq_enabled)
+    {
+        // bytes can be written only after the queued buffers to keep the order of the data
+        while (i < data_length && 0 == tx_queue_count() && ring_buffer_push(&g_uart.tx_buffer, data[i]))
+        {
             ++i;
         }
-        else if (UART_STATUS_RECV_ERROR == status)
+        uart_tx_kick();
+    }
+    else
+    {
+        while (i < data_length && !(g_uart.registers->FR & FR_TXFF))
         {
-            return UART_STATUS_RECV_ERROR;
+            g_uart.registers->DR = data[i];
+            ++i;
         }
-        else if (end_timer - start_timer > (int)(UART_TIMEOUT_S * TIMER_CLOCK_FREQ))
+    }
+    *written = i;
+
+    return STATUS_OK;
+}
+
+status_t uart_write_async(const uint8_t *data, size_t data_length, uart_write_callback_t callback)
+{
+    status_t status = STATUS_OK;
+
+    VALIDATE_POINTER(data, UART_STATUS_INV_PTR);
+
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+
+    if (!g_uart.irq_enabled || 0 == data_length)
+    {
+        status = uart_write(data, data_length);
+        RETURN_ON_ERROR(status, status);
+
+        if (IS_VALID_POINTER(callback))
         {
-            return UART_STATUS_TIMEOUT;
+            callback(data, data_length);
+        }
+        return STATUS_OK;
+    }
+
+    // wait for free descriptor
+    while (tx_queue_count() >= UART_TX_QUEUE_LENGTH)
+    {
+        uart_tx_kick();
+    }
+
+    uart_tx_descriptor_t *descriptor = &g_uart.tx_queue[g_uart.tx_queue_head % UART_TX_QUEUE_LENGTH];
+    descriptor->data = data;
+    descriptor->data_length = data_length;
+    descriptor->callback = callback;
+    g_uart.tx_queue_head++;
+
+    uart_tx_kick();
+
+    return STATUS_OK;
+}
+
+status_t uart_flush()
+{
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+
+    while (g_uart.irq_enabled && (ring_buffer_count(&g_uart.tx_buffer) > 0 || tx_queue_count() > 0))
+    {
+        uart_tx_kick();
+    }
+
+    return STATUS_OK;
+}
+
+bool uart_rx_pending()
+{
+    if (!g_uart.initialized)
+    {
+        return false;
+    }
+    if (g_uart.irq_enabled)
+    {
+        return ring_buffer_count(&g_uart.rx_buffer) > 0 || g_uart.rx_error;
+    }
+    return !(g_uart.registers->FR & FR_RXFE);
+}
+
+status_t uart_read_nonblocking(uint8_t *data, size_t data_length, size_t *read)
+{
+    VALIDATE_POINTER(data, UART_STATUS_INV_PTR);
+    VALIDATE_POINTER(read, UART_STATUS_INV_PTR);
+
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+
+    return uart_read_burst(data, data_length, read);
+}
+
+status_t uart_irq_enable()
+{
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+    if (g_uart.irq_enabled)
+    {
+        return STATUS_OK;
+    }
+
+    g_uart.rx_buffer = (uart_ring_buffer_t){.data = g_uart_rx_buffer_data, .size = UART_RX_BUFFER_SIZE};
+    g_uart.tx_buffer = (uart_ring_buffer_t){.data = g_uart_tx_buffer_data, .size = UART_TX_BUFFER_SIZE};
+    g_uart.rx_error = false;
+    g_uart.tx_queue_head = 0;
+    g_uart.tx_queue_tail = 0;
+    g_uart.tx_queue_offset = 0;
+
+    g_uart.registers->IMSC = 0;
+    g_uart.registers->IFLS = IFLS_TX_1_8 | IFLS_RX_1_2;
+    g_uart.registers->ICR = INT_ALL_MASK;
+
+    g_uart.irq_enabled = true;
+
+    // TX interrupt is enabled only when there is something to send
+    g_uart.registers->IMSC = INT_RX | INT_RT | INT_ERR_MASK;
+
+    return STATUS_OK;
+}
+
+void uart_irq_handler()
+{
+    if (!g_uart.irq_enabled)
+    {
+        return;
+    }
+
+    uint32_t mis = g_uart.registers->MIS;
+
+    // reading is bounded by FIFO depth so that the handler always returns
+    uint32_t dr_flags = 0;
+    for (int i = 0; i < UART_FIFO_DEPTH && !(g_uart.registers->FR & FR_RXFE); ++i)
+    {
+        uint32_t dr = g_uart.registers->DR;
+        dr_flags |= dr;
+        if (!ring_buffer_push(&g_uart.rx_buffer, dr & DR_DATA_MASK))
+        {
+            // RX buffer overflow
+            g_uart.rx_error = true;
         }
     }
+    // error flags of all characters of the burst are checked at once
+    if (dr_flags & DR_ERR_MASK)
+    {
+        g_uart.registers->RSRECR = RSRECR_ERR_MASK;
+        g_uart.rx_error = true;
+    }
+    g_uart.registers->ICR = mis & (INT_RX | INT_RT | INT_ERR_MASK);
+
+    if (mis & INT_TX)
+    {
+        uart_tx_kick();
+    }
+}
+
+status_t uart_check_baudrate(const uint32_t baudrate)
+{
+#define CHECK_UART(baudrate_value) ((baudrate_value) == baudrate) ||
+    if (!(BAUDRATE_VALUES(CHECK_UART) false))
+    {
+        return UART_STATUS_INV_ARG_BAUDRATE;
+    }
+#undef CHECK_UART
+    return STATUS_OK;
+}
+
+status_t uart_set_baudrate(const uint32_t baudrate)
+{
+    status_t status = STATUS_OK;
+
+    if (!g_uart.initialized)
+    {
+        return UART_STATUS_UNINIT;
+    }
+
+    status = uart_check_baudrate(baudrate);
+    RETURN_ON_ERROR(status, status);
+
+    // wait until pending transmission is done
+    uart_flush();
+    while (g_uart.registers->FR & FR_BUSY)
+    {
+    }
+    g_uart.registers->CR &= ~CR_UARTEN;
+
+    uint32_t lcrh = g_uart.registers->LCRH;
+
+    // disabling FIFO flushes it
+    g_uart.registers->LCRH = lcrh & ~LCRH_FEN;
+
+    write_baudrate_divisor(baudrate);
+
+    // restoring line control latches new divisor
+    g_uart.registers->LCRH = lcrh;
+
+    g_uart.registers->CR |= CR_UARTEN;
+
+    g_uart.baudrate = baudrate;
+
     return STATUS_OK;
 }
+
+uint32_t uart_get_baudrate()
+{
+    if (!g_uart.initialized)
+    {
+        return 0;
+    }
+    return g_uart.baudrate;
+}
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * Supported baudrate values
@@ -29,7 +30,11 @@
     BAUDRATE(19200U)              \
     BAUDRATE(38400U)              \
     BAUDRATE(57600U)              \
-    BAUDRATE(115200U)
+    BAUDRATE(115200U)             \
+    BAUDRATE(230400U)             \
+    BAUDRATE(460800U)             \
+    BAUDRATE(921600U)             \
+    BAUDRATE(1500000U)
 
 /**
  * UART custom error codes
@@ -58,8 +63,43 @@ typedef volatile struct __attribute__((packed, aligned(4)))
     uint32_t FBRD;          /* 0x28 Fractional baudrate register */
     uint32_t LCRH;          /* 0x2C Line control register */
     uint32_t CR;            /* 0x30 Control register */
+    uint32_t IFLS;          /* 0x34 Interrupt FIFO level select register */
+    uint32_t IMSC;          /* 0x38 Interrupt mask set/clear register */
+    const uint32_t RIS;     /* 0x3C Raw interrupt status register */
+    const uint32_t MIS;     /* 0x40 Masked interrupt status register */
+    uint32_t ICR;           /* 0x44 Interrupt clear register */
 } uart_registers_t;
 
+/**
+ * A struct that contains ring buffer used by interrupt-driven UART. Head and tail are free running indices, the size of
+ * the buffer has to be a power of two
+ */
+typedef struct
+{
+    uint8_t *data;
+    uint32_t size;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} uart_ring_buffer_t;
+
+/**
+ * Type of function called when the data queued with uart_write_async was moved to the transmit FIFO and the buffer can
+ * be reused. It may be called from the interrupt handler, so it must not write to UART
+ */
+typedef void (*uart_write_callback_t)(const uint8_t *, const size_t);
+
+/**
+ * A struct that describes buffer queued for transmission with uart_write_async
+ */
+typedef struct
+{
+    const uint8_t *data;
+    size_t data_length;
+    uart_write_callback_t callback;
+} uart_tx_descriptor_t;
+
+#define UART_TX_QUEUE_LENGTH (8u) /* number of buffers that can be queued with uart_write_async */
+
 /**
  * A struct that contains UART informations
  */
@@ -67,6 +107,15 @@ typedef struct
 {
     uart_registers_t *registers;
     bool initialized;
+    uint32_t baudrate;
+    bool irq_enabled;
+    volatile bool rx_error;
+    uart_ring_buffer_t rx_buffer;
+    uart_ring_buffer_t tx_buffer;
+    uart_tx_descriptor_t tx_queue[UART_TX_QUEUE_LENGTH];
+    volatile uint32_t tx_queue_head;
+    volatile uint32_t tx_queue_tail;
+    size_t tx_queue_offset;
 } uart_t;
 
 /**
@@ -82,6 +131,10 @@ typedef struct
 
 #define UART_TIMEOUT_S (0.005F) /* UART read timeout (5 ms) */
 
+#define UART_RX_BUFFER_SIZE (4096u) /* size of the RX ring buffer, has to be a power of two */
+#define UART_TX_BUFFER_SIZE (1024u) /* size of the TX ring buffer, has to be a power of two */
+#define UART_FIFO_DEPTH (32u)       /* depth of the PL011 FIFOs */
+
 #ifndef __UNIT_TEST__
 #define UART_ADDRESS (0x40000000) /* address of UART registers */
 #else                             // __UNIT_TEST_
@@ -91,6 +144,7 @@ extern uart_registers_t g_mock_uart_registers;
 #define REF_CLOCK (24000000u) /* UART reference clock (24 MHz) */
 
 #define DR_DATA_MASK (0xFFu) /* mask of the data register */
+#define DR_ERR_MASK (0xF00u) /* mask of the receive errors in the data register */
 
 #define FR_BUSY (1 << 3u) /* busy flag */
 #define FR_RXFE (1 << 4u) /* receive FIFO empty flag  */
@@ -110,6 +164,15 @@ extern uart_registers_t g_mock_uart_registers;
 #define LCRH_WLEN_7BITS (2u << 5u) /* 7 bit word length */
 #define LCRH_WLEN_8BITS (3u << 5u) /* 8 bit word length */
 
+#define IFLS_TX_1_8 (0u << 0u) /* TX interrupt when transmit FIFO becomes <= 1/8 full */
+#define IFLS_RX_1_2 (2u << 3u) /* RX interrupt when receive FIFO becomes >= 1/2 full */
+
+#define INT_RX (1 << 4u)          /* receive interrupt */
+#define INT_TX (1 << 5u)          /* transmit interrupt */
+#define INT_RT (1 << 6u)          /* receive timeout interrupt */
+#define INT_ERR_MASK (0xFu << 7u) /* framing, parity, break and overrun error interrupts */
+#define INT_ALL_MASK (0x7FFu)     /* all interrupts */
+
 /**
  * Writes single byte to UART
  *
@@ -144,5 +207,85 @@ status_t uart_getchar(uint8_t *c);
  * @returns status of read action
  */
 status_t uart_read(uint8_t *data, size_t data_length);
+/**
+ * Writes as many bytes as possible without waiting. In interrupt-driven mode the bytes are queued in the TX ring
+ * buffer, otherwise they are written to the transmit FIFO until it is full
+ *
+ * @param data buffer to be written
+ * @param data_length length of the buffer
+ * @param written number of bytes written
+ *
+ * @returns error status of write
+ */
+status_t uart_write_nonblocking(const uint8_t *data, size_t data_length, size_t *written);
+/**
+ * Queues buffer for transmission without copying it. In interrupt-driven mode the buffer is sent from the TX interrupt
+ * and the function returns immediately, unless the queue is full. The buffer must not be modified until the callback is
+ * called. In polling mode the buffer is written before the function returns
+ *
+ * @param data buffer to be written
+ * @param data_length length of the buffer
+ * @param callback function called when the buffer can be reused or NULL
+ *
+ * @returns error status of write
+ */
+status_t uart_write_async(const uint8_t *data, size_t data_length, uart_write_callback_t callback);
+/**
+ * Waits until all queued data is moved to the transmit FIFO
+ *
+ * @returns error status of flush
+ */
+status_t uart_flush();
+/**
+ * Reads bytes that are already received without waiting. In interrupt-driven mode the bytes are taken from the RX
+ * ring buffer, otherwise they are read from the receive FIFO
+ *
+ * @param data buffer for results
+ * @param data_length length of the buffer
+ * @param read number of bytes read
+ *
+ * @returns status of read action
+ */
+status_t uart_read_nonblocking(uint8_t *data, size_t data_length, size_t *read);
+/**
+ * Checks if there are received bytes (or receive error) waiting to be read
+ *
+ * @returns true if data can be read without waiting
+ */
+bool uart_rx_pending();
+/**
+ * Switches initialized UART to interrupt-driven mode. Received bytes are stored in the RX ring buffer and written bytes
+ * are sent from the TX ring buffer by uart_irq_handler, which has to be registered as the UART interrupt handler
+ *
+ * @returns error status of enabling interrupts
+ */
+status_t uart_irq_enable();
+/**
+ * Handles UART interrupt. Moves received bytes to the RX ring buffer and refills the transmit FIFO from the TX ring
+ * buffer
+ */
+void uart_irq_handler();
+/**
+ * Checks if given baudrate is supported
+ *
+ * @param baudrate baudrate to be checked
+ *
+ * @returns STATUS_OK if baudrate is supported, UART_STATUS_INV_ARG_BAUDRATE otherwise
+ */
+status_t uart_check_baudrate(const uint32_t baudrate);
+/**
+ * Changes baudrate of initialized UART. It waits until pending transmission is done, the receive FIFO is flushed
+ *
+ * @param baudrate new baudrate
+ *
+ * @returns error status of baudrate change
+ */
+status_t uart_set_baudrate(const uint32_t baudrate);
+/**
+ * Returns current UART baudrate
+ *
+ * @returns current baudrate or 0 if UART is not initialized
+ */
+uint32_t uart_get_baudrate();
 
 #endif // IREE_RUNTIME_UTILS_UART_H_
@@ -43,9 +43,17 @@
 /* CSRs addresses */
 #define CSR_CYCLE (0xC00)
 #define CSR_TIME (0xC01)
+#define CSR_INSTRET (0xC02)
+#define CSR_MSTATUS (0x300)
+#define CSR_MIE (0x304)
+#define CSR_MTVEC (0x305)
+#define CSR_MCAUSE (0x342)
 
 #ifndef __UNIT_TEST__
 #define CSR_READ(v, csr) __asm__ __volatile__("csrr %0, %1" : "=r"(v) : "n"(csr) : /* clobbers: none */);
+#define CSR_WRITE(csr, v) __asm__ __volatile__("csrw %0, %1" : /* outputs: none */ : "n"(csr), "r"(v) : "memory");
+#define CSR_SET(csr, v) __asm__ __volatile__("csrs %0, %1" : /* outputs: none */ : "n"(csr), "r"(v) : "memory");
+#define CSR_CLEAR(csr, v) __asm__ __volatile__("csrc %0, %1" : /* outputs: none */ : "n"(csr), "r"(v) : "memory");
 #else // __UNIT_TEST__
 #define CSR_READ(v, csr)                      \
     do                                        \
@@ -55,6 +63,24 @@
         (v) = g_mock_csr;                     \
         mock_csr_read_callback();             \
     } while (0);
+#define CSR_WRITE(csr, v)                               \
+    do                                                  \
+    {                                                   \
+        extern void mock_csr_write(uint32_t, uint32_t); \
+        mock_csr_write((csr), (uint32_t)(v));           \
+    } while (0);
+#define CSR_SET(csr, v)                               \
+    do                                                \
+    {                                                 \
+        extern void mock_csr_set(uint32_t, uint32_t); \
+        mock_csr_set((csr), (uint32_t)(v));           \
+    } while (0);
+#define CSR_CLEAR(csr, v)                               \
+    do                                                  \
+    {                                                   \
+        extern void mock_csr_clear(uint32_t, uint32_t); \
+        mock_csr_clear((csr), (uint32_t)(v));           \
+    } while (0);
 #endif // __UNIT_TEST__
 
 #define TIMER_CLOCK_FREQ (24000000u) /* 24 MHz */
@@ -116,7 +142,11 @@
     MODULE(IREE_WRAPPER)     \
     MODULE(PROTOCOL)         \
     MODULE(UART)             \
-    MODULE(INPUT_READER)
+    MODULE(INPUT_READER)     \
+    MODULE(INTERRUPTS)       \
+    MODULE(TIMER)            \
+    MODULE(PREPROCESSING)    \
+    MODULE(PROFILER)
 
 #define I2C_SENSORS_MODULES(MODULE) \
     MODULE(I2C)                     \
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IREE_RUNTIME_UNIT_TESTS_RISCV_VECTOR_H_
+#define IREE_RUNTIME_UNIT_TESTS_RISCV_VECTOR_H_
+
+/*
+ * Host emulation of the RISC-V vector intrinsics used by the runtime, so that the vector code paths can be checked
+ * against the scalar ones in unit tests. Each intrinsic follows the semantics of the corresponding instruction for the
+ * first vl elements.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Maximal number of 32-bit elements in a group of 8 vector registers. It is lower than on the target (128 for 512-bit
+ * vector registers), so that the tested blocks are processed in several strips
+ */
+#define RVV_MOCK_VLMAX_E32M8 (16)
+
+typedef struct
+{
+    float v[RVV_MOCK_VLMAX_E32M8];
+} vfloat32m8_t;
+
+typedef struct
+{
+    int16_t v[RVV_MOCK_VLMAX_E32M8];
+} vint16m4_t;
+
+typedef struct
+{
+    int8_t v[RVV_MOCK_VLMAX_E32M8];
+} vint8m2_t;
+
+static inline size_t __riscv_vsetvl_e32m8(size_t avl)
+{
+    return avl < RVV_MOCK_VLMAX_E32M8 ? avl : RVV_MOCK_VLMAX_E32M8;
+}
+
+static inline vfloat32m8_t __riscv_vle32_v_f32m8(const float *rs1, size_t vl)
+{
+    vfloat32m8_t vd = {0};
+    for (size_t i = 0; i < vl; ++i)
+    {
+        vd.v[i] = rs1[i];
+    }
+    return vd;
+}
+
+static inline void __riscv_vse32_v_f32m8(float *rs1, vfloat32m8_t vs3, size_t vl)
+{
+    for (size_t i = 0; i < vl; ++i)
+    {
+        rs1[i] = vs3.v[i];
+    }
+}
+
+static inline void __riscv_vse8_v_i8m2(int8_t *rs1, vint8m2_t vs3, size_t vl)
+{
+    for (size_t i = 0; i < vl; ++i)
+    {
+        rs1[i] = vs3.v[i];
+    }
+}
+
+/* vd * vs1 + vs2, fused */
+static inline vfloat32m8_t __riscv_vfmadd_vv_f32m8(vfloat32m8_t vd, vfloat32m8_t vs1, vfloat32m8_t vs2, size_t vl)
+{
+    for (size_t i = 0; i < vl; ++i)
+    {
+        vd.v[i] = fmaf(vd.v[i], vs1.v[i], vs2.v[i]);
+    }
+    return vd;
+}
+
+/* maximumNumber, i.e. NaN operand is ignored, as in fmaxf */
+static inline vfloat32m8_t __riscv_vfmax_vf_f32m8(vfloat32m8_t vs2, float rs1, size_t vl)
+{
+    for (size_t i = 0; i < vl; ++i)
+    {
+        vs2.v[i] = fmaxf(vs2.v[i], rs1);
+    }
+    return vs2;
+}
+
+/* minimumNumber, i.e. NaN operand is ignored, as in fminf */
+static inline vfloat32m8_t __riscv_vfmin_vf_f32m8(vfloat32m8_t vs2, float rs1, size_t vl)
+{
+    for (size_t i = 0; i < vl; ++i)
+    {
+        vs2.v[i] = fminf(vs2.v[i], rs1);
+    }
+    return vs2;
+}
+
+/* rounds with the current rounding mode (to nearest, ties to even by default) and saturates to the int16 range */
+static inline vint16m4_t __riscv_vfncvt_x_f_w_i16m4(vfloat32m8_t vs2, size_t vl)
+{
+    vint16m4_t vd = {0};
+    for (size_t i = 0; i < vl; ++i)
+    {
+        long value = isnan(vs2.v[i]) ? INT16_MAX : lrintf(fmaxf(fminf(vs2.v[i], INT16_MAX), INT16_MIN));
+        vd.v[i] = (int16_t)value;
+    }
+    return vd;
+}
+
+/* keeps the low bits of each element, without saturation */
+static inline vint8m2_t __riscv_vncvt_x_x_w_i8m2(vint16m4_t vs2, size_t vl)
+{
+    vint8m2_t vd = {0};
+    for (size_t i = 0; i < vl; ++i)
+    {
+        vd.v[i] = (int8_t)vs2.v[i];
+    }
+    return vd;
+}
+
+#endif // IREE_RUNTIME_UNIT_TESTS_RISCV_VECTOR_H_
@@ -24,12 +24,35 @@ GENERATE_MODULE_STATUSES(SENSOR_MOCK);
 #define SENSOR_MOCK_BUFFER_LEN (32)
 #define SENSOR_MOCK_READ_INTERVAL (0.01F) // 10 ms (100 Hz)
 
+#define SENSOR_MOCK_FIFO_LEN (8)
+#define SENSOR_MOCK_FIFO_BURST_LEN (4)
+
 typedef struct __attribute__((packed))
 {
     float a;
     float b;
 } sensor_mock_data_t;
 
+typedef struct __attribute__((packed))
+{
+    int16_t a;
+    int16_t b;
+} sensor_mock_raw_data_t;
+
 status_t sensor_mock_read_data(sensor_mock_data_t *data);
 
+status_t sensor_mock_read_raw_data(sensor_mock_raw_data_t *data);
+
+status_t sensor_mock_enable_fifo();
+
+status_t sensor_mock_read_fifo(sensor_mock_data_t *data, const size_t max_count, size_t *count);
+
+status_t sensor_mock_read_raw_fifo(sensor_mock_raw_data_t *data, const size_t max_count, size_t *count);
+
+status_t sensor_mock_validate_config(const float data_rate, const uint32_t range);
+
+status_t sensor_mock_set_data_rate(const float data_rate, float *applied_rate);
+
+status_t sensor_mock_set_range(const uint32_t range);
+
 #endif // IREE_RUNTIME_UNIT_TESTS_SENSOR_MOCK_H_
@@ -13,8 +13,14 @@
 #define ADXL345_ADDRESS (0x1D)
 #define DATA_SIZE (4)
 
+extern float g_adxl345_scale;
+
 status_t mock_i2c_read_target_register(uint8_t target_id, uint8_t address, uint8_t *data, int num_calls);
 
+void setUp(void) { g_adxl345_scale = ADXL345_SCALE_2G; }
+
+void tearDown(void) {}
+
 // ========================================================
 // adxl345_read_data
 // ========================================================
@@ -67,3 +73,504 @@ void test_ReadDataShouldFailWhenRegisterReadFails(status_t i2c_error)
 
     TEST_ASSERT_EQUAL_HEX(i2c_error, status);
 }
+
+// ========================================================
+// adxl345_read_raw_data
+// ========================================================
+
+/**
+ * Tests if read raw data returns values of data registers without scaling them
+ */
+void test_ReadRawDataShouldReturnUnscaledData(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_raw_data_t data = {0};
+    uint8_t registers[] = {0x10, 0x00, 0xFF, 0xFF, 0x00, 0x01};
+
+    g_adxl345_scale = 2 * ADXL345_SCALE_2G;
+
+    i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, sizeof(data), NULL, STATUS_OK);
+    i2c_read_target_registers_IgnoreArg_data();
+    i2c_read_target_registers_ReturnArrayThruPtr_data(registers, sizeof(registers));
+
+    status = adxl345_read_raw_data(&data);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_INT16(16, data.x);
+    TEST_ASSERT_EQUAL_INT16(-1, data.y);
+    TEST_ASSERT_EQUAL_INT16(256, data.z);
+}
+
+/**
+ * Tests if read raw data fails if data pointer is invalid
+ */
+void test_ReadRawDataShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_read_raw_data(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// adxl345_validate_config
+// ========================================================
+
+TEST_CASE(400.0F, 2)
+TEST_CASE(100.5F, 16)
+TEST_CASE(6.25F, 8)
+/**
+ * Tests if validate config accepts supported data rate and range without accessing the sensor
+ */
+void test_ValidateConfigShouldAcceptSupportedRateAndRange(float data_rate, uint32_t range)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_validate_config(data_rate, range);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+TEST_CASE(1000.0F, 8)
+TEST_CASE(800.0F, 8)
+TEST_CASE(100.0F, 3)
+TEST_CASE(1000.0F, 3)
+/**
+ * Tests if validate config fails when data rate or range is not supported
+ */
+void test_ValidateConfigShouldFailForUnsupportedRateOrRange(float data_rate, uint32_t range)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_validate_config(data_rate, range);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_ARG, status);
+}
+
+// ========================================================
+// adxl345_set_data_rate
+// ========================================================
+
+TEST_CASE(400.0F, 0x00, 0x0C, 400.0F)
+TEST_CASE(100.0F, 0x00, 0x0A, 100.0F)
+TEST_CASE(6.25F, 0x00, 0x06, 6.25F)
+TEST_CASE(200.0F, 0x1A, 0x1B, 200.0F)
+TEST_CASE(100.5F, 0x00, 0x0A, 100.0F)
+TEST_CASE(6.2F, 0x00, 0x06, 6.25F)
+/**
+ * Tests if set data rate writes rate code to BW_RATE register, keeping its other bits, and returns the applied rate
+ */
+void test_SetDataRateShouldWriteRateCode(float data_rate, uint8_t bw_rate, uint8_t expected_bw_rate,
+                                         float expected_rate)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 0.0F;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_BW_RATE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&bw_rate);
+    i2c_write_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_BW_RATE, expected_bw_rate, STATUS_OK);
+
+    status = adxl345_set_data_rate(data_rate, &applied_rate);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_FLOAT(expected_rate, applied_rate);
+}
+
+TEST_CASE(0.0F)
+TEST_CASE(1000.0F)
+TEST_CASE(3.125F)
+TEST_CASE(800.0F)
+TEST_CASE(3200.0F)
+TEST_CASE(6400.0F)
+TEST_CASE(102.0F)
+/**
+ * Tests if set data rate fails for rate not supported by the sensor or too high for the FIFO drain
+ */
+void test_SetDataRateShouldFailForUnsupportedRate(float data_rate)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 0.0F;
+
+    status = adxl345_set_data_rate(data_rate, &applied_rate);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if set data rate fails for invalid applied rate pointer
+ */
+void test_SetDataRateShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_set_data_rate(100.0F, NULL);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+}
+
+/**
+ * Tests if set data rate fails when register read fails
+ */
+void test_SetDataRateShouldFailWhenRegisterReadFails(void)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 0.0F;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_BW_RATE, NULL, I2C_STATUS_TIMEOUT);
+    i2c_read_target_register_IgnoreArg_data();
+
+    status = adxl345_set_data_rate(100.0F, &applied_rate);
+
+    TEST_ASSERT_EQUAL_HEX(I2C_STATUS_TIMEOUT, status);
+}
+
+// ========================================================
+// adxl345_set_range
+// ========================================================
+
+TEST_CASE(2, 0x00, 0x00)
+TEST_CASE(4, 0x00, 0x01)
+TEST_CASE(8, 0x00, 0x02)
+TEST_CASE(16, 0x0C, 0x0F)
+/**
+ * Tests if set range writes range code to DATA_FORMAT register, keeping its other bits
+ */
+void test_SetRangeShouldWriteRangeCode(uint32_t range, uint8_t data_format, uint8_t expected_data_format)
+{
+    status_t status = STATUS_OK;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_FORMAT, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&data_format);
+    i2c_write_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_FORMAT, expected_data_format, STATUS_OK);
+
+    status = adxl345_set_range(range);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+/**
+ * Tests if set range updates scaling of the read data
+ */
+void test_SetRangeShouldUpdateDataScaling(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data;
+    int16_t raw_data[] = {1, -2, 3};
+    uint8_t data_format = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_FORMAT, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&data_format);
+    i2c_write_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_FORMAT, 0x03, STATUS_OK);
+    i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, sizeof(raw_data), NULL, STATUS_OK);
+    i2c_read_target_registers_IgnoreArg_data();
+    i2c_read_target_registers_ReturnArrayThruPtr_data((uint8_t *)raw_data, sizeof(raw_data));
+
+    adxl345_set_range(16);
+    status = adxl345_read_data(&data);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_FLOAT(32.0F, data.x);
+    TEST_ASSERT_EQUAL_FLOAT(-64.0F, data.y);
+    TEST_ASSERT_EQUAL_FLOAT(96.0F, data.z);
+}
+
+TEST_CASE(0)
+TEST_CASE(3)
+TEST_CASE(32)
+/**
+ * Tests if set range fails for range not supported by the sensor
+ */
+void test_SetRangeShouldFailForUnsupportedRange(uint32_t range)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_set_range(range);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_FLOAT(ADXL345_SCALE_2G, g_adxl345_scale);
+}
+
+// ========================================================
+// adxl345_set_fifo_mode
+// ========================================================
+
+TEST_CASE(ADXL345_FIFO_MODE_BYPASS, 0, 0x00)
+TEST_CASE(ADXL345_FIFO_MODE_FIFO, 31, 0x5F)
+TEST_CASE(ADXL345_FIFO_MODE_STREAM, 16, 0x90)
+TEST_CASE(ADXL345_FIFO_MODE_TRIGGER, 1, 0xC1)
+/**
+ * Tests if set FIFO mode writes proper value to FIFO_CTL register
+ */
+void test_SetFIFOModeShouldWriteFIFOControlRegister(ADXL345_FIFO_MODE mode, uint8_t samples, uint8_t fifo_ctl)
+{
+    status_t status = STATUS_OK;
+
+    i2c_write_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_CTL, fifo_ctl, STATUS_OK);
+
+    status = adxl345_set_fifo_mode(mode, samples);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+TEST_CASE(ADXL345_FIFO_MODE_TRIGGER + 1, 0)
+TEST_CASE(ADXL345_FIFO_MODE_STREAM, 32)
+/**
+ * Tests if set FIFO mode fails for invalid arguments
+ */
+void test_SetFIFOModeShouldFailForInvalidArguments(ADXL345_FIFO_MODE mode, uint8_t samples)
+{
+    status_t status = STATUS_OK;
+
+    status = adxl345_set_fifo_mode(mode, samples);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if enable FIFO switches FIFO to stream mode
+ */
+void test_EnableFIFOShouldSwitchFIFOToStreamMode(void)
+{
+    status_t status = STATUS_OK;
+
+    i2c_write_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_CTL,
+                                              (ADXL345_FIFO_MODE_STREAM << 6) | ADXL345_FIFO_BURST_LEN, STATUS_OK);
+
+    status = adxl345_enable_fifo();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+// ========================================================
+// adxl345_read_fifo
+// ========================================================
+
+TEST_CASE(0, 4, 0)
+TEST_CASE(3, 4, 3)
+TEST_CASE(0x80 | 6, 4, 4)
+/**
+ * Tests if read FIFO reads all stored samples, up to the size of the output buffer
+ */
+void test_ReadFIFOShouldReadStoredSamples(uint8_t fifo_status, size_t max_count, size_t expected_count)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    uint8_t int_source = 0;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&fifo_status);
+    for (size_t i = 0; i < expected_count; ++i)
+    {
+        i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, STATUS_OK);
+        i2c_read_target_registers_IgnoreArg_data();
+    }
+
+    status = adxl345_read_fifo(data, max_count, &count);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(expected_count, count);
+}
+
+/**
+ * Tests if read FIFO returns number of samples read before failure
+ */
+void test_ReadFIFOShouldReturnSamplesReadBeforeFailure(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    uint8_t int_source = 0;
+    uint8_t fifo_status = 3;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&fifo_status);
+    i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, STATUS_OK);
+    i2c_read_target_registers_IgnoreArg_data();
+    i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, I2C_STATUS_TIMEOUT);
+    i2c_read_target_registers_IgnoreArg_data();
+
+    status = adxl345_read_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(I2C_STATUS_TIMEOUT, status);
+    TEST_ASSERT_EQUAL_UINT(1, count);
+}
+
+TEST_CASE(I2C_STATUS_ERROR)
+TEST_CASE(I2C_STATUS_TIMEOUT)
+/**
+ * Tests if read FIFO fails when FIFO status read fails
+ */
+void test_ReadFIFOShouldFailWhenStatusReadFails(status_t i2c_error)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    uint8_t int_source = 0;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, i2c_error);
+    i2c_read_target_register_IgnoreArg_data();
+
+    status = adxl345_read_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(i2c_error, status);
+    TEST_ASSERT_EQUAL_UINT(0, count);
+}
+
+TEST_CASE(I2C_STATUS_ERROR)
+TEST_CASE(I2C_STATUS_TIMEOUT)
+/**
+ * Tests if read FIFO fails without reading FIFO status when interrupt source read fails
+ */
+void test_ReadFIFOShouldFailWhenInterruptSourceReadFails(status_t i2c_error)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, i2c_error);
+    i2c_read_target_register_IgnoreArg_data();
+
+    status = adxl345_read_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(i2c_error, status);
+    TEST_ASSERT_EQUAL_UINT(0, count);
+}
+
+/**
+ * Tests if read FIFO reads the stored samples and reports overrun when older samples were overwritten
+ */
+void test_ReadFIFOShouldReportOverrun(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    uint8_t int_source = 0x83;
+    uint8_t fifo_status = 0x80 | 4;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&fifo_status);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, STATUS_OK);
+        i2c_read_target_registers_IgnoreArg_data();
+    }
+
+    status = adxl345_read_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_FIFO_OVERRUN, status);
+    TEST_ASSERT_EQUAL_UINT(4, count);
+}
+
+/**
+ * Tests if read FIFO fails for invalid pointers
+ */
+void test_ReadFIFOShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_data_t data[4];
+    size_t count = 0;
+
+    status = adxl345_read_fifo(NULL, 4, &count);
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+
+    status = adxl345_read_fifo(data, 4, NULL);
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// adxl345_read_raw_fifo
+// ========================================================
+
+/**
+ * Tests if read raw FIFO reads all stored samples, up to the size of the output buffer
+ */
+void test_ReadRawFIFOShouldReadStoredSamples(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_raw_data_t data[4];
+    uint8_t int_source = 0;
+    uint8_t fifo_status = 3;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&fifo_status);
+    for (size_t i = 0; i < fifo_status; ++i)
+    {
+        i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, STATUS_OK);
+        i2c_read_target_registers_IgnoreArg_data();
+    }
+
+    status = adxl345_read_raw_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(fifo_status, count);
+}
+
+/**
+ * Tests if read raw FIFO reads the stored samples and reports overrun when older samples were overwritten
+ */
+void test_ReadRawFIFOShouldReportOverrun(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_raw_data_t data[4];
+    uint8_t int_source = 0x01;
+    uint8_t fifo_status = 2;
+    size_t count = 0;
+
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_INT_SOURCE, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&int_source);
+    i2c_read_target_register_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_FIFO_STATUS, NULL, STATUS_OK);
+    i2c_read_target_register_IgnoreArg_data();
+    i2c_read_target_register_ReturnThruPtr_data(&fifo_status);
+    for (size_t i = 0; i < fifo_status; ++i)
+    {
+        i2c_read_target_registers_ExpectAndReturn(ADXL345_ADDRESS, ADXL345_DATA_X0, 6, NULL, STATUS_OK);
+        i2c_read_target_registers_IgnoreArg_data();
+    }
+
+    status = adxl345_read_raw_fifo(data, 4, &count);
+
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_FIFO_OVERRUN, status);
+    TEST_ASSERT_EQUAL_UINT(fifo_status, count);
+}
+
+/**
+ * Tests if read raw FIFO fails for invalid pointers
+ */
+void test_ReadRawFIFOShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    adxl345_raw_data_t data[4];
+    size_t count = 0;
+
+    status = adxl345_read_raw_fifo(NULL, 4, &count);
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+
+    status = adxl345_read_raw_fifo(data, 4, NULL);
+    TEST_ASSERT_EQUAL_HEX(ADXL345_STATUS_INV_PTR, status);
+}
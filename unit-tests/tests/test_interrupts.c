@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "../iree-runtime/utils/interrupts.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define TEST_CASE(...)
+
+uint32_t g_mock_csr = 0;
+uint32_t g_mock_csr_mstatus = 0;
+uint32_t g_mock_csr_mie = 0;
+uint32_t g_mock_csr_mtvec = 0;
+uint32_t g_handler_calls = 0;
+extern interrupt_handler_t g_interrupt_handlers[NUM_INTERRUPT_SOURCES];
+extern void trap_handler();
+
+/**
+ * Returns mocked CSR register
+ *
+ * @param csr CSR address
+ *
+ * @returns pointer to the mocked register
+ */
+static uint32_t *get_mock_csr(uint32_t csr);
+
+/**
+ * Mock interrupt handler that counts its calls
+ */
+static void mock_handler();
+
+void setUp(void)
+{
+    g_mock_csr = 0;
+    g_mock_csr_mstatus = 0;
+    g_mock_csr_mie = 0;
+    g_mock_csr_mtvec = 0;
+    g_handler_calls = 0;
+    memset(g_interrupt_handlers, 0, sizeof(g_interrupt_handlers));
+}
+
+void tearDown(void) {}
+
+// ========================================================
+// interrupts_init
+// ========================================================
+
+/**
+ * Tests if interrupts init installs trap handler and enables interrupts globally
+ */
+void test_InterruptsInitShouldInstallTrapHandlerAndEnableInterrupts(void)
+{
+    status_t status = STATUS_OK;
+
+    status = interrupts_init();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX((uint32_t)(uintptr_t)trap_handler, g_mock_csr_mtvec);
+    TEST_ASSERT_TRUE(g_mock_csr_mstatus & MSTATUS_MIE);
+}
+
+// ========================================================
+// interrupts_register_handler
+// ========================================================
+
+TEST_CASE(INTERRUPT_SOURCE_MACHINE_TIMER)
+TEST_CASE(INTERRUPT_SOURCE_MACHINE_EXTERNAL)
+/**
+ * Tests if interrupts register handler stores handler of given source
+ */
+void test_InterruptsRegisterHandlerShouldStoreHandler(interrupt_source_t source)
+{
+    status_t status = STATUS_OK;
+
+    status = interrupts_register_handler(source, mock_handler);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(mock_handler, g_interrupt_handlers[source]);
+}
+
+/**
+ * Tests if interrupts register handler fails for invalid source
+ */
+void test_InterruptsRegisterHandlerShouldFailForInvalidSource(void)
+{
+    status_t status = STATUS_OK;
+
+    status = interrupts_register_handler(NUM_INTERRUPT_SOURCES, mock_handler);
+
+    TEST_ASSERT_EQUAL_UINT(INTERRUPTS_STATUS_INV_SOURCE, status);
+}
+
+// ========================================================
+// interrupts_enable
+// ========================================================
+
+/**
+ * Tests if interrupts enable sets source bit in mie register
+ */
+void test_InterruptsEnableShouldSetSourceBit(void)
+{
+    status_t status = STATUS_OK;
+
+    interrupts_register_handler(INTERRUPT_SOURCE_MACHINE_EXTERNAL, mock_handler);
+
+    status = interrupts_enable(INTERRUPT_SOURCE_MACHINE_EXTERNAL);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX(1u << INTERRUPT_SOURCE_MACHINE_EXTERNAL, g_mock_csr_mie);
+}
+
+/**
+ * Tests if interrupts enable fails if there is no handler registered
+ */
+void test_InterruptsEnableShouldFailIfNoHandlerIsRegistered(void)
+{
+    status_t status = STATUS_OK;
+
+    status = interrupts_enable(INTERRUPT_SOURCE_MACHINE_EXTERNAL);
+
+    TEST_ASSERT_EQUAL_UINT(INTERRUPTS_STATUS_UNINIT, status);
+    TEST_ASSERT_EQUAL_HEX(0, g_mock_csr_mie);
+}
+
+// ========================================================
+// interrupts_disable
+// ========================================================
+
+/**
+ * Tests if interrupts disable clears source bit in mie register
+ */
+void test_InterruptsDisableShouldClearSourceBit(void)
+{
+    status_t status = STATUS_OK;
+
+    g_mock_csr_mie = (1u << INTERRUPT_SOURCE_MACHINE_EXTERNAL) | (1u << INTERRUPT_SOURCE_MACHINE_TIMER);
+
+    status = interrupts_disable(INTERRUPT_SOURCE_MACHINE_EXTERNAL);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX(1u << INTERRUPT_SOURCE_MACHINE_TIMER, g_mock_csr_mie);
+}
+
+// ========================================================
+// interrupts_lock / interrupts_unlock
+// ========================================================
+
+TEST_CASE(0)
+TEST_CASE(MSTATUS_MIE)
+/**
+ * Tests if interrupts lock disables interrupts and unlock restores previous state
+ */
+void test_InterruptsLockAndUnlockShouldRestorePreviousState(uint32_t mstatus)
+{
+    uint32_t state = 0;
+
+    g_mock_csr_mstatus = mstatus;
+    g_mock_csr = mstatus;
+
+    state = interrupts_lock();
+
+    TEST_ASSERT_FALSE(g_mock_csr_mstatus & MSTATUS_MIE);
+
+    interrupts_unlock(state);
+
+    TEST_ASSERT_EQUAL_HEX(mstatus, g_mock_csr_mstatus);
+}
+
+// ========================================================
+// trap_handler
+// ========================================================
+
+/**
+ * Tests if trap handler calls handler of the interrupt
+ */
+void test_TrapHandlerShouldCallRegisteredHandler(void)
+{
+    interrupts_register_handler(INTERRUPT_SOURCE_MACHINE_EXTERNAL, mock_handler);
+    g_mock_csr = MCAUSE_INTERRUPT | INTERRUPT_SOURCE_MACHINE_EXTERNAL;
+
+    trap_handler();
+
+    TEST_ASSERT_EQUAL_UINT(1, g_handler_calls);
+}
+
+/**
+ * Tests if trap handler disables interrupt that has no handler
+ */
+void test_TrapHandlerShouldDisableInterruptWithoutHandler(void)
+{
+    g_mock_csr_mie = 1u << INTERRUPT_SOURCE_MACHINE_TIMER;
+    g_mock_csr = MCAUSE_INTERRUPT | INTERRUPT_SOURCE_MACHINE_TIMER;
+
+    trap_handler();
+
+    TEST_ASSERT_EQUAL_UINT(0, g_handler_calls);
+    TEST_ASSERT_EQUAL_HEX(0, g_mock_csr_mie);
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+void mock_csr_read_callback() {}
+
+void mock_csr_write(uint32_t csr, uint32_t value) { *get_mock_csr(csr) = value; }
+
+void mock_csr_set(uint32_t csr, uint32_t value) { *get_mock_csr(csr) |= value; }
+
+void mock_csr_clear(uint32_t csr, uint32_t value) { *get_mock_csr(csr) &= ~value; }
+
+static void mock_handler() { ++g_handler_calls; }
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static uint32_t *get_mock_csr(uint32_t csr)
+{
+    switch (csr)
+    {
+    case CSR_MSTATUS:
+        return &g_mock_csr_mstatus;
+    case CSR_MIE:
+        return &g_mock_csr_mie;
+    case CSR_MTVEC:
+        return &g_mock_csr_mtvec;
+    default:
+        return &g_mock_csr;
+    }
+}
@@ -6,8 +6,11 @@
 
 #include "../iree-runtime/utils/model.h"
 #include "mock_iree_wrapper.h"
+#include "mock_preprocessing.h"
+#include "mock_profiler.h"
 #include "unity.h"
 
+#include <math.h>
 #include <string.h>
 
 #define TEST_CASE(...)
@@ -21,6 +24,14 @@
 
 extern MlModel g_model_struct;
 extern MODEL_STATE g_model_state;
+extern uint8_t g_model_weights_buffer[];
+extern size_t g_model_weights_upload_size;
+extern size_t g_model_weights_upload_offset;
+
+/**
+ * Number of records of each phase passed to the mocked profiler
+ */
+uint32_t g_profiler_records[NUM_PROFILER_PHASES];
 
 /**
  * Returns example model struct data with passed dtype.
@@ -31,7 +42,27 @@ extern MODEL_STATE g_model_state;
  */
 MlModel get_model_struct_data(char dtype[]);
 
-void setUp(void) { g_model_struct = get_model_struct_data("f32"); }
+/**
+ * Mock of profiler record function. Counts records of each phase
+ *
+ * @param phase recorded phase
+ * @param timestamp values of the counters at the beginning of the phase
+ * @param num_calls number of mock calls
+ *
+ * @returns error status of the profiler
+ */
+status_t mock_profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp, int num_calls);
+
+void setUp(void)
+{
+    g_model_struct = get_model_struct_data("f32");
+    g_model_weights_upload_size = 0;
+    g_model_weights_upload_offset = 0;
+    preprocessing_get_output_element_size_IgnoreAndReturn(0);
+    memset(g_profiler_records, 0, sizeof(g_profiler_records));
+    profiler_start_Ignore();
+    profiler_record_StubWithCallback(mock_profiler_record);
+}
 
 void tearDown(void) {}
 
@@ -280,7 +311,7 @@ void test_ModelLoadModelStructShouldFailForInvalidPointer(void)
 }
 
 // ========================================================
-// load_model_weights
+// get_model_weights_buffer
 // ========================================================
 
 TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
@@ -288,397 +319,1266 @@ TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
 TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
 TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
 /**
- * Tests model weights loading in valid model states
+ * Tests if get model weights buffer returns aligned buffer and unloads the model
  */
-void test_ModelLoadModelWeightsShouldCreateContextAndChangeModelState(uint32_t model_state)
+void test_ModelGetModelWeightsBufferShouldReturnAlignedBufferAndUnloadModel(uint32_t model_state)
 {
     status_t status = STATUS_OK;
-    uint8_t model_weights[128];
+    uint8_t *model_weights_buffer = NULL;
 
     g_model_state = model_state;
-    create_context_ExpectAndReturn(model_weights, sizeof(model_weights), STATUS_OK);
-    release_output_buffer_Ignore();
-    release_input_buffer_Ignore();
+    release_output_buffer_Expect();
+    release_input_buffer_Expect();
+    release_context_Expect();
 
-    status = load_model_weights(model_weights, sizeof(model_weights));
+    status = get_model_weights_buffer(128, &model_weights_buffer);
 
     TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_PTR(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], model_weights_buffer);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)model_weights_buffer % MODEL_WEIGHTS_ALIGNMENT);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
 }
 
 /**
- * Tests model weights loading for invalid pointer
+ * Tests if get model weights buffer fails when model is in invalid state
  */
-void test_ModelLoadModelWeightsShouldFailForInvalidPointer(void)
+void test_ModelGetModelWeightsBufferShouldFailIfModelStateIsUninitialized(void)
 {
     status_t status = STATUS_OK;
+    uint8_t *model_weights_buffer = NULL;
 
-    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_state = MODEL_STATE_UNINITIALIZED;
 
-    status = load_model_weights(NULL, 0);
+    status = get_model_weights_buffer(128, &model_weights_buffer);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, model_weights_buffer);
 }
 
 /**
- * Tests model weights loading when model is in invalid state
+ * Tests if get model weights buffer fails for weights bigger than model weights buffer
  */
-void test_ModelLoadWeightsShouldFailInModelStateIsUninitialized(void)
+void test_ModelGetModelWeightsBufferShouldFailForTooBigWeights(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_weights[128];
+    uint8_t *model_weights_buffer = NULL;
 
-    g_model_state = MODEL_STATE_UNINITIALIZED;
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
 
-    status = load_model_weights(model_weights, sizeof(model_weights));
+    status = get_model_weights_buffer(MAX_MODEL_WEIGHTS_SIZE_BYTES + 1, &model_weights_buffer);
 
-    TEST_ASSERT_EQUAL_UINT(status, MODEL_STATUS_INV_STATE);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_UNINITIALIZED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
 }
 
 /**
- * Tests model weights loading when IREE context creation fails
+ * Tests if get model weights buffer fails for invalid pointer
  */
-void test_ModelLoadModelWeightsShouldFailIfCreateContextFails(void)
+void test_ModelGetModelWeightsBufferShouldFailForInvalidPointer(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_weights[128];
 
     g_model_state = MODEL_STATE_STRUCT_LOADED;
-    create_context_ExpectAndReturn(model_weights, sizeof(model_weights), IREE_WRAPPER_STATUS_ERROR);
-    release_output_buffer_Ignore();
-    release_input_buffer_Ignore();
 
-    status = load_model_weights(model_weights, sizeof(model_weights));
+    status = get_model_weights_buffer(128, NULL);
 
-    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
 }
 
 // ========================================================
-// get_model_input_size
+// begin_model_weights_upload
 // ========================================================
 
-TEST_CASE(1 /*MODEL_STATE_STRUCT_LOADED*/, 1, 1)
-TEST_CASE(2 /* MODEL_STATE_WEIGHTS_LOADED */, 2, 2)
-TEST_CASE(3 /* MODEL_STATE_INPUT_LOADED */, 4, 4)
-TEST_CASE(4 /* MODEL_STATE_INFERENCE_DONE */, 3, 128)
 /**
- * Tests if get model input size properly computes the input size
+ * Tests if begin model weights upload unloads the model and starts the upload
  */
-void test_ModelGetModelInputSizeShouldComputeInputSize(uint32_t model_state, size_t size_bytes, size_t input_length)
+void test_ModelBeginModelWeightsUploadShouldUnloadModelAndStartUpload(void)
 {
     status_t status = STATUS_OK;
-    size_t input_size = 0;
 
-    g_model_state = model_state;
-    g_model_struct.num_input = 1;
-    g_model_struct.input_size_bytes[0] = size_bytes;
-    g_model_struct.input_length[0] = input_length;
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    release_output_buffer_Expect();
+    release_input_buffer_Expect();
+    release_context_Expect();
 
-    status = get_model_input_size(&input_size);
+    status = begin_model_weights_upload(128);
 
-    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(size_bytes * input_length, input_size);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(128, g_model_weights_upload_size);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_weights_upload_offset);
 }
 
-TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
 /**
- * Tests if get model input size fails when model is in invalid state
+ * Tests if begin model weights upload fails for empty model
  */
-void test_ModelGetModelInputSizeShouldFailWhenModelInInvalidState(uint32_t model_state)
+void test_ModelBeginModelWeightsUploadShouldFailForZeroSize(void)
 {
     status_t status = STATUS_OK;
-    size_t input_size = 0;
 
-    g_model_state = model_state;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    status = get_model_input_size(&input_size);
+    status = begin_model_weights_upload(0);
 
-    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_weights_upload_size);
 }
 
 /**
- * Tests if get model input size fails for invalid pointer
+ * Tests if begin model weights upload fails for weights bigger than model weights buffer
  */
-void test_ModelGetModelInputSizeShouldFailForInvalidPointer(void)
+void test_ModelBeginModelWeightsUploadShouldFailForTooBigWeights(void)
 {
     status_t status = STATUS_OK;
 
-    status = get_model_input_size(NULL);
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_PTR, status);
-}
+    status = begin_model_weights_upload(MAX_MODEL_WEIGHTS_SIZE_BYTES + 1);
 
-// ========================================================
-// load_model_input
-// ========================================================
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_weights_upload_size);
+}
 
-TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
-TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
-TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
 /**
- * Tests model input loading for valid model states
+ * Tests if begin model weights upload fails if model struct is not loaded
  */
-void test_ModelLoadModelInputShouldPrepareInputBufferAndChangeModelState(uint32_t model_state)
+void test_ModelBeginModelWeightsUploadShouldFailIfModelStateIsUninitialized(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
 
-    g_model_state = model_state;
-    prepare_input_buffer_ExpectAndReturn(&g_model_struct, model_input, STATUS_OK);
-    release_input_buffer_Ignore();
+    g_model_state = MODEL_STATE_UNINITIALIZED;
 
-    status = load_model_input(model_input, sizeof(model_input));
+    status = begin_model_weights_upload(128);
 
-    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_weights_upload_size);
 }
 
+// ========================================================
+// load_model_weights_chunk
+// ========================================================
+
 /**
- * Tests model input loading when IREE buffer allocation fails
+ * Tests if load model weights chunk writes chunks one after another into model weights buffer
  */
-void test_ModelLoadModelInputShouldFailIfPrepareInputBufferReturnsError(void)
+void test_ModelLoadModelWeightsChunkShouldWriteChunksIntoModelWeightsBuffer(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+    uint8_t model_weights[] = "some model weights";
 
-    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
-    prepare_input_buffer_ExpectAndReturn(&g_model_struct, model_input, IREE_WRAPPER_STATUS_ERROR);
-    release_input_buffer_Ignore();
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_weights_upload_size = sizeof(model_weights);
 
-    status = load_model_input(model_input, sizeof(model_input));
+    status = load_model_weights_chunk(model_weights, 4);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    status = load_model_weights_chunk(model_weights + 4, sizeof(model_weights) - 4);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
 
-    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(sizeof(model_weights), g_model_weights_upload_offset);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(model_weights, &g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM],
+                                  sizeof(model_weights));
 }
 
 /**
- * Tests model input loading for invalid pointer
+ * Tests if load model weights chunk fails for chunk exceeding declared model size
  */
-void test_ModelLoadModelInputShouldFailForInvalidInputPointer(void)
+void test_ModelLoadModelWeightsChunkShouldFailForChunkExceedingModelSize(void)
 {
     status_t status = STATUS_OK;
+    uint8_t model_weights[128];
 
-    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_weights_upload_size = sizeof(model_weights);
+    g_model_weights_upload_offset = 64;
 
-    status = load_model_input(NULL, 0);
+    status = load_model_weights_chunk(model_weights, 65);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(64, g_model_weights_upload_offset);
 }
 
-TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
-TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
 /**
- * Tests model input loading when model is in invalid state
+ * Tests if load model weights chunk fails if there is no upload in progress
  */
-void test_ModelLoadModelInputShouldFailIfModelIsInInvalidState(uint32_t model_state)
+void test_ModelLoadModelWeightsChunkShouldFailIfUploadNotBegun(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+    uint8_t model_weights[128];
 
-    g_model_state = model_state;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    status = load_model_input(model_input, sizeof(model_input));
+    status = load_model_weights_chunk(model_weights, sizeof(model_weights));
 
     TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
-    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
 }
 
 /**
- * Tests model input loading when input size is invalid
+ * Tests if load model weights chunk fails for invalid pointer
  */
-void test_ModelLoadModelInputShouldFailForInvalidInputSize(void)
+void test_ModelLoadModelWeightsChunkShouldFailForInvalidPointer(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
 
-    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_weights_upload_size = 128;
 
-    status = load_model_input(model_input, sizeof(model_input) / 2);
+    status = load_model_weights_chunk(NULL, 64);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
 }
 
 // ========================================================
-// run_model
+// commit_model_weights_upload
 // ========================================================
 
-TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
-TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
 /**
- * Tests model execution for valid model states
+ * Tests if commit model weights upload creates context in place and finishes the upload
  */
-void test_ModelRunModelShouldPrepareOutputAndRunInference(uint32_t model_state)
+void test_ModelCommitModelWeightsUploadShouldCreateContextInPlace(void)
 {
     status_t status = STATUS_OK;
 
-    g_model_state = model_state;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_weights_upload_size = 128;
+    g_model_weights_upload_offset = 128;
     release_output_buffer_Ignore();
-    prepare_output_buffer_IgnoreAndReturn(STATUS_OK);
-    run_inference_IgnoreAndReturn(STATUS_OK);
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], 128, STATUS_OK);
+    allocate_input_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
+    allocate_output_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
 
-    status = run_model();
+    status = commit_model_weights_upload();
 
     TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INFERENCE_DONE, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_weights_upload_size);
 }
 
 /**
- * Tests model execution when output buffer allocation fails
+ * Tests if commit model weights upload fails if not all chunks were received
  */
-void test_ModelRunModelShouldFailIfPrepareOutputFails(void)
+void test_ModelCommitModelWeightsUploadShouldFailIfUploadIncomplete(void)
 {
     status_t status = STATUS_OK;
 
-    g_model_state = MODEL_STATE_INPUT_LOADED;
-    release_output_buffer_Ignore();
-    prepare_output_buffer_IgnoreAndReturn(IREE_WRAPPER_STATUS_ERROR);
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    g_model_weights_upload_size = 128;
+    g_model_weights_upload_offset = 64;
 
-    status = run_model();
+    status = commit_model_weights_upload();
 
-    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
 }
 
 /**
- * Tests model execution when inference fails
+ * Tests if commit model weights upload fails if there is no upload in progress
  */
-void test_ModelRunModelShouldFailIfRunInferenceFails(void)
+void test_ModelCommitModelWeightsUploadShouldFailIfUploadNotBegun(void)
 {
     status_t status = STATUS_OK;
 
-    g_model_state = MODEL_STATE_INPUT_LOADED;
-    release_output_buffer_Ignore();
-    prepare_output_buffer_IgnoreAndReturn(STATUS_OK);
-    run_inference_IgnoreAndReturn(IREE_WRAPPER_STATUS_ERROR);
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    status = run_model();
+    status = commit_model_weights_upload();
 
-    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
 }
 
-TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+// ========================================================
+// load_model_weights
+// ========================================================
+
 TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
 TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
 /**
- * Tests model execution when model is in invalid state
+ * Tests model weights loading in valid model states
  */
-void test_ModelRunModelShouldFailIfModelIsInInvalidState(uint32_t model_state)
+void test_ModelLoadModelWeightsShouldCreateContextAndChangeModelState(uint32_t model_state)
 {
     status_t status = STATUS_OK;
+    uint8_t model_weights[128] = "model weights";
 
     g_model_state = model_state;
+    release_output_buffer_Ignore();
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], sizeof(model_weights), STATUS_OK);
+    allocate_input_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
+    allocate_output_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
 
-    status = run_model();
+    status = load_model_weights(model_weights, sizeof(model_weights));
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
-    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(model_weights, &g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM],
+                                  sizeof(model_weights));
 }
 
-// ========================================================
-// get_model_output
-// ========================================================
-
 /**
- * Tests model get output for valid model states
+ * Tests if model weights loading fails when input buffer allocation fails
  */
-void test_ModelGetModelOutputShouldReturnModelOutput(void)
+void test_ModelLoadModelWeightsShouldFailIfAllocateInputBufferFails(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_output[MODEL_STRUCT_OUTPUT_LEN * MODEL_STRUCT_OUTPUT_SIZE];
-    size_t model_output_size = 0;
+    uint8_t model_weights[128];
 
-    g_model_state = MODEL_STATE_INFERENCE_DONE;
-    get_output_ExpectAndReturn(model_output, STATUS_OK);
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    release_output_buffer_Ignore();
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], sizeof(model_weights), STATUS_OK);
+    allocate_input_buffer_ExpectAndReturn(&g_model_struct, IREE_WRAPPER_STATUS_ERROR);
 
-    status = get_model_output(sizeof(model_output), model_output, &model_output_size);
+    status = load_model_weights(model_weights, sizeof(model_weights));
 
-    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INFERENCE_DONE, g_model_state);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STRUCT_OUTPUT_LEN * 4, model_output_size);
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
 }
 
 /**
- * Tests model get output for invalid buffer pointer
+ * Tests if model weights loading fails when output buffer allocation fails
  */
-void test_ModelGetModelOutputShouldFailForInvalidModelOutputPointer(void)
+void test_ModelLoadModelWeightsShouldFailIfAllocateOutputBufferFails(void)
 {
     status_t status = STATUS_OK;
-    size_t model_output_size = 0;
+    uint8_t model_weights[128];
 
-    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    release_output_buffer_Ignore();
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], sizeof(model_weights), STATUS_OK);
+    allocate_input_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
+    allocate_output_buffer_ExpectAndReturn(&g_model_struct, IREE_WRAPPER_STATUS_ERROR);
 
-    status = get_model_output(0, NULL, &model_output_size);
+    status = load_model_weights(model_weights, sizeof(model_weights));
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INFERENCE_DONE, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
 }
 
 /**
- * Tests model get output for invalid buffer size
+ * Tests model weights loading when weights are already placed in model weights buffer
  */
-void test_ModelGetModelOutputShouldFailForInvalidModelOutputSizePointer(void)
+void test_ModelLoadModelWeightsShouldCreateContextInPlaceForWeightsInModelWeightsBuffer(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_output[MODEL_STRUCT_OUTPUT_LEN * MODEL_STRUCT_OUTPUT_SIZE];
+    uint8_t *model_weights = &g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM];
 
-    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    release_output_buffer_Ignore();
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(model_weights, 128, STATUS_OK);
+    allocate_input_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
+    allocate_output_buffer_ExpectAndReturn(&g_model_struct, STATUS_OK);
 
-    status = get_model_output(sizeof(model_output), model_output, NULL);
+    status = load_model_weights(model_weights, 128);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INFERENCE_DONE, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
 }
 
-TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
-TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
-TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
-TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
 /**
- * Tests model get output when model is in invalid state
+ * Tests model weights loading for weights bigger than model weights buffer
  */
-void test_ModelGetModelOutputShouldFailIfModelIsInInvalidState(uint32_t model_state)
+void test_ModelLoadModelWeightsShouldFailForTooBigWeights(void)
 {
     status_t status = STATUS_OK;
-    uint8_t model_output[MODEL_STRUCT_OUTPUT_LEN * MODEL_STRUCT_OUTPUT_SIZE];
-    size_t model_output_size = 0;
+    uint8_t model_weights[128];
 
-    g_model_state = model_state;
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    status = get_model_output(sizeof(model_output), model_output, &model_output_size);
+    status = load_model_weights(model_weights, MAX_MODEL_WEIGHTS_SIZE_BYTES + 1);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
-    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
 }
 
-// ========================================================
-// get_statistics
-// ========================================================
-
-TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
-TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
-TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
 /**
- * Tests model get statistics for valid model states
+ * Tests model weights loading for invalid pointer
  */
-void test_ModelGetStatisticsShouldReturnModelStatistics(uint32_t model_state)
+void test_ModelLoadModelWeightsShouldFailForInvalidPointer(void)
 {
     status_t status = STATUS_OK;
-    uint8_t statistics_buffer[128];
-    size_t statistics_size = 0;
 
-    g_model_state = model_state;
-    get_model_stats_ExpectAndReturn(sizeof(statistics_buffer), statistics_buffer, &statistics_size, STATUS_OK);
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
 
-    status = get_statistics(sizeof(statistics_buffer), statistics_buffer, &statistics_size);
+    status = load_model_weights(NULL, 0);
 
-    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
-    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
+}
+
+/**
+ * Tests model weights loading when model is in invalid state
+ */
+void test_ModelLoadWeightsShouldFailInModelStateIsUninitialized(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_weights[128];
+
+    g_model_state = MODEL_STATE_UNINITIALIZED;
+
+    status = load_model_weights(model_weights, sizeof(model_weights));
+
+    TEST_ASSERT_EQUAL_UINT(status, MODEL_STATUS_INV_STATE);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_UNINITIALIZED, g_model_state);
+}
+
+/**
+ * Tests model weights loading when IREE context creation fails
+ */
+void test_ModelLoadModelWeightsShouldFailIfCreateContextFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_weights[128];
+
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+    release_output_buffer_Ignore();
+    release_input_buffer_Ignore();
+    release_context_Ignore();
+    create_context_ExpectAndReturn(&g_model_weights_buffer[MODEL_WEIGHTS_HEADROOM], sizeof(model_weights),
+                                   IREE_WRAPPER_STATUS_ERROR);
+
+    status = load_model_weights(model_weights, sizeof(model_weights));
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_STRUCT_LOADED, g_model_state);
+}
+
+// ========================================================
+// get_model_input_size
+// ========================================================
+
+TEST_CASE(1 /*MODEL_STATE_STRUCT_LOADED*/, 1, 1)
+TEST_CASE(2 /* MODEL_STATE_WEIGHTS_LOADED */, 2, 2)
+TEST_CASE(3 /* MODEL_STATE_INPUT_LOADED */, 4, 4)
+TEST_CASE(4 /* MODEL_STATE_INFERENCE_DONE */, 3, 128)
+/**
+ * Tests if get model input size properly computes the input size
+ */
+void test_ModelGetModelInputSizeShouldComputeInputSize(uint32_t model_state, size_t size_bytes, size_t input_length)
+{
+    status_t status = STATUS_OK;
+    size_t input_size = 0;
+
+    g_model_state = model_state;
+    g_model_struct.num_input = 1;
+    g_model_struct.input_size_bytes[0] = size_bytes;
+    g_model_struct.input_length[0] = input_length;
+
+    status = get_model_input_size(&input_size);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(size_bytes * input_length, input_size);
+}
+
+TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+/**
+ * Tests if get model input size fails when model is in invalid state
+ */
+void test_ModelGetModelInputSizeShouldFailWhenModelInInvalidState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+    size_t input_size = 0;
+
+    g_model_state = model_state;
+
+    status = get_model_input_size(&input_size);
+
+    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if get model input size computes size of float elements if input preprocessing is enabled
+ */
+void test_ModelGetModelInputSizeShouldComputeFloatInputSizeIfPreprocessingIsEnabled(void)
+{
+    status_t status = STATUS_OK;
+    size_t input_size = 0;
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_struct.num_input = 2;
+    g_model_struct.input_size_bytes[0] = 1;
+    g_model_struct.input_length[0] = 16;
+    g_model_struct.input_size_bytes[1] = 1;
+    g_model_struct.input_length[1] = 8;
+    preprocessing_get_output_element_size_IgnoreAndReturn(1);
+
+    status = get_model_input_size(&input_size);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(24 * sizeof(float), input_size);
+}
+
+/**
+ * Tests if get model input size fails for invalid pointer
+ */
+void test_ModelGetModelInputSizeShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = get_model_input_size(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// get_model_input_element_type
+// ========================================================
+
+TEST_CASE(IREE_HAL_ELEMENT_TYPE_INT_16)
+TEST_CASE(IREE_HAL_ELEMENT_TYPE_FLOAT_32)
+/**
+ * Tests if get model input element type returns element type of the model
+ */
+void test_ModelGetModelInputElementTypeShouldReturnElementType(iree_hal_element_type_t hal_element_type)
+{
+    status_t status = STATUS_OK;
+    iree_hal_element_type_t element_type = 0;
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_struct.hal_element_type = hal_element_type;
+
+    status = get_model_input_element_type(&element_type);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(hal_element_type, element_type);
+}
+
+/**
+ * Tests if get model input element type returns float if input preprocessing is enabled
+ */
+void test_ModelGetModelInputElementTypeShouldReturnFloatIfPreprocessingIsEnabled(void)
+{
+    status_t status = STATUS_OK;
+    iree_hal_element_type_t element_type = 0;
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_struct.hal_element_type = IREE_HAL_ELEMENT_TYPE_INT_8;
+    preprocessing_get_output_element_size_IgnoreAndReturn(1);
+
+    status = get_model_input_element_type(&element_type);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(IREE_HAL_ELEMENT_TYPE_FLOAT_32, element_type);
+}
+
+/**
+ * Tests if get model input element type fails when model struct is not loaded
+ */
+void test_ModelGetModelInputElementTypeShouldFailWhenModelInInvalidState(void)
+{
+    status_t status = STATUS_OK;
+    iree_hal_element_type_t element_type = 0;
+
+    g_model_state = MODEL_STATE_UNINITIALIZED;
+
+    status = get_model_input_element_type(&element_type);
+
+    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if get model input element type fails for invalid pointer
+ */
+void test_ModelGetModelInputElementTypeShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = get_model_input_element_type(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(MODEL_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// load_model_input
+// ========================================================
+
+TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
+/**
+ * Tests model input loading for valid model states
+ */
+void test_ModelLoadModelInputShouldPrepareInputBufferAndChangeModelState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+
+    g_model_state = model_state;
+    prepare_input_buffer_ExpectAndReturn(&g_model_struct, model_input, STATUS_OK);
+
+    status = load_model_input(model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+}
+
+/**
+ * Tests model input loading when IREE buffer allocation fails
+ */
+void test_ModelLoadModelInputShouldFailIfPrepareInputBufferReturnsError(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    prepare_input_buffer_ExpectAndReturn(&g_model_struct, model_input, IREE_WRAPPER_STATUS_ERROR);
+
+    status = load_model_input(model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+}
+
+/**
+ * Tests if model input loading records the load input phase
+ */
+void test_ModelLoadModelInputShouldRecordLoadInputPhase(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    prepare_input_buffer_ExpectAndReturn(&g_model_struct, model_input, STATUS_OK);
+
+    status = load_model_input(model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_LOAD_INPUT]);
+}
+
+/**
+ * Model input buffers passed to the writer by the mocked write_input_buffer
+ */
+uint8_t g_mock_model_input_buffer[2][MODEL_STRUCT_INPUT_LEN];
+
+/**
+ * Mocks write input buffer, each model input buffer is passed to the writer
+ *
+ * @param model_struct model struct
+ * @param writer function that writes the input
+ * @param num_calls number of mock calls
+ *
+ * @returns status of the writer
+ */
+status_t mock_write_input_buffer(const MlModel *model_struct, model_input_writer_t writer, int num_calls)
+{
+    status_t status = STATUS_OK;
+
+    for (int i = 0; i < model_struct->num_input; ++i)
+    {
+        size_t buffer_size = model_struct->input_length[i] * model_struct->input_size_bytes[i];
+        status = writer(g_mock_model_input_buffer[i], buffer_size);
+        RETURN_ON_ERROR(status, status);
+    }
+
+    return STATUS_OK;
+}
+
+/**
+ * Tests model input loading with preprocessing, each model input is preprocessed into its buffer
+ */
+void test_ModelLoadModelInputShouldPreprocessInputIntoInputBuffers(void)
+{
+    status_t status = STATUS_OK;
+    float model_input[24] = {0};
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_struct.num_input = 2;
+    g_model_struct.input_size_bytes[0] = 1;
+    g_model_struct.input_length[0] = 16;
+    g_model_struct.input_size_bytes[1] = 1;
+    g_model_struct.input_length[1] = 8;
+    preprocessing_get_output_element_size_IgnoreAndReturn(1);
+    write_input_buffer_StubWithCallback(mock_write_input_buffer);
+    preprocess_ExpectAndReturn(&model_input[0], 16, 0, g_mock_model_input_buffer[0], STATUS_OK);
+    preprocess_ExpectAndReturn(&model_input[16], 8, 16, g_mock_model_input_buffer[1], STATUS_OK);
+
+    status = load_model_input((uint8_t *)model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+}
+
+/**
+ * Tests model input loading with preprocessing when preprocessing fails
+ */
+void test_ModelLoadModelInputShouldFailIfPreprocessReturnsError(void)
+{
+    status_t status = STATUS_OK;
+    float model_input[MODEL_STRUCT_INPUT_LEN] = {0};
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    g_model_struct.input_size_bytes[0] = 1;
+    preprocessing_get_output_element_size_IgnoreAndReturn(1);
+    write_input_buffer_StubWithCallback(mock_write_input_buffer);
+    preprocess_ExpectAndReturn(&model_input[0], MODEL_STRUCT_INPUT_LEN, 0, g_mock_model_input_buffer[0],
+                               PREPROCESSING_STATUS_UNINIT);
+
+    status = load_model_input((uint8_t *)model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_UNINIT, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+}
+
+/**
+ * Tests model input loading with preprocessing when preprocessing output does not match model input element
+ */
+void test_ModelLoadModelInputShouldFailIfPreprocessingOutputDoesNotMatchModelInput(void)
+{
+    status_t status = STATUS_OK;
+    float model_input[MODEL_STRUCT_INPUT_LEN] = {0};
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+    preprocessing_get_output_element_size_IgnoreAndReturn(1);
+
+    status = load_model_input((uint8_t *)model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+}
+
+/**
+ * Tests model input loading for invalid pointer
+ */
+void test_ModelLoadModelInputShouldFailForInvalidInputPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+
+    status = load_model_input(NULL, 0);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+}
+
+TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
+/**
+ * Tests model input loading when model is in invalid state
+ */
+void test_ModelLoadModelInputShouldFailIfModelIsInInvalidState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+
+    g_model_state = model_state;
+
+    status = load_model_input(model_input, sizeof(model_input));
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
+}
+
+/**
+ * Tests model input loading when input size is invalid
+ */
+void test_ModelLoadModelInputShouldFailForInvalidInputSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_input[MODEL_STRUCT_INPUT_LEN * MODEL_STRUCT_INPUT_SIZE];
+
+    g_model_state = MODEL_STATE_WEIGHTS_LOADED;
+
+    status = load_model_input(model_input, sizeof(model_input) / 2);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_WEIGHTS_LOADED, g_model_state);
+}
+
+// ========================================================
+// run_model
+// ========================================================
+
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
+/**
+ * Tests model execution for valid model states
+ */
+void test_ModelRunModelShouldRunInference(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = model_state;
+    run_inference_IgnoreAndReturn(STATUS_OK);
+
+    status = run_model();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INFERENCE_DONE, g_model_state);
+}
+
+/**
+ * Tests model execution when inference fails
+ */
+void test_ModelRunModelShouldFailIfRunInferenceFails(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INPUT_LOADED;
+    run_inference_IgnoreAndReturn(IREE_WRAPPER_STATUS_ERROR);
+
+    status = run_model();
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATE_INPUT_LOADED, g_model_state);
+}
+
+/**
+ * Tests if model execution records the inference phase
+ */
+void test_ModelRunModelShouldRecordInferencePhase(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INPUT_LOADED;
+    run_inference_IgnoreAndReturn(STATUS_OK);
+
+    status = run_model();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_INFERENCE]);
+}
+
+/**
+ * Tests if model execution does not record the failed inference
+ */
+void test_ModelRunModelShouldNotRecordFailedInference(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INPUT_LOADED;
+    run_inference_IgnoreAndReturn(IREE_WRAPPER_STATUS_ERROR);
+
+    status = run_model();
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_profiler_records[PROFILER_PHASE_INFERENCE]);
+}
+
+TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
+TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
+/**
+ * Tests model execution when model is in invalid state
+ */
+void test_ModelRunModelShouldFailIfModelIsInInvalidState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = model_state;
+
+    status = run_model();
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
+}
+
+// ========================================================
+// get_model_output_size
+// ========================================================
+
+/**
+ * Tests if get model output size returns size of all outputs
+ */
+void test_ModelGetModelOutputSizeShouldReturnOutputSize(void)
+{
+    status_t status = STATUS_OK;
+    size_t model_output_size = 0;
+
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+
+    status = get_model_output_size(&model_output_size);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STRUCT_OUTPUT_LEN * MODEL_STRUCT_OUTPUT_SIZE, model_output_size);
+}
+
+/**
+ * Tests if get model output size fails for invalid pointer
+ */
+void test_ModelGetModelOutputSizeShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_STRUCT_LOADED;
+
+    status = get_model_output_size(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+}
+
+/**
+ * Tests if get model output size fails if model struct is not loaded
+ */
+void test_ModelGetModelOutputSizeShouldFailIfModelStateIsUninitialized(void)
+{
+    status_t status = STATUS_OK;
+    size_t model_output_size = 0;
+
+    g_model_state = MODEL_STATE_UNINITIALIZED;
+
+    status = get_model_output_size(&model_output_size);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+// ========================================================
+// write_model_output
+// ========================================================
+
+/**
+ * Mocks model output writer
+ *
+ * @param data part of the model output
+ * @param data_size size of the part
+ *
+ * @returns status of the writer
+ */
+status_t mock_model_output_writer(const uint8_t *data, const size_t data_size) { return STATUS_OK; }
+
+/**
+ * Tests if write model output passes writer to IREE wrapper
+ */
+void test_ModelWriteModelOutputShouldWriteOutput(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    write_output_ExpectAndReturn(mock_model_output_writer, STATUS_OK);
+
+    status = write_model_output(mock_model_output_writer);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+/**
+ * Tests if write model output does not record the get output phase, as it is also used for internal reductions
+ */
+void test_ModelWriteModelOutputShouldNotRecordGetOutputPhase(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    write_output_ExpectAndReturn(mock_model_output_writer, STATUS_OK);
+
+    status = write_model_output(mock_model_output_writer);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if write model output fails when writing fails
+ */
+void test_ModelWriteModelOutputShouldFailIfWriteOutputFails(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    write_output_ExpectAndReturn(mock_model_output_writer, IREE_WRAPPER_STATUS_ERROR);
+
+    status = write_model_output(mock_model_output_writer);
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+}
+
+TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+TEST_CASE(1) // MODEL_STATE_STRUCT_LOADED
+TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+/**
+ * Tests if write model output fails when model is in invalid state
+ */
+void test_ModelWriteModelOutputShouldFailIfModelIsInInvalidState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = model_state;
+
+    status = write_model_output(mock_model_output_writer);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+// ========================================================
+// reduce_model_output
+// ========================================================
+
+/**
+ * Model output passed to the writer by the mocked write_output
+ */
+const uint8_t *gp_mock_model_output = NULL;
+size_t g_mock_model_output_size = 0;
+
+/**
+ * Mocks write output, the model output is passed to the writer in two parts
+ *
+ * @param writer function that consumes the output
+ * @param num_calls number of mock calls
+ *
+ * @returns status of the writer
+ */
+status_t mock_write_output(model_output_writer_t writer, int num_calls)
+{
+    status_t status = STATUS_OK;
+    size_t first_part_size =
+        g_mock_model_output_size / g_model_struct.output_size_bytes / 2 * g_model_struct.output_size_bytes;
+
+    status = writer(gp_mock_model_output, first_part_size);
+    RETURN_ON_ERROR(status, status);
+
+    return writer(gp_mock_model_output + first_part_size, g_mock_model_output_size - first_part_size);
+}
+
+/**
+ * Tests if reduce model output selects classes with the highest scores sorted by score, earlier class first on a tie
+ */
+void test_ModelReduceModelOutputShouldReturnTopClasses(void)
+{
+    status_t status = STATUS_OK;
+    float model_output[MODEL_STRUCT_OUTPUT_LEN] = {0.1F, 0.3F, 0.0F, 0.2F, 0.1F, 0.0F, 0.9F, 0.3F, 0.2F, 0.0F};
+    model_class_score_t classes[3] = {0};
+    size_t num_classes = 0;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_struct.hal_element_type = IREE_HAL_ELEMENT_TYPE_FLOAT_32;
+    gp_mock_model_output = (uint8_t *)model_output;
+    g_mock_model_output_size = sizeof(model_output);
+    write_output_StubWithCallback(mock_write_output);
+
+    status = reduce_model_output(3, -FLT_MAX, classes, &num_classes);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(3, num_classes);
+    TEST_ASSERT_EQUAL_UINT(6, classes[0].class_idx);
+    TEST_ASSERT_EQUAL_UINT(1, classes[1].class_idx);
+    TEST_ASSERT_EQUAL_UINT(7, classes[2].class_idx);
+    TEST_ASSERT_EQUAL_FLOAT(0.3F, classes[2].score);
+}
+
+/**
+ * Tests if reduce model output selects only classes which scores are not lower than the threshold
+ */
+void test_ModelReduceModelOutputShouldSkipClassesBelowThreshold(void)
+{
+    status_t status = STATUS_OK;
+    float model_output[MODEL_STRUCT_OUTPUT_LEN] = {0.1F, 0.3F, 0.0F, 0.2F, NAN, 0.0F, 0.9F, 0.3F, 0.2F, 0.0F};
+    model_class_score_t classes[MODEL_STRUCT_OUTPUT_LEN] = {0};
+    size_t num_classes = 0;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_struct.hal_element_type = IREE_HAL_ELEMENT_TYPE_FLOAT_32;
+    gp_mock_model_output = (uint8_t *)model_output;
+    g_mock_model_output_size = sizeof(model_output);
+    write_output_StubWithCallback(mock_write_output);
+
+    status = reduce_model_output(MODEL_STRUCT_OUTPUT_LEN, 0.3F, classes, &num_classes);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(3, num_classes);
+    TEST_ASSERT_EQUAL_UINT(6, classes[0].class_idx);
+    TEST_ASSERT_EQUAL_UINT(1, classes[1].class_idx);
+    TEST_ASSERT_EQUAL_UINT(7, classes[2].class_idx);
+}
+
+/**
+ * Tests if reduce model output fails for zero number of classes
+ */
+void test_ModelReduceModelOutputShouldFailForZeroMaxClasses(void)
+{
+    status_t status = STATUS_OK;
+    model_class_score_t classes[1] = {0};
+    size_t num_classes = 0;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = reduce_model_output(0, 0.0F, classes, &num_classes);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if reduce model output fails for invalid pointers
+ */
+void test_ModelReduceModelOutputShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    model_class_score_t classes[1] = {0};
+    size_t num_classes = 0;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = reduce_model_output(1, 0.0F, NULL, &num_classes);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+
+    status = reduce_model_output(1, 0.0F, classes, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// get_model_output_top_class
+// ========================================================
+
+/**
+ * Tests if get model output top class finds the highest score across parts of the model output
+ */
+void test_ModelGetModelOutputTopClassShouldReturnHighestScore(void)
+{
+    status_t status = STATUS_OK;
+    float model_output[MODEL_STRUCT_OUTPUT_LEN] = {0.1F, 0.3F, 0.0F, 0.2F, 0.1F, 0.0F, 0.9F, 0.9F, 0.2F, 0.0F};
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_struct.hal_element_type = IREE_HAL_ELEMENT_TYPE_FLOAT_32;
+    gp_mock_model_output = (uint8_t *)model_output;
+    g_mock_model_output_size = sizeof(model_output);
+    write_output_StubWithCallback(mock_write_output);
+
+    status = get_model_output_top_class(&top_class, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(6, top_class);
+    TEST_ASSERT_EQUAL_FLOAT(0.9F, top_score);
+}
+
+/**
+ * Tests if get model output top class converts integer scores
+ */
+void test_ModelGetModelOutputTopClassShouldConvertIntegerScores(void)
+{
+    status_t status = STATUS_OK;
+    int8_t model_output[] = {-128, -5, -1, -100};
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_struct.hal_element_type = IREE_HAL_ELEMENT_TYPE_INT_8;
+    g_model_struct.output_size_bytes = sizeof(int8_t);
+    gp_mock_model_output = (uint8_t *)model_output;
+    g_mock_model_output_size = sizeof(model_output);
+    write_output_StubWithCallback(mock_write_output);
+
+    status = get_model_output_top_class(&top_class, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(2, top_class);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0F, top_score);
+}
+
+TEST_CASE(8 /* IREE_HAL_ELEMENT_TYPE_FLOAT_16 */, 2)
+TEST_CASE(9 /* IREE_HAL_ELEMENT_TYPE_FLOAT_32 */, 8)
+/**
+ * Tests if get model output top class fails for unsupported element type or element size that does not match it
+ */
+void test_ModelGetModelOutputTopClassShouldFailForUnsupportedOutputElement(uint32_t element_type, uint32_t element_size)
+{
+    status_t status = STATUS_OK;
+    uint8_t model_output[16] = {0};
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    g_model_struct.hal_element_type = element_type;
+    g_model_struct.output_size_bytes = element_size;
+    gp_mock_model_output = model_output;
+    g_mock_model_output_size = sizeof(model_output);
+    write_output_StubWithCallback(mock_write_output);
+
+    status = get_model_output_top_class(&top_class, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if get model output top class fails when writing output fails
+ */
+void test_ModelGetModelOutputTopClassShouldFailIfWriteOutputFails(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+    write_output_IgnoreAndReturn(IREE_WRAPPER_STATUS_ERROR);
+
+    status = get_model_output_top_class(&top_class, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(IREE_WRAPPER_STATUS_ERROR, status);
+}
+
+TEST_CASE(0) // MODEL_STATE_UNINITIALIZED
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+/**
+ * Tests if get model output top class fails when model is in invalid state
+ */
+void test_ModelGetModelOutputTopClassShouldFailIfModelIsInInvalidState(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = model_state;
+
+    status = get_model_output_top_class(&top_class, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if get model output top class fails for invalid pointers
+ */
+void test_ModelGetModelOutputTopClassShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_class = 0;
+    float top_score = 0.0F;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = get_model_output_top_class(NULL, &top_score);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+
+    status = get_model_output_top_class(&top_class, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// get_statistics
+// ========================================================
+
+TEST_CASE(2) // MODEL_STATE_WEIGHTS_LOADED
+TEST_CASE(3) // MODEL_STATE_INPUT_LOADED
+TEST_CASE(4) // MODEL_STATE_INFERENCE_DONE
+/**
+ * Tests model get statistics for valid model states
+ */
+void test_ModelGetStatisticsShouldReturnModelStatistics(uint32_t model_state)
+{
+    status_t status = STATUS_OK;
+    uint8_t statistics_buffer[128];
+    size_t statistics_size = 0;
+
+    g_model_state = model_state;
+    get_model_stats_ExpectAndReturn(sizeof(statistics_buffer), statistics_buffer, &statistics_size, STATUS_OK);
+
+    status = get_statistics(sizeof(statistics_buffer), statistics_buffer, &statistics_size);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(model_state, g_model_state);
 }
 
 /**
@@ -755,6 +1655,13 @@ void test_ModelGetStatisticsShouldFailIfGetModelStatsFails(void)
 // helper functions
 // ========================================================
 
+status_t mock_profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp, int num_calls)
+{
+    ++g_profiler_records[phase];
+
+    return STATUS_OK;
+}
+
 MlModel get_model_struct_data(char dtype[])
 {
     MlModel model_struct = {
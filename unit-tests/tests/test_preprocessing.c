@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "../iree-runtime/utils/preprocessing.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_CASE(...)
+
+extern preprocessing_config_t g_preprocessing_config;
+extern void preprocess_block_scalar(const float *input, const size_t num_elements, const float *scale,
+                                    const float *offset, uint8_t *output);
+extern void preprocess_block_vector(const float *input, const size_t num_elements, const float *scale,
+                                    const float *offset, uint8_t *output);
+
+/**
+ * Returns example preprocessing configuration with unit scale and zero offset
+ *
+ * @param num_channels number of input channels
+ * @param output_type type of the output
+ *
+ * @returns prepared preprocessing configuration
+ */
+static preprocessing_config_t get_preprocessing_config(uint32_t num_channels, uint32_t output_type);
+
+void setUp(void) { memset(&g_preprocessing_config, 0, sizeof(g_preprocessing_config)); }
+
+void tearDown(void) {}
+
+// ========================================================
+// preprocessing_configure
+// ========================================================
+
+TEST_CASE(1, 0 /* PREPROCESSING_OUTPUT_F32 */, 4)
+TEST_CASE(8, 0 /* PREPROCESSING_OUTPUT_F32 */, 4)
+TEST_CASE(3, 1 /* PREPROCESSING_OUTPUT_I8 */, 1)
+/**
+ * Tests if preprocessing configure enables preprocessing with given output type
+ */
+void test_PreprocessingConfigureShouldEnablePreprocessing(uint32_t num_channels, uint32_t output_type,
+                                                          size_t element_size)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(num_channels, output_type);
+
+    status = preprocessing_configure(&config);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(element_size, preprocessing_get_output_element_size());
+}
+
+/**
+ * Tests if preprocessing configure with zero channels disables preprocessing
+ */
+void test_PreprocessingConfigureShouldDisablePreprocessingForZeroChannels(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(2, PREPROCESSING_OUTPUT_F32);
+
+    preprocessing_configure(&config);
+    config.num_channels = 0;
+
+    status = preprocessing_configure(&config);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, preprocessing_get_output_element_size());
+}
+
+TEST_CASE(9, 0 /* PREPROCESSING_OUTPUT_F32 */)
+TEST_CASE(1, 2 /* NUM_PREPROCESSING_OUTPUTS */)
+/**
+ * Tests if preprocessing configure fails for invalid number of channels or output type
+ */
+void test_PreprocessingConfigureShouldFailForInvalidArgument(uint32_t num_channels, uint32_t output_type)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(num_channels, output_type);
+
+    status = preprocessing_configure(&config);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(0, preprocessing_get_output_element_size());
+}
+
+/**
+ * Tests if preprocessing configure fails for empty clamp range
+ */
+void test_PreprocessingConfigureShouldFailForEmptyClampRange(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(1, PREPROCESSING_OUTPUT_I8);
+
+    config.clamp_min = 200.0F;
+
+    status = preprocessing_configure(&config);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if preprocessing configure fails for invalid pointer
+ */
+void test_PreprocessingConfigureShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = preprocessing_configure(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// preprocess
+// ========================================================
+
+TEST_CASE(0)
+TEST_CASE(1)
+TEST_CASE(5)
+/**
+ * Tests if preprocess applies per-channel scale and offset, starting from the channel of the first element
+ */
+void test_PreprocessShouldApplyPerChannelScaleAndOffset(size_t first_element)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(3, PREPROCESSING_OUTPUT_F32);
+    float input[150];
+    float output[150];
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        config.scale[i] = (float)(i + 1);
+        config.offset[i] = -(float)i;
+    }
+    for (size_t i = 0; i < sizeof(input) / sizeof(float); ++i)
+    {
+        input[i] = (float)i;
+    }
+    preprocessing_configure(&config);
+
+    status = preprocess(input, sizeof(input) / sizeof(float), first_element, (uint8_t *)output);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    for (size_t i = 0; i < sizeof(input) / sizeof(float); ++i)
+    {
+        size_t channel = (first_element + i) % 3;
+        TEST_ASSERT_EQUAL_FLOAT(input[i] * config.scale[channel] + config.offset[channel], output[i]);
+    }
+}
+
+/**
+ * Tests if preprocess clamps values to the configured range, NaN being clamped to the lower bound
+ */
+void test_PreprocessShouldClampValues(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(1, PREPROCESSING_OUTPUT_F32);
+    float input[] = {-2.0F, -1.0F, 0.5F, 1.0F, 2.0F, NAN, -INFINITY, INFINITY};
+    float expected_output[] = {-1.0F, -1.0F, 0.5F, 1.0F, 1.0F, -1.0F, -1.0F, 1.0F};
+    float output[sizeof(input) / sizeof(float)];
+
+    config.clamp_min = -1.0F;
+    config.clamp_max = 1.0F;
+    preprocessing_configure(&config);
+
+    status = preprocess(input, sizeof(input) / sizeof(float), 0, (uint8_t *)output);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected_output, output, sizeof(input) / sizeof(float));
+}
+
+/**
+ * Tests if preprocess quantizes values to int8, rounding to the nearest with ties to even and saturating
+ */
+void test_PreprocessShouldQuantizeValuesToInt8(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = get_preprocessing_config(1, PREPROCESSING_OUTPUT_I8);
+    float input[] = {0.4F, 0.5F, 1.5F, -2.5F, -0.6F, 127.4F, 300.0F, -300.0F, NAN};
+    int8_t expected_output[] = {0, 0, 2, -2, -1, 127, 127, -128, -128};
+    int8_t output[sizeof(input) / sizeof(float)];
+
+    preprocessing_configure(&config);
+
+    status = preprocess(input, sizeof(input) / sizeof(float), 0, (uint8_t *)output);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(expected_output, output, sizeof(input) / sizeof(float));
+}
+
+/**
+ * Tests if preprocess fails if preprocessing is disabled
+ */
+void test_PreprocessShouldFailIfPreprocessingIsDisabled(void)
+{
+    status_t status = STATUS_OK;
+    float input[4] = {0};
+    float output[4];
+
+    status = preprocess(input, 4, 0, (uint8_t *)output);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_UNINIT, status);
+}
+
+/**
+ * Tests if preprocess fails for invalid pointers
+ */
+void test_PreprocessShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    float data[4] = {0};
+
+    status = preprocess(NULL, 4, 0, (uint8_t *)data);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_PTR, status);
+
+    status = preprocess(data, 4, 0, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// preprocess_block_vector
+// ========================================================
+
+TEST_CASE(0 /* PREPROCESSING_OUTPUT_F32 */, 4)
+TEST_CASE(1 /* PREPROCESSING_OUTPUT_I8 */, 1)
+/**
+ * Tests if the RISC-V vector path gives the same results as the scalar one, including clamping, NaN and rounding ties.
+ * The vector intrinsics are emulated on the host, with the vector length shorter than the block
+ */
+void test_PreprocessBlockVectorShouldMatchScalarPath(uint32_t output_type, size_t element_size)
+{
+    preprocessing_config_t config = get_preprocessing_config(1, output_type);
+    float input[61];
+    float scale[61];
+    float offset[61];
+    uint8_t scalar_output[sizeof(input)];
+    uint8_t vector_output[sizeof(input)];
+
+    // values are exact in float, so that the fused multiply-add of the vector path does not change them
+    for (size_t i = 0; i < sizeof(input) / sizeof(float); ++i)
+    {
+        input[i] = ((float)i - 30.0F) * 2.25F;
+        scale[i] = (float[]){0.75F, -1.5F, 2.0F}[i % 3];
+        offset[i] = (float[]){0.125F, -3.0F, 0.5F}[i % 3];
+    }
+    input[7] = NAN;
+    input[20] = INFINITY;
+    input[33] = -INFINITY;
+    config.clamp_min = -100.0F;
+    config.clamp_max = 90.0F;
+    preprocessing_configure(&config);
+    memset(scalar_output, 0, sizeof(scalar_output));
+    memset(vector_output, 0xFF, sizeof(vector_output));
+
+    preprocess_block_scalar(input, sizeof(input) / sizeof(float), scale, offset, scalar_output);
+    preprocess_block_vector(input, sizeof(input) / sizeof(float), scale, offset, vector_output);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(scalar_output, vector_output, sizeof(input) / sizeof(float) * element_size);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static preprocessing_config_t get_preprocessing_config(uint32_t num_channels, uint32_t output_type)
+{
+    preprocessing_config_t config = {0};
+
+    config.num_channels = num_channels;
+    config.output_type = output_type;
+    for (size_t i = 0; i < PREPROCESSING_MAX_CHANNELS; ++i)
+    {
+        config.scale[i] = 1.0F;
+        config.offset[i] = 0.0F;
+    }
+    config.clamp_min = -INFINITY;
+    config.clamp_max = INFINITY;
+
+    return config;
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "../iree-runtime/utils/profiler.h"
+#include "mock_interrupts.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define TEST_CASE(...)
+
+#define MAX_CSR_READS (2 * NUM_PROFILER_COUNTERS)
+
+uint32_t g_mock_csr = 0;
+uint32_t g_csr_values[MAX_CSR_READS];
+size_t g_csr_read_idx = 0;
+
+/**
+ * Callback that is called every read from CSR. It sets the value of the next read
+ */
+void mock_csr_read_callback();
+
+/**
+ * Sets values of the counters read at the beginning and at the end of the phase
+ *
+ * @param start values of the counters at the beginning of the phase
+ * @param end values of the counters at the end of the phase
+ */
+static void set_counters(const uint32_t start[NUM_PROFILER_COUNTERS], const uint32_t end[NUM_PROFILER_COUNTERS]);
+
+/**
+ * Records phase with given counters deltas
+ *
+ * @param phase recorded phase
+ * @param cycles cycle counter delta
+ * @param time time counter delta
+ * @param instret instret counter delta
+ */
+static void record_phase(PROFILER_PHASE phase, uint32_t cycles, uint32_t time, uint32_t instret);
+
+/**
+ * Returns statistics of given phase
+ *
+ * @param phase phase
+ *
+ * @returns statistics of the phase
+ */
+static profiler_phase_stats_t get_phase_stats(PROFILER_PHASE phase);
+
+void setUp(void)
+{
+    memset(g_csr_values, 0, sizeof(g_csr_values));
+    g_csr_read_idx = 0;
+    g_mock_csr = 0;
+    interrupts_lock_IgnoreAndReturn(MSTATUS_MIE);
+    interrupts_unlock_Ignore();
+    profiler_reset();
+}
+
+void tearDown(void) {}
+
+// ========================================================
+// profiler_start
+// ========================================================
+
+/**
+ * Tests if profiler start reads cycle, time and instret counters
+ */
+void test_ProfilerStartShouldReadCounters(void)
+{
+    profiler_timestamp_t timestamp = {0};
+    uint32_t start[NUM_PROFILER_COUNTERS] = {0x100, 0x10, 0x80};
+
+    set_counters(start, start);
+
+    profiler_start(&timestamp);
+
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(start, timestamp.counters, NUM_PROFILER_COUNTERS);
+}
+
+// ========================================================
+// profiler_record
+// ========================================================
+
+/**
+ * Tests if profiler record updates running min, avg and max of the counters deltas
+ */
+void test_ProfilerRecordShouldUpdateMinAvgMax(void)
+{
+    profiler_phase_stats_t stats = {0};
+
+    record_phase(PROFILER_PHASE_INFERENCE, 1000, 40, 600);
+    record_phase(PROFILER_PHASE_INFERENCE, 3000, 120, 1800);
+    record_phase(PROFILER_PHASE_INFERENCE, 2000, 80, 1200);
+
+    stats = get_phase_stats(PROFILER_PHASE_INFERENCE);
+
+    TEST_ASSERT_EQUAL_UINT(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT(1000, stats.counters[PROFILER_COUNTER_CYCLE].min);
+    TEST_ASSERT_EQUAL_UINT(2000, stats.counters[PROFILER_COUNTER_CYCLE].avg);
+    TEST_ASSERT_EQUAL_UINT(3000, stats.counters[PROFILER_COUNTER_CYCLE].max);
+    TEST_ASSERT_EQUAL_UINT(40, stats.counters[PROFILER_COUNTER_TIME].min);
+    TEST_ASSERT_EQUAL_UINT(80, stats.counters[PROFILER_COUNTER_TIME].avg);
+    TEST_ASSERT_EQUAL_UINT(120, stats.counters[PROFILER_COUNTER_TIME].max);
+    TEST_ASSERT_EQUAL_UINT(600, stats.counters[PROFILER_COUNTER_INSTRET].min);
+    TEST_ASSERT_EQUAL_UINT(1200, stats.counters[PROFILER_COUNTER_INSTRET].avg);
+    TEST_ASSERT_EQUAL_UINT(1800, stats.counters[PROFILER_COUNTER_INSTRET].max);
+}
+
+/**
+ * Tests if profiler record computes deltas of the overflowed counters
+ */
+void test_ProfilerRecordShouldHandleCounterOverflow(void)
+{
+    profiler_timestamp_t timestamp = {0};
+    profiler_phase_stats_t stats = {0};
+    uint32_t start[NUM_PROFILER_COUNTERS] = {0xFFFFFFF0, 0xFFFFFFFF, 0xFFFFFF00};
+    uint32_t end[NUM_PROFILER_COUNTERS] = {0x10, 0x1, 0x100};
+
+    set_counters(start, end);
+    profiler_start(&timestamp);
+
+    profiler_record(PROFILER_PHASE_RECEIVE, &timestamp);
+
+    stats = get_phase_stats(PROFILER_PHASE_RECEIVE);
+    TEST_ASSERT_EQUAL_UINT(0x20, stats.counters[PROFILER_COUNTER_CYCLE].max);
+    TEST_ASSERT_EQUAL_UINT(0x2, stats.counters[PROFILER_COUNTER_TIME].max);
+    TEST_ASSERT_EQUAL_UINT(0x200, stats.counters[PROFILER_COUNTER_INSTRET].max);
+}
+
+TEST_CASE(0, 0)
+TEST_CASE(3, 0)
+TEST_CASE(4, 1)
+TEST_CASE(15, 1)
+TEST_CASE(16, 2)
+TEST_CASE(100000, 8)
+TEST_CASE(0xFFFFFFFF, 15)
+/**
+ * Tests if profiler record counts the phase in the histogram bin of its cycles
+ */
+void test_ProfilerRecordShouldUpdateCyclesHistogram(uint32_t cycles, uint32_t bin)
+{
+    profiler_phase_stats_t stats = {0};
+    uint32_t expected_histogram[PROFILER_HISTOGRAM_BINS] = {0};
+
+    expected_histogram[bin] = 2;
+
+    record_phase(PROFILER_PHASE_SEND, cycles, 0, 0);
+    record_phase(PROFILER_PHASE_SEND, cycles, 0, 0);
+
+    stats = get_phase_stats(PROFILER_PHASE_SEND);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected_histogram, stats.cycles_histogram, PROFILER_HISTOGRAM_BINS);
+}
+
+/**
+ * Tests if profiler record does not affect other phases
+ */
+void test_ProfilerRecordShouldNotAffectOtherPhases(void)
+{
+    profiler_phase_stats_t stats = {0};
+    profiler_phase_stats_t empty_stats = {0};
+
+    record_phase(PROFILER_PHASE_LOAD_INPUT, 1000, 40, 600);
+
+    stats = get_phase_stats(PROFILER_PHASE_GET_OUTPUT);
+
+    TEST_ASSERT_EQUAL_MEMORY(&empty_stats, &stats, sizeof(profiler_phase_stats_t));
+}
+
+/**
+ * Tests if profiler record fails for invalid phase
+ */
+void test_ProfilerRecordShouldFailForInvalidPhase(void)
+{
+    status_t status = STATUS_OK;
+    profiler_timestamp_t timestamp = {0};
+
+    status = profiler_record(NUM_PROFILER_PHASES, &timestamp);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if profiler record fails for invalid pointer
+ */
+void test_ProfilerRecordShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = profiler_record(PROFILER_PHASE_INFERENCE, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// profiler_get_stats
+// ========================================================
+
+/**
+ * Tests if profiler get stats writes statistics of all phases, zeroed for phases that were not recorded
+ */
+void test_ProfilerGetStatsShouldWriteStatsOfAllPhases(void)
+{
+    status_t status = STATUS_OK;
+    profiler_phase_stats_t stats[NUM_PROFILER_PHASES];
+    profiler_phase_stats_t empty_stats = {0};
+    size_t stats_size = 0;
+
+    memset(stats, 0xFF, sizeof(stats));
+
+    status = profiler_get_stats(sizeof(stats), (uint8_t *)stats, &stats_size);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(sizeof(stats), stats_size);
+    for (size_t i = 0; i < NUM_PROFILER_PHASES; ++i)
+    {
+        TEST_ASSERT_EQUAL_MEMORY(&empty_stats, &stats[i], sizeof(profiler_phase_stats_t));
+    }
+}
+
+/**
+ * Tests if profiler get stats writes statistics into the unaligned buffer
+ */
+void test_ProfilerGetStatsShouldWriteStatsIntoUnalignedBuffer(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t) + 1];
+    profiler_phase_stats_t stats = {0};
+    size_t stats_size = 0;
+
+    record_phase(PROFILER_PHASE_SEND, 1000, 40, 600);
+
+    status = profiler_get_stats(sizeof(buffer) - 1, &buffer[1], &stats_size);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    memcpy(&stats, &buffer[1 + PROFILER_PHASE_SEND * sizeof(profiler_phase_stats_t)], sizeof(stats));
+    TEST_ASSERT_EQUAL_UINT(1, stats.count);
+    TEST_ASSERT_EQUAL_UINT(1000, stats.counters[PROFILER_COUNTER_CYCLE].avg);
+}
+
+/**
+ * Tests if profiler get stats fails if the buffer is too small
+ */
+void test_ProfilerGetStatsShouldFailIfBufferIsTooSmall(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t)];
+    size_t stats_size = 0;
+
+    status = profiler_get_stats(sizeof(buffer) - 1, buffer, &stats_size);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if profiler get stats fails for invalid pointers
+ */
+void test_ProfilerGetStatsShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t)];
+    size_t stats_size = 0;
+
+    status = profiler_get_stats(sizeof(buffer), NULL, &stats_size);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_PTR, status);
+
+    status = profiler_get_stats(sizeof(buffer), buffer, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// profiler_reset
+// ========================================================
+
+/**
+ * Tests if profiler reset clears statistics of all phases
+ */
+void test_ProfilerResetShouldClearStats(void)
+{
+    profiler_phase_stats_t stats = {0};
+    profiler_phase_stats_t empty_stats = {0};
+
+    record_phase(PROFILER_PHASE_INFERENCE, 1000, 40, 600);
+
+    profiler_reset();
+
+    stats = get_phase_stats(PROFILER_PHASE_INFERENCE);
+    TEST_ASSERT_EQUAL_MEMORY(&empty_stats, &stats, sizeof(profiler_phase_stats_t));
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+void mock_csr_read_callback()
+{
+    if (g_csr_read_idx + 1 < MAX_CSR_READS)
+    {
+        g_mock_csr = g_csr_values[++g_csr_read_idx];
+    }
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void set_counters(const uint32_t start[NUM_PROFILER_COUNTERS], const uint32_t end[NUM_PROFILER_COUNTERS])
+{
+    memcpy(&g_csr_values[0], start, NUM_PROFILER_COUNTERS * sizeof(uint32_t));
+    memcpy(&g_csr_values[NUM_PROFILER_COUNTERS], end, NUM_PROFILER_COUNTERS * sizeof(uint32_t));
+    g_csr_read_idx = 0;
+    g_mock_csr = g_csr_values[0];
+}
+
+static void record_phase(PROFILER_PHASE phase, uint32_t cycles, uint32_t time, uint32_t instret)
+{
+    profiler_timestamp_t timestamp = {0};
+    uint32_t start[NUM_PROFILER_COUNTERS] = {0x1000, 0x100, 0x800};
+    uint32_t end[NUM_PROFILER_COUNTERS] = {0x1000 + cycles, 0x100 + time, 0x800 + instret};
+
+    set_counters(start, end);
+    profiler_start(&timestamp);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, profiler_record(phase, &timestamp));
+}
+
+static profiler_phase_stats_t get_phase_stats(PROFILER_PHASE phase)
+{
+    profiler_phase_stats_t stats[NUM_PROFILER_PHASES];
+    size_t stats_size = 0;
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, profiler_get_stats(sizeof(stats), (uint8_t *)stats, &stats_size));
+
+    return stats[phase];
+}
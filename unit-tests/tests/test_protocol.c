@@ -13,8 +13,12 @@
 #define TEST_CASE(...)
 
 extern uint8_t g_message_buffer[];
+extern message_buffer_provider_t g_message_buffer_providers[];
+extern volatile bool g_message_buffer_queued;
+uint8_t g_provided_buffer[128];
 message_t *gp_message = NULL;
 uint8_t *gp_uart_buffer = NULL;
+uart_write_callback_t g_uart_write_callback = NULL;
 
 /**
  * Mocks UART read function
@@ -38,6 +42,27 @@ status_t mock_uart_read(uint8_t *data, size_t data_length, int num_calls);
  */
 status_t mock_uart_write(const uint8_t *data, size_t data_length, int num_calls);
 
+/**
+ * Mocks UART asynchronous write function. It stores the callback in g_uart_write_callback instead of calling it
+ *
+ * @param data buffer to be written
+ * @param data_length length of the buffer
+ * @param callback function called when the buffer can be reused
+ * @param num_calls number of mock calls
+ *
+ * @returns status of write action
+ */
+status_t mock_uart_write_async(const uint8_t *data, size_t data_length, uart_write_callback_t callback, int num_calls);
+
+/**
+ * Mocks UART flush function. It calls the stored write callback
+ *
+ * @param num_calls number of mock calls
+ *
+ * @returns status of flush
+ */
+status_t mock_uart_flush(int num_calls);
+
 /**
  * Prepares message of given type and payload and store result in gp_message
  *
@@ -47,6 +72,24 @@ status_t mock_uart_write(const uint8_t *data, size_t data_length, int num_calls)
  */
 void prepare_message(message_type_t msg_type, uint8_t *payload, size_t payload_size);
 
+/**
+ * Mocks message buffer provider that returns g_provided_buffer
+ *
+ * @param msg_size size of the message
+ *
+ * @returns pointer to the message buffer
+ */
+message_t *mock_message_buffer_provider(const message_size_t msg_size);
+
+/**
+ * Mocks message buffer provider that does not provide any buffer
+ *
+ * @param msg_size size of the message
+ *
+ * @returns NULL
+ */
+message_t *mock_message_buffer_provider_null(const message_size_t msg_size);
+
 void setUp(void)
 {
     uart_read_StubWithCallback(mock_uart_read);
@@ -65,6 +108,9 @@ void tearDown(void)
         free(gp_uart_buffer);
         gp_uart_buffer = NULL;
     }
+    memset(g_message_buffer_providers, 0, NUM_MESSAGE_TYPES * sizeof(message_buffer_provider_t));
+    g_message_buffer_queued = false;
+    g_uart_write_callback = NULL;
 }
 
 // ========================================================
@@ -115,6 +161,47 @@ void test_ProtocolReceiveMessageShouldReadMessageWithPayloadFromUART(uint32_t me
     TEST_ASSERT_EQUAL_UINT8_ARRAY(message_data, msg->payload, sizeof(message_data));
 }
 
+/**
+ * Tests if protocol receive message reads message into the buffer given by registered provider
+ */
+void test_ProtocolReceiveMessageShouldReadMessageIntoProvidedBuffer(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t message_data[] = "some data";
+    message_t *msg;
+
+    prepare_message(MESSAGE_TYPE_MODEL, message_data, sizeof(message_data));
+    g_message_buffer_providers[MESSAGE_TYPE_MODEL] = mock_message_buffer_provider;
+
+    status = receive_message(&msg);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_DATA_READY, status);
+    TEST_ASSERT_EQUAL_PTR(g_provided_buffer, msg);
+    TEST_ASSERT_EQUAL_UINT(gp_message->message_size, msg->message_size);
+    TEST_ASSERT_EQUAL_UINT(gp_message->message_type, msg->message_type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(message_data, msg->payload, sizeof(message_data));
+}
+
+/**
+ * Tests if protocol receive message falls back to the default buffer if provider does not give any buffer
+ */
+void test_ProtocolReceiveMessageShouldReadMessageIntoDefaultBufferIfProviderFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t message_data[] = "some data";
+    message_t *msg;
+
+    prepare_message(MESSAGE_TYPE_MODEL, message_data, sizeof(message_data));
+    g_message_buffer_providers[MESSAGE_TYPE_MODEL] = mock_message_buffer_provider_null;
+
+    status = receive_message(&msg);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_DATA_READY, status);
+    TEST_ASSERT_TRUE((uint8_t *)msg != g_provided_buffer);
+    TEST_ASSERT_EQUAL_UINT(gp_message->message_size, msg->message_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(message_data, msg->payload, sizeof(message_data));
+}
+
 /**
  * Tests if protocol receive message fails for invalid pointer
  */
@@ -259,6 +346,150 @@ void test_ProtocolSendMessageShouldFailIfUARTWriteFails(void)
     TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_TIMEOUT, status);
 }
 
+// ========================================================
+// send_message_header
+// ========================================================
+
+/**
+ * Tests if protocol send message header writes header of the message with given payload size to UART
+ */
+void test_ProtocolSendMessageHeaderShouldWriteHeaderToUART(void)
+{
+    status_t status = STATUS_OK;
+    message_t *msg = NULL;
+
+    status = send_message_header(MESSAGE_TYPE_OK, 40);
+
+    msg = (message_t *)gp_uart_buffer;
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(sizeof(message_type_t) + 40, msg->message_size);
+    TEST_ASSERT_EQUAL_UINT(MESSAGE_TYPE_OK, msg->message_type);
+}
+
+/**
+ * Tests if protocol send message header fails if UART write fails
+ */
+void test_ProtocolSendMessageHeaderShouldFailIfUARTWriteFails(void)
+{
+    status_t status = STATUS_OK;
+
+    uart_write_IgnoreAndReturn(UART_STATUS_INV_PTR);
+
+    status = send_message_header(MESSAGE_TYPE_OK, 40);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_CLIENT_DISCONNECTED, status);
+}
+
+// ========================================================
+// send_message_payload
+// ========================================================
+
+/**
+ * Tests if protocol send message payload writes payload to UART
+ */
+void test_ProtocolSendMessagePayloadShouldWritePayloadToUART(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t payload[] = "some data";
+
+    status = send_message_payload(payload, sizeof(payload));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, gp_uart_buffer, sizeof(payload));
+}
+
+/**
+ * Tests if protocol send message payload fails for invalid pointer
+ */
+void test_ProtocolSendMessagePayloadShouldFailIfPayloadPointerIsInvalid(void)
+{
+    status_t status = STATUS_OK;
+
+    status = send_message_payload(NULL, 0);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// send_message_async
+// ========================================================
+
+/**
+ * Tests if protocol send message async queues the message without copying it
+ */
+void test_ProtocolSendMessageAsyncShouldQueueMessage(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_OK, NULL, 0);
+    uart_write_async_ExpectAndReturn((uint8_t *)gp_message, MESSAGE_SIZE_FULL(gp_message->message_size), NULL,
+                                     STATUS_OK);
+
+    status = send_message_async(gp_message, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_FALSE(g_message_buffer_queued);
+}
+
+/**
+ * Tests if protocol does not reuse default message buffer until the message queued from it is sent
+ */
+void test_ProtocolSendMessageAsyncShouldProtectDefaultMessageBuffer(void)
+{
+    status_t status = STATUS_OK;
+    message_t *response = NULL;
+
+    uart_write_async_StubWithCallback(mock_uart_write_async);
+    uart_flush_StubWithCallback(mock_uart_flush);
+    prepare_success_response(&response);
+
+    status = send_message_async(response, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_TRUE(g_message_buffer_queued);
+
+    status = prepare_failure_response(&response);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_FALSE(g_message_buffer_queued);
+    TEST_ASSERT_EQUAL_UINT(MESSAGE_TYPE_ERROR, response->message_type);
+}
+
+/**
+ * Tests if protocol send message async fails if UART write fails
+ */
+void test_ProtocolSendMessageAsyncShouldFailIfUARTWriteFails(void)
+{
+    status_t status = STATUS_OK;
+    message_t *response = NULL;
+
+    prepare_success_response(&response);
+    uart_write_async_IgnoreAndReturn(UART_STATUS_UNINIT);
+
+    status = send_message_async(response, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_CLIENT_DISCONNECTED, status);
+    TEST_ASSERT_FALSE(g_message_buffer_queued);
+}
+
+// ========================================================
+// flush_messages
+// ========================================================
+
+/**
+ * Tests if protocol flush messages fails if UART flush fails
+ */
+void test_ProtocolFlushMessagesShouldFailIfUARTFlushFails(void)
+{
+    status_t status = STATUS_OK;
+
+    uart_flush_ExpectAndReturn(UART_STATUS_UNINIT);
+
+    status = flush_messages();
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_CLIENT_DISCONNECTED, status);
+}
+
 // ========================================================
 // prepare_success_response
 // ========================================================
@@ -321,10 +552,43 @@ void test_ProtocolPrepareFailureResponseShouldFailIfThePointerIsInvalid(void)
     TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_INV_PTR, status);
 }
 
+// ========================================================
+// register_message_buffer_provider
+// ========================================================
+
+/**
+ * Tests if register message buffer provider stores provider for given message type
+ */
+void test_ProtocolRegisterMessageBufferProviderShouldStoreProvider(void)
+{
+    status_t status = STATUS_OK;
+
+    status = register_message_buffer_provider(MESSAGE_TYPE_MODEL, mock_message_buffer_provider);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(mock_message_buffer_provider, g_message_buffer_providers[MESSAGE_TYPE_MODEL]);
+}
+
+/**
+ * Tests if register message buffer provider fails for invalid message type
+ */
+void test_ProtocolRegisterMessageBufferProviderShouldFailForInvalidMessageType(void)
+{
+    status_t status = STATUS_OK;
+
+    status = register_message_buffer_provider(NUM_MESSAGE_TYPES, mock_message_buffer_provider);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_INV_ARG, status);
+}
+
 // ========================================================
 // mocks
 // ========================================================
 
+message_t *mock_message_buffer_provider(const message_size_t msg_size) { return (message_t *)g_provided_buffer; }
+
+message_t *mock_message_buffer_provider_null(const message_size_t msg_size) { return NULL; }
+
 status_t mock_uart_read(uint8_t *data, size_t data_length, int num_calls)
 {
     static size_t data_read = 0;
@@ -364,6 +628,24 @@ status_t mock_uart_write(const uint8_t *data, size_t data_length, int num_calls)
     return STATUS_OK;
 }
 
+status_t mock_uart_write_async(const uint8_t *data, size_t data_length, uart_write_callback_t callback, int num_calls)
+{
+    g_uart_write_callback = callback;
+
+    return STATUS_OK;
+}
+
+status_t mock_uart_flush(int num_calls)
+{
+    if (IS_VALID_POINTER(g_uart_write_callback))
+    {
+        g_uart_write_callback(NULL, 0);
+        g_uart_write_callback = NULL;
+    }
+
+    return STATUS_OK;
+}
+
 // ========================================================
 // helper functions
 // ========================================================
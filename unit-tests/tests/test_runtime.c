@@ -7,9 +7,14 @@
 #include "../iree-runtime/iree_runtime.c"
 #include "../iree-runtime/iree_runtime.h"
 #include "mock_i2c.h"
+#include "mock_input_reader.h"
+#include "mock_interrupts.h"
 #include "mock_model.h"
+#include "mock_preprocessing.h"
+#include "mock_profiler.h"
 #include "mock_protocol.h"
 #include "mock_sensor.h"
+#include "mock_timer.h"
 #include "mock_uart.h"
 #include "mock_utils.h"
 #include "mocks/sensor_mock.h"
@@ -24,12 +29,22 @@ status_t g_sensor_init_ret = STATUS_OK;
 message_t *gp_message = NULL;
 message_t *gp_message_sent = NULL;
 message_t *gp_message_to_receive = NULL;
+uint32_t g_mock_csr = 0;
+/**
+ * Number of records of each phase passed to the mocked profiler
+ */
+uint32_t g_profiler_records[NUM_PROFILER_PHASES];
 
 GENERATE_MODULE_STATUSES_STR(MODEL);
 GENERATE_MODULE_STATUSES_STR(PROTOCOL);
 const char *const MESSAGE_TYPE_STR[] = {MESSAGE_TYPES(GENERATE_STR)};
 
 #define SENSOR_DEFAULT_READ_DELAY (0.0001f)
+#define INFERENCE_CYCLES (1000)
+#define MODEL_STATS_SIZE (24)
+#define MODEL_STATS_BYTE (0xA5)
+#define PROFILER_STATS_SIZE (NUM_PROFILER_PHASES * sizeof(profiler_phase_stats_t))
+#define PROFILER_STATS_BYTE (0x5A)
 
 /**
  * Prepares message of given type and payload
@@ -41,6 +56,11 @@ const char *const MESSAGE_TYPE_STR[] = {MESSAGE_TYPES(GENERATE_STR)};
  */
 void prepare_message(message_type_t msg_type, uint8_t *payload, size_t payload_size, message_t **msg);
 
+/**
+ * Callback that is called every read from timer register
+ */
+void mock_csr_read_callback();
+
 /**
  * Mock of get status str
  *
@@ -70,6 +90,63 @@ status_t mock_receive_message(message_t **msg, int num_calls);
  */
 status_t mock_send_message(const message_t *msg, int num_calls);
 
+/**
+ * Mocks asynchronous send message function, the message is captured as it would be sent immediately
+ *
+ * @param msg message to be sent
+ * @param callback function called when the message is sent
+ * @param num_calls number of mock calls
+ *
+ * @returns status of the protocol
+ */
+status_t mock_send_message_async(const message_t *msg, message_sent_callback_t callback, int num_calls);
+
+/**
+ * Mock of profiler record function. Counts records of each phase
+ *
+ * @param phase recorded phase
+ * @param timestamp values of the counters at the beginning of the phase
+ * @param num_calls number of mock calls
+ *
+ * @returns error status of the profiler
+ */
+status_t mock_profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp, int num_calls);
+
+/**
+ * Mock of get statistics function. Writes model statistics of size MODEL_STATS_SIZE filled with MODEL_STATS_BYTE
+ *
+ * @param statistics_buffer_size size of the buffer
+ * @param statistics_buffer buffer for the statistics
+ * @param statistics_size returned size of the statistics
+ * @param num_calls number of mock calls
+ *
+ * @returns status of the model
+ */
+status_t mock_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer, size_t *statistics_size,
+                             int num_calls);
+
+/**
+ * Mock of profiler get stats function. Writes statistics of size PROFILER_STATS_SIZE filled with PROFILER_STATS_BYTE
+ *
+ * @param buffer_size size of the buffer
+ * @param buffer buffer for the statistics
+ * @param stats_size returned size of the statistics
+ * @param num_calls number of mock calls
+ *
+ * @returns error status of the profiler
+ */
+status_t mock_profiler_get_stats(const size_t buffer_size, uint8_t *buffer, size_t *stats_size, int num_calls);
+
+/**
+ * Mock of run model function that advances the cycle counter as if the inference took INFERENCE_CYCLES cycles
+ *
+ * @param num_calls number of mock calls
+ *
+ * @returns status of the model
+ */
+status_t mock_run_model(int num_calls);
+status_t mock_flush_messages(int num_calls);
+
 /**
  * Mock of runtime callback without response
  *
@@ -116,7 +193,26 @@ void setUp(void)
     g_uart_init_ret = STATUS_OK;
     g_i2c_init_ret = STATUS_OK;
     g_sensor_init_ret = STATUS_OK;
+    g_fallback_baudrate = 0;
+    g_idle_enabled = false;
+    g_result_ring_head = 0;
+    g_result_ring_count = 0;
+    g_result_mode = RESULT_MODE_OFF;
+    g_last_pushed_class = RESULT_NO_CLASS;
+    g_model_output_parts_queued = 0;
+    g_model_output_parts_sent = 0;
+    g_mock_csr = 0;
     get_status_str_StubWithCallback(mock_get_status_str);
+    register_message_buffer_provider_IgnoreAndReturn(STATUS_OK);
+    interrupts_init_IgnoreAndReturn(STATUS_OK);
+    interrupts_register_handler_IgnoreAndReturn(STATUS_OK);
+    interrupts_enable_IgnoreAndReturn(STATUS_OK);
+    uart_irq_enable_IgnoreAndReturn(STATUS_OK);
+    timer_init_IgnoreAndReturn(STATUS_OK);
+    sensor_start_sampling_IgnoreAndReturn(STATUS_OK);
+    memset(g_profiler_records, 0, sizeof(g_profiler_records));
+    profiler_start_Ignore();
+    profiler_record_StubWithCallback(mock_profiler_record);
 }
 
 void tearDown(void)
@@ -172,6 +268,60 @@ void test_RuntimeInitServerShouldFailIfInitUARTFails(status_t uart_error)
     TEST_ASSERT_FALSE(status);
 }
 
+/**
+ * Tests if init server switches UART to interrupt-driven mode
+ */
+void test_RuntimeInitServerShouldEnableUARTInterrupts()
+{
+    bool status = true;
+
+    interrupts_init_ExpectAndReturn(STATUS_OK);
+    interrupts_register_handler_ExpectAndReturn(INTERRUPT_SOURCE_MACHINE_EXTERNAL, uart_irq_handler, STATUS_OK);
+    uart_irq_enable_ExpectAndReturn(STATUS_OK);
+    interrupts_enable_ExpectAndReturn(INTERRUPT_SOURCE_MACHINE_EXTERNAL, STATUS_OK);
+    timer_init_ExpectAndReturn(STATUS_OK);
+    interrupts_register_handler_ExpectAndReturn(INTERRUPT_SOURCE_MACHINE_TIMER, timer_irq_handler, STATUS_OK);
+    interrupts_enable_ExpectAndReturn(INTERRUPT_SOURCE_MACHINE_TIMER, STATUS_OK);
+
+    status = init_server();
+
+    TEST_ASSERT_TRUE(status);
+    TEST_ASSERT_TRUE(g_idle_enabled);
+}
+
+TEST_CASE(TIMER_STATUS_UNINIT)
+TEST_CASE(TIMER_STATUS_INV_PTR)
+/**
+ * Tests if init server fails when timer init fails
+ */
+void test_RuntimeInitServerShouldFailIfInitTimerFails(status_t timer_error)
+{
+    bool status = true;
+
+    timer_init_ExpectAndReturn(timer_error);
+
+    status = init_server();
+
+    TEST_ASSERT_FALSE(status);
+    TEST_ASSERT_FALSE(g_idle_enabled);
+}
+
+TEST_CASE(INTERRUPTS_STATUS_INV_SOURCE)
+TEST_CASE(INTERRUPTS_STATUS_UNINIT)
+/**
+ * Tests if init server fails when enabling UART interrupt fails
+ */
+void test_RuntimeInitServerShouldFailIfEnablingUARTInterruptFails(status_t interrupts_error)
+{
+    bool status = true;
+
+    interrupts_enable_ExpectAndReturn(INTERRUPT_SOURCE_MACHINE_EXTERNAL, interrupts_error);
+
+    status = init_server();
+
+    TEST_ASSERT_FALSE(status);
+}
+
 TEST_CASE(I2C_STATUS_INV_PTR)
 TEST_CASE(I2C_STATUS_INV_ARG)
 /**
@@ -204,6 +354,205 @@ void test_RuntimeInitServerShouldFailIfInitSensorFails(status_t sensor_error)
     TEST_ASSERT_FALSE(status);
 }
 
+/**
+ * Tests if init server starts sampling sensor from the timer interrupt
+ */
+void test_RuntimeInitServerShouldStartSensorSampling()
+{
+    bool status = true;
+
+    sensor_start_sampling_ExpectAndReturn(STATUS_OK);
+
+    status = init_server();
+
+    TEST_ASSERT_TRUE(status);
+}
+
+TEST_CASE(TIMER_STATUS_UNINIT)
+TEST_CASE(SENSOR_STATUS_ERROR)
+/**
+ * Tests if init server fails when starting sensor sampling fails
+ */
+void test_RuntimeInitServerShouldFailIfStartSensorSamplingFails(status_t sensor_error)
+{
+    bool status = true;
+
+    sensor_start_sampling_ExpectAndReturn(sensor_error);
+
+    status = init_server();
+
+    TEST_ASSERT_FALSE(status);
+}
+
+// ========================================================
+// is_input_due
+// ========================================================
+
+/**
+ * Tests if input is always due if the runtime cannot sleep
+ */
+void test_RuntimeIsInputDueShouldReturnTrueIfIdleIsDisabled(void)
+{
+    bool due = false;
+
+    due = is_input_due();
+
+    TEST_ASSERT_TRUE(due);
+}
+
+TEST_CASE(100, 99, false)
+TEST_CASE(100, 100, true)
+TEST_CASE(0x10, 0xFFFFFFF0, false)
+TEST_CASE(0xFFFFFFF0, 0x10, true)
+/**
+ * Tests if input is due when the next input time is reached, handling timer overflow
+ */
+void test_RuntimeIsInputDueShouldCompareNextInputTimeWithCurrentTime(uint32_t input_time, uint32_t time, bool expected)
+{
+    bool due = !expected;
+
+    g_idle_enabled = true;
+    g_mock_csr = time;
+
+    get_next_input_time_ExpectAndReturn(NULL, STATUS_OK);
+    get_next_input_time_IgnoreArg_time();
+    get_next_input_time_ReturnThruPtr_time(&input_time);
+
+    due = is_input_due();
+
+    TEST_ASSERT_EQUAL(expected, due);
+}
+
+/**
+ * Tests if input is due if input reader does not provide the next input time
+ */
+void test_RuntimeIsInputDueShouldReturnTrueIfNextInputTimeIsNotAvailable(void)
+{
+    bool due = false;
+
+    g_idle_enabled = true;
+
+    get_next_input_time_ExpectAndReturn(NULL, INPUT_READER_NO_READ);
+    get_next_input_time_IgnoreArg_time();
+
+    due = is_input_due();
+
+    TEST_ASSERT_TRUE(due);
+}
+
+// ========================================================
+// idle
+// ========================================================
+
+/**
+ * Tests if idle waits for interrupt if there is no pending message and no model is loaded
+ */
+void test_RuntimeIdleShouldWaitForInterruptIfNoMessageIsPending(void)
+{
+    get_model_state_ExpectAndReturn(MODEL_STATE_UNINITIALIZED);
+    interrupts_lock_ExpectAndReturn(MSTATUS_MIE);
+    uart_rx_pending_ExpectAndReturn(false);
+    interrupts_wait_Expect();
+    interrupts_unlock_Expect(MSTATUS_MIE);
+
+    idle();
+}
+
+/**
+ * Tests if idle does not wait for interrupt if there is pending message
+ */
+void test_RuntimeIdleShouldNotWaitIfMessageIsPending(void)
+{
+    get_model_state_ExpectAndReturn(MODEL_STATE_UNINITIALIZED);
+    interrupts_lock_ExpectAndReturn(MSTATUS_MIE);
+    uart_rx_pending_ExpectAndReturn(true);
+    interrupts_unlock_Expect(MSTATUS_MIE);
+
+    idle();
+}
+
+/**
+ * Tests if idle sets alarm to the time of the next input read
+ */
+void test_RuntimeIdleShouldSetAlarmToNextInputTime(void)
+{
+    uint32_t input_time = 100;
+
+    get_model_state_ExpectAndReturn(MODEL_STATE_WEIGHTS_LOADED);
+    get_next_input_time_ExpectAndReturn(NULL, STATUS_OK);
+    get_next_input_time_IgnoreArg_time();
+    get_next_input_time_ReturnThruPtr_time(&input_time);
+    timer_set_alarm_ExpectAndReturn(input_time, STATUS_OK);
+    interrupts_lock_ExpectAndReturn(MSTATUS_MIE);
+    uart_rx_pending_ExpectAndReturn(false);
+    interrupts_wait_Expect();
+    interrupts_unlock_Expect(MSTATUS_MIE);
+    timer_cancel_alarm_ExpectAndReturn(STATUS_OK);
+
+    idle();
+}
+
+/**
+ * Tests if idle does not wait for interrupt if the next input is already due
+ */
+void test_RuntimeIdleShouldNotWaitIfInputIsDue(void)
+{
+    uint32_t input_time = 100;
+
+    g_mock_csr = input_time;
+
+    get_model_state_ExpectAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_next_input_time_ExpectAndReturn(NULL, STATUS_OK);
+    get_next_input_time_IgnoreArg_time();
+    get_next_input_time_ReturnThruPtr_time(&input_time);
+    timer_set_alarm_ExpectAndReturn(input_time, STATUS_OK);
+    interrupts_lock_ExpectAndReturn(MSTATUS_MIE);
+    uart_rx_pending_ExpectAndReturn(false);
+    interrupts_unlock_Expect(MSTATUS_MIE);
+    timer_cancel_alarm_ExpectAndReturn(STATUS_OK);
+
+    idle();
+}
+
+/**
+ * Tests if idle wakes up to fall back to the previous baudrate
+ */
+void test_RuntimeIdleShouldSetAlarmToBaudrateFallbackTimeout(void)
+{
+    uint32_t fallback_time = (uint32_t)(BAUDRATE_FALLBACK_TIMEOUT_S * TIMER_CLOCK_FREQ) + 1;
+
+    g_fallback_baudrate = 115200;
+    g_baudrate_change_time = 0;
+
+    get_model_state_ExpectAndReturn(MODEL_STATE_UNINITIALIZED);
+    timer_set_alarm_ExpectAndReturn(fallback_time, STATUS_OK);
+    interrupts_lock_ExpectAndReturn(MSTATUS_MIE);
+    uart_rx_pending_ExpectAndReturn(false);
+    interrupts_wait_Expect();
+    interrupts_unlock_Expect(MSTATUS_MIE);
+    timer_cancel_alarm_ExpectAndReturn(STATUS_OK);
+
+    idle();
+
+    TEST_ASSERT_EQUAL_UINT(115200, g_fallback_baudrate);
+}
+
+/**
+ * Tests if idle does not sleep if the alarm cannot be set
+ */
+void test_RuntimeIdleShouldNotWaitIfSettingAlarmFails(void)
+{
+    uint32_t input_time = 100;
+
+    get_model_state_ExpectAndReturn(MODEL_STATE_WEIGHTS_LOADED);
+    get_next_input_time_ExpectAndReturn(NULL, STATUS_OK);
+    get_next_input_time_IgnoreArg_time();
+    get_next_input_time_ReturnThruPtr_time(&input_time);
+    timer_set_alarm_ExpectAndReturn(input_time, TIMER_STATUS_UNINIT);
+
+    idle();
+}
+
 // ========================================================
 // wait_for_message
 // ========================================================
@@ -245,6 +594,55 @@ void test_RuntimeWaitForMessageShouldFailIfProtocolReceiveFails(status_t server_
     TEST_ASSERT_EQUAL_PTR(NULL, msg);
 }
 
+/**
+ * Tests if wait for message records the receive phase
+ */
+void test_RuntimeWaitForMessageShouldRecordReceivePhase(void)
+{
+    bool status = true;
+    message_t *msg = NULL;
+
+    prepare_message(MESSAGE_TYPE_OK, NULL, 0, &gp_message_to_receive);
+    receive_message_StubWithCallback(mock_receive_message);
+
+    status = wait_for_message(&msg);
+
+    TEST_ASSERT_TRUE(status);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_RECEIVE]);
+}
+
+/**
+ * Tests if wait for message does not record the receive phase if no message is received
+ */
+void test_RuntimeWaitForMessageShouldNotRecordReceivePhaseOnTimeout(void)
+{
+    bool status = true;
+    message_t *msg = NULL;
+
+    receive_message_ExpectAndReturn(&msg, PROTOCOL_STATUS_TIMEOUT);
+
+    status = wait_for_message(&msg);
+
+    TEST_ASSERT_FALSE(status);
+    TEST_ASSERT_EQUAL_UINT(0, g_profiler_records[PROFILER_PHASE_RECEIVE]);
+}
+
+/**
+ * Tests if wait for message rejects message of unknown type
+ */
+void test_RuntimeWaitForMessageShouldFailForInvalidMessageType(void)
+{
+    bool status = true;
+    message_t *msg = NULL;
+
+    prepare_message(NUM_MESSAGE_TYPES, NULL, 0, &gp_message_to_receive);
+    receive_message_StubWithCallback(mock_receive_message);
+
+    status = wait_for_message(&msg);
+
+    TEST_ASSERT_FALSE(status);
+}
+
 // ========================================================
 // handle_message
 // ========================================================
@@ -276,7 +674,7 @@ void test_RuntimeHandleMessageShouldCallProperCallbackWithOKResponseWithoutPaylo
 {
     prepare_message(message_type, NULL, 0, &gp_message);
     g_msg_callback[message_type] = mock_callback_with_ok_response;
-    send_message_StubWithCallback(mock_send_message);
+    send_message_async_StubWithCallback(mock_send_message_async);
 
     handle_message(gp_message);
 
@@ -299,7 +697,7 @@ void test_RuntimeHandleMessageShouldCallProperCallbackWithErrorResponseWithoutPa
 {
     prepare_message(message_type, NULL, 0, &gp_message);
     g_msg_callback[message_type] = mock_callback_with_error_response;
-    send_message_StubWithCallback(mock_send_message);
+    send_message_async_StubWithCallback(mock_send_message_async);
 
     handle_message(gp_message);
 
@@ -317,7 +715,7 @@ void test_RuntimeHandleMessageShouldCallProperCallbackWithOKResponseWithPayloadF
 {
     prepare_message(message_type, NULL, 0, &gp_message);
     g_msg_callback[message_type] = mock_callback_with_ok_response_with_payload;
-    send_message_StubWithCallback(mock_send_message);
+    send_message_async_StubWithCallback(mock_send_message_async);
 
     handle_message(gp_message);
 
@@ -342,7 +740,7 @@ void test_RuntimeHandleMessageShouldSendErrorIfCallbackFails(MESSAGE_TYPE messag
     prepare_message(message_type, NULL, 0, &gp_message);
 
     g_msg_callback[message_type] = mock_callback_error;
-    send_message_StubWithCallback(mock_send_message);
+    send_message_async_StubWithCallback(mock_send_message_async);
 
     handle_message(gp_message);
 
@@ -351,6 +749,21 @@ void test_RuntimeHandleMessageShouldSendErrorIfCallbackFails(MESSAGE_TYPE messag
     TEST_ASSERT_EQUAL_UINT(sizeof(message_type_t), gp_message_sent->message_size);
 }
 
+/**
+ * Tests if handle message records the send phase once the response is sent
+ */
+void test_RuntimeHandleMessageShouldRecordSendPhaseWhenResponseIsSent(void)
+{
+    prepare_message(MESSAGE_TYPE_DATA, NULL, 0, &gp_message);
+    g_msg_callback[MESSAGE_TYPE_DATA] = mock_callback_with_ok_response;
+    send_message_async_StubWithCallback(mock_send_message_async);
+
+    handle_message(gp_message);
+
+    TEST_ASSERT_NOT_EQUAL_INT(NULL, gp_message_sent);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_SEND]);
+}
+
 /**
  * Tests if handle message does nothing when message pointer is invalid
  */
@@ -361,6 +774,65 @@ void test_RuntimeHandleMessageShouldReturnForInvalidPointer(void)
     // send_message and callback not called
 }
 
+// ========================================================
+// get_model_message_buffer
+// ========================================================
+
+/**
+ * Tests if get model message buffer places message payload in the model weights buffer
+ */
+void test_RuntimeGetModelMessageBufferShouldPlacePayloadInModelWeightsBuffer(void)
+{
+    static uint8_t model_weights_buffer[128];
+    uint8_t *model_weights_buffer_ptr = model_weights_buffer + sizeof(message_t);
+    message_t *msg = NULL;
+
+    get_model_weights_buffer_ExpectAndReturn(64, NULL, STATUS_OK);
+    get_model_weights_buffer_IgnoreArg_model_weights_buffer();
+    get_model_weights_buffer_ReturnThruPtr_model_weights_buffer(&model_weights_buffer_ptr);
+
+    msg = get_model_message_buffer(sizeof(message_type_t) + 64);
+
+    TEST_ASSERT_EQUAL_PTR(model_weights_buffer, msg);
+    TEST_ASSERT_EQUAL_PTR(model_weights_buffer_ptr, msg->payload);
+}
+
+/**
+ * Tests if get model message buffer waits for the queued model output before the loaded model is released
+ */
+void test_RuntimeGetModelMessageBufferShouldWaitForQueuedModelOutput(void)
+{
+    static uint8_t model_weights_buffer[128];
+    uint8_t *model_weights_buffer_ptr = model_weights_buffer + sizeof(message_t);
+    message_t *msg = NULL;
+
+    g_model_output_parts_queued = 2;
+    flush_messages_StubWithCallback(mock_flush_messages);
+    get_model_weights_buffer_ExpectAndReturn(64, NULL, STATUS_OK);
+    get_model_weights_buffer_IgnoreArg_model_weights_buffer();
+    get_model_weights_buffer_ReturnThruPtr_model_weights_buffer(&model_weights_buffer_ptr);
+
+    msg = get_model_message_buffer(sizeof(message_type_t) + 64);
+
+    TEST_ASSERT_EQUAL_PTR(model_weights_buffer, msg);
+    TEST_ASSERT_EQUAL_UINT(g_model_output_parts_queued, g_model_output_parts_sent);
+}
+
+/**
+ * Tests if get model message buffer returns NULL when model weights buffer is not available
+ */
+void test_RuntimeGetModelMessageBufferShouldReturnNULLIfModelWeightsBufferIsNotAvailable(void)
+{
+    message_t *msg = NULL;
+
+    get_model_weights_buffer_ExpectAndReturn(64, NULL, MODEL_STATUS_INV_STATE);
+    get_model_weights_buffer_IgnoreArg_model_weights_buffer();
+
+    msg = get_model_message_buffer(sizeof(message_type_t) + 64);
+
+    TEST_ASSERT_EQUAL_PTR(NULL, msg);
+}
+
 // ========================================================
 // ok_callback
 // ========================================================
@@ -635,33 +1107,72 @@ void test_RuntimeProcessCallbackShouldRunModel(void)
 }
 
 /**
- * Tests if process callback fails if model inference fails
+ * Tests if process callback waits for the queued model output before running model inference
  */
-void test_RuntimeProcessCallbackShouldFailIfRunModelFails(void)
+void test_RuntimeProcessCallbackShouldWaitForQueuedModelOutput(void)
 {
     status_t status = STATUS_OK;
 
     prepare_message(MESSAGE_TYPE_PROCESS, NULL, 0, &gp_message);
 
-    run_model_IgnoreAndReturn(MODEL_STATUS_INV_STATE);
-    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+    g_model_output_parts_queued = 2;
+    g_model_output_parts_sent = 1;
+    flush_messages_StubWithCallback(mock_flush_messages);
+    run_model_ExpectAndReturn(STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
 
     status = process_callback(&gp_message);
 
-    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(g_model_output_parts_queued, g_model_output_parts_sent);
 }
 
 /**
- * Tests if process callback fails for invalid pointer
+ * Tests if process callback fails without running model inference if waiting for the queued model output fails
  */
-void test_RuntimeProcessCallbackShouldFailForInvalidPointer(void)
+void test_RuntimeProcessCallbackShouldFailIfFlushMessagesFails(void)
 {
     status_t status = STATUS_OK;
 
-    status = process_callback(NULL);
+    prepare_message(MESSAGE_TYPE_PROCESS, NULL, 0, &gp_message);
 
-    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
-}
+    g_model_output_parts_queued = 1;
+    flush_messages_ExpectAndReturn(PROTOCOL_STATUS_INTERNAL_ERROR);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = process_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_INTERNAL_ERROR, status);
+}
+
+/**
+ * Tests if process callback fails if model inference fails
+ */
+void test_RuntimeProcessCallbackShouldFailIfRunModelFails(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_PROCESS, NULL, 0, &gp_message);
+
+    run_model_IgnoreAndReturn(MODEL_STATUS_INV_STATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = process_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if process callback fails for invalid pointer
+ */
+void test_RuntimeProcessCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = process_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
 
 TEST_CASE(MESSAGE_TYPE_OK)
 TEST_CASE(MESSAGE_TYPE_ERROR)
@@ -689,32 +1200,57 @@ void test_RuntimeProcessCallbackShouldFailForInvalidMessageType(MESSAGE_TYPE mes
 // ========================================================
 
 /**
- * Tests if output callback properly loads model output
+ * Tests if output callback streams model output and records the get output phase
  */
-void test_RuntimeOutputCallbackShouldLoadModelOutput(void)
+void test_RuntimeOutputCallbackShouldStreamModelOutput(void)
 {
     status_t status = STATUS_OK;
+    size_t model_output_size = 40;
 
     prepare_message(MESSAGE_TYPE_OUTPUT, NULL, 0, &gp_message);
 
-    get_model_output_IgnoreAndReturn(STATUS_OK);
-    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_model_output_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_output_size_IgnoreArg_model_output_size();
+    get_model_output_size_ReturnThruPtr_model_output_size(&model_output_size);
+    send_message_header_ExpectAndReturn(MESSAGE_TYPE_OK, model_output_size, STATUS_OK);
+    write_model_output_ExpectAndReturn(send_model_output_payload, STATUS_OK);
 
     status = output_callback(&gp_message);
 
     TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, gp_message);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if output callback fails when inference was not done
+ */
+void test_RuntimeOutputCallbackShouldFailIfInferenceNotDone(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, NULL, 0, &gp_message);
+
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INPUT_LOADED);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
 }
 
 /**
- * Tests if output callback fails when model output loading fails
+ * Tests if output callback fails when model output size retrieval fails
  */
-void test_RuntimeOutputCallbackShouldFailIfGetModelOutputFails(void)
+void test_RuntimeOutputCallbackShouldFailIfGetModelOutputSizeFails(void)
 {
     status_t status = STATUS_OK;
 
     prepare_message(MESSAGE_TYPE_OUTPUT, NULL, 0, &gp_message);
 
-    get_model_output_IgnoreAndReturn(MODEL_STATUS_INV_STATE);
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_model_output_size_IgnoreAndReturn(MODEL_STATUS_INV_STATE);
     prepare_failure_response_IgnoreAndReturn(STATUS_OK);
 
     status = output_callback(&gp_message);
@@ -722,6 +1258,106 @@ void test_RuntimeOutputCallbackShouldFailIfGetModelOutputFails(void)
     TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
 }
 
+/**
+ * Tests if output callback fails when writing model output fails
+ */
+void test_RuntimeOutputCallbackShouldFailIfWriteModelOutputFails(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, NULL, 0, &gp_message);
+
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_model_output_size_IgnoreAndReturn(STATUS_OK);
+    send_message_header_IgnoreAndReturn(STATUS_OK);
+    write_model_output_IgnoreAndReturn(PROTOCOL_STATUS_CLIENT_DISCONNECTED);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_CLIENT_DISCONNECTED, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, gp_message);
+    TEST_ASSERT_EQUAL_UINT(0, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if output callback reduces model output on the device if the request contains reduction parameters and records
+ * the get output phase
+ */
+void test_RuntimeOutputCallbackShouldReturnReducedOutput(void)
+{
+    status_t status = STATUS_OK;
+    output_reduction_t reduction = {.max_classes = 3, .threshold = 0.5F};
+    size_t num_classes = 2;
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, (uint8_t *)&reduction, sizeof(reduction), &gp_message);
+
+    reduce_model_output_ExpectAndReturn(reduction.max_classes, reduction.threshold, NULL, NULL, STATUS_OK);
+    reduce_model_output_IgnoreArg_classes();
+    reduce_model_output_IgnoreArg_num_classes();
+    reduce_model_output_ReturnThruPtr_num_classes(&num_classes);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MESSAGE_TYPE_OK, gp_message->message_type);
+    TEST_ASSERT_EQUAL_UINT(sizeof(message_type_t) + num_classes * sizeof(model_class_score_t),
+                           gp_message->message_size);
+    TEST_ASSERT_EQUAL_UINT(1, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if output callback fails when model output reduction fails
+ */
+void test_RuntimeOutputCallbackShouldFailIfReduceModelOutputFails(void)
+{
+    status_t status = STATUS_OK;
+    output_reduction_t reduction = {.max_classes = 0, .threshold = 0.0F};
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, (uint8_t *)&reduction, sizeof(reduction), &gp_message);
+
+    reduce_model_output_IgnoreAndReturn(MODEL_STATUS_INV_ARG);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if output callback fails if requested number of classes does not fit in the response
+ */
+void test_RuntimeOutputCallbackShouldFailForTooManyClasses(void)
+{
+    status_t status = STATUS_OK;
+    output_reduction_t reduction = {.max_classes = OUTPUT_REDUCTION_MAX_CLASSES + 1, .threshold = 0.0F};
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, (uint8_t *)&reduction, sizeof(reduction), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if output callback fails for invalid payload size
+ */
+void test_RuntimeOutputCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_OUTPUT, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = output_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
 /**
  * Tests if output callback fails for invalid pointer
  */
@@ -755,6 +1391,44 @@ void test_RuntimeOutputCallbackShouldFailForInvalidMessageType(MESSAGE_TYPE mess
     TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_MSG_TYPE, status);
 }
 
+/**
+ * Tests if model output is queued for transmission straight from the result buffer and counted until it is sent
+ */
+void test_RuntimeSendModelOutputPayloadShouldQueuePayload(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t payload[] = "some data";
+
+    send_message_payload_async_ExpectAndReturn(payload, sizeof(payload), model_output_part_sent, STATUS_OK);
+
+    status = send_model_output_payload(payload, sizeof(payload));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_model_output_parts_queued);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_output_parts_sent);
+
+    model_output_part_sent(payload, sizeof(payload));
+
+    TEST_ASSERT_EQUAL_UINT(1, g_model_output_parts_sent);
+}
+
+/**
+ * Tests if model output that failed to be queued is not counted
+ */
+void test_RuntimeSendModelOutputPayloadShouldNotCountPayloadIfQueueingFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t payload[] = "some data";
+
+    send_message_payload_async_ExpectAndReturn(payload, sizeof(payload), model_output_part_sent,
+                                               PROTOCOL_STATUS_INTERNAL_ERROR);
+
+    status = send_model_output_payload(payload, sizeof(payload));
+
+    TEST_ASSERT_EQUAL_UINT(PROTOCOL_STATUS_INTERNAL_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_model_output_parts_queued);
+}
+
 // ========================================================
 // stats_callback
 // ========================================================
@@ -769,6 +1443,7 @@ void test_RuntimeStatsCallbackShouldLoadStats(void)
     prepare_message(MESSAGE_TYPE_STATS, NULL, 0, &gp_message);
 
     get_statistics_IgnoreAndReturn(STATUS_OK);
+    profiler_get_stats_IgnoreAndReturn(STATUS_OK);
     prepare_success_response_IgnoreAndReturn(STATUS_OK);
 
     status = stats_callback(&gp_message);
@@ -776,6 +1451,49 @@ void test_RuntimeStatsCallbackShouldLoadStats(void)
     TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
 }
 
+/**
+ * Tests if stats callback appends profiler statistics after model statistics
+ */
+void test_RuntimeStatsCallbackShouldAppendProfilerStats(void)
+{
+    status_t status = STATUS_OK;
+    // statistics are written into the request buffer, so it has to fit them
+    uint8_t data[MODEL_STATS_SIZE + PROFILER_STATS_SIZE] = {0};
+
+    prepare_message(MESSAGE_TYPE_STATS, data, sizeof(data), &gp_message);
+
+    get_statistics_StubWithCallback(mock_get_statistics);
+    profiler_get_stats_StubWithCallback(mock_profiler_get_stats);
+
+    status = stats_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MESSAGE_TYPE_OK, gp_message->message_type);
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATS_SIZE + PROFILER_STATS_SIZE + sizeof(message_type_t), gp_message->message_size);
+    for (size_t i = 0; i < MODEL_STATS_SIZE + PROFILER_STATS_SIZE; ++i)
+    {
+        TEST_ASSERT_EQUAL_HEX8(i < MODEL_STATS_SIZE ? MODEL_STATS_BYTE : PROFILER_STATS_BYTE, gp_message->payload[i]);
+    }
+}
+
+/**
+ * Tests if stats callback fails if profiler get stats fails
+ */
+void test_RuntimeStatsCallbackShouldFailIfProfilerGetStatsFails(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_STATS, NULL, 0, &gp_message);
+
+    get_statistics_IgnoreAndReturn(STATUS_OK);
+    profiler_get_stats_IgnoreAndReturn(PROFILER_STATUS_INV_ARG);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = stats_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(PROFILER_STATUS_INV_ARG, status);
+}
+
 /**
  * Tests if stats callback fails if get statistics fails
  */
@@ -842,6 +1560,7 @@ void test_RuntimeIOSpecCallbackShouldLoadModelStruct(void)
     prepare_message(MESSAGE_TYPE_IOSPEC, data, sizeof(data), &gp_message);
 
     load_model_struct_ExpectAndReturn(gp_message->payload, MESSAGE_SIZE_PAYLOAD(gp_message->message_size), STATUS_OK);
+    profiler_reset_Expect();
     prepare_success_response_IgnoreAndReturn(STATUS_OK);
 
     status = iospec_callback(&gp_message);
@@ -902,22 +1621,1161 @@ void test_RuntimeIOSpecCallbackShouldFailForInvalidMessageType(MESSAGE_TYPE mess
 }
 
 // ========================================================
-// mocks
+// model_begin_callback
 // ========================================================
 
-const char *mock_get_status_str(status_t status, int num_calls) { return "STATUS_STR"; }
+/**
+ * Tests if model begin callback begins model weights upload
+ */
+void test_RuntimeModelBeginCallbackShouldBeginModelWeightsUpload(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t model_size = 1024;
 
-status_t mock_receive_message(message_t **msg, int num_calls)
+    prepare_message(MESSAGE_TYPE_MODEL_BEGIN, (uint8_t *)&model_size, sizeof(model_size), &gp_message);
+
+    begin_model_weights_upload_ExpectAndReturn(model_size, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_begin_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+/**
+ * Tests if model begin callback fails for invalid payload size
+ */
+void test_RuntimeModelBeginCallbackShouldFailForInvalidPayloadSize(void)
 {
-    *msg = gp_message_to_receive;
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
 
-    return PROTOCOL_STATUS_DATA_READY;
+    prepare_message(MESSAGE_TYPE_MODEL_BEGIN, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_begin_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
 }
 
-status_t mock_send_message(const message_t *msg, int num_calls)
+/**
+ * Tests if model begin callback fails if beginning model weights upload fails
+ */
+void test_RuntimeModelBeginCallbackShouldFailIfBeginModelWeightsUploadFails(void)
 {
-    gp_message_sent = malloc(sizeof(message_size_t) + msg->message_size);
-    memcpy(gp_message_sent, msg, sizeof(message_size_t) + msg->message_size);
+    status_t status = STATUS_OK;
+    uint32_t model_size = 1024;
+
+    prepare_message(MESSAGE_TYPE_MODEL_BEGIN, (uint8_t *)&model_size, sizeof(model_size), &gp_message);
+
+    begin_model_weights_upload_ExpectAndReturn(model_size, MODEL_STATUS_INV_STATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_begin_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if model begin callback fails for invalid request message type
+ */
+void test_RuntimeModelBeginCallbackShouldFailForInvalidMessageType(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_MODEL, NULL, 0, &gp_message);
+
+    status = model_begin_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_MSG_TYPE, status);
+}
+
+// ========================================================
+// model_chunk_callback
+// ========================================================
+
+/**
+ * Tests if model chunk callback loads model weights chunk
+ */
+void test_RuntimeModelChunkCallbackShouldLoadModelWeightsChunk(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_MODEL_CHUNK, data, sizeof(data), &gp_message);
+
+    load_model_weights_chunk_ExpectAndReturn(gp_message->payload, MESSAGE_SIZE_PAYLOAD(gp_message->message_size),
+                                             STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_chunk_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+/**
+ * Tests if model chunk callback fails if loading model weights chunk fails
+ */
+void test_RuntimeModelChunkCallbackShouldFailIfLoadModelWeightsChunkFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_MODEL_CHUNK, data, sizeof(data), &gp_message);
+
+    load_model_weights_chunk_ExpectAndReturn(gp_message->payload, MESSAGE_SIZE_PAYLOAD(gp_message->message_size),
+                                             MODEL_STATUS_INV_ARG);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_chunk_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if model chunk callback fails for invalid pointer
+ */
+void test_RuntimeModelChunkCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = model_chunk_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// model_commit_callback
+// ========================================================
+
+/**
+ * Tests if model commit callback commits model weights upload
+ */
+void test_RuntimeModelCommitCallbackShouldCommitModelWeightsUpload(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_MODEL_COMMIT, NULL, 0, &gp_message);
+
+    commit_model_weights_upload_ExpectAndReturn(STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_commit_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+/**
+ * Tests if model commit callback fails if committing model weights upload fails
+ */
+void test_RuntimeModelCommitCallbackShouldFailIfCommitModelWeightsUploadFails(void)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(MESSAGE_TYPE_MODEL_COMMIT, NULL, 0, &gp_message);
+
+    commit_model_weights_upload_ExpectAndReturn(MODEL_STATUS_INV_ARG);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = model_commit_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if model commit callback fails for invalid pointer
+ */
+void test_RuntimeModelCommitCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = model_commit_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// infer_callback
+// ========================================================
+
+/**
+ * Tests if infer callback loads input, runs model and streams model output
+ */
+void test_RuntimeInferCallbackShouldLoadInputRunModelAndStreamOutput(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+    size_t model_input_size = sizeof(data);
+    size_t model_output_size = 40;
+
+    prepare_message(MESSAGE_TYPE_INFER, data, sizeof(data), &gp_message);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+    load_model_input_ExpectAndReturn(gp_message->payload, model_input_size, STATUS_OK);
+    run_model_ExpectAndReturn(STATUS_OK);
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_model_output_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_output_size_IgnoreArg_model_output_size();
+    get_model_output_size_ReturnThruPtr_model_output_size(&model_output_size);
+    send_message_header_ExpectAndReturn(MESSAGE_TYPE_OK, model_output_size, STATUS_OK);
+    write_model_output_ExpectAndReturn(send_model_output_payload, STATUS_OK);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, gp_message);
+}
+
+/**
+ * Tests if infer callback runs model for each input in batch and streams all outputs in single response
+ */
+void test_RuntimeInferCallbackShouldRunModelForEachInputInBatch(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "abcdefghijk";
+    size_t model_input_size = 4;
+    size_t model_output_size = 40;
+
+    prepare_message(MESSAGE_TYPE_INFER, data, 3 * model_input_size, &gp_message);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+    load_model_input_ExpectAndReturn(gp_message->payload, model_input_size, STATUS_OK);
+    run_model_ExpectAndReturn(STATUS_OK);
+    get_model_state_IgnoreAndReturn(MODEL_STATE_INFERENCE_DONE);
+    get_model_output_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_output_size_IgnoreArg_model_output_size();
+    get_model_output_size_ReturnThruPtr_model_output_size(&model_output_size);
+    send_message_header_ExpectAndReturn(MESSAGE_TYPE_OK, 3 * model_output_size, STATUS_OK);
+    write_model_output_ExpectAndReturn(send_model_output_payload, STATUS_OK);
+    for (int i = 1; i < 3; ++i)
+    {
+        load_model_input_ExpectAndReturn(gp_message->payload + i * model_input_size, model_input_size, STATUS_OK);
+        run_model_ExpectAndReturn(STATUS_OK);
+        write_model_output_ExpectAndReturn(send_model_output_payload, STATUS_OK);
+    }
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, gp_message);
+    TEST_ASSERT_EQUAL_UINT(3, g_profiler_records[PROFILER_PHASE_GET_OUTPUT]);
+}
+
+/**
+ * Tests if infer callback fails when payload is not a multiple of model input size
+ */
+void test_RuntimeInferCallbackShouldFailForInvalidBatchSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+    size_t model_input_size = 4;
+
+    prepare_message(MESSAGE_TYPE_INFER, data, sizeof(data), &gp_message);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if infer callback fails when model input loading fails
+ */
+void test_RuntimeInferCallbackShouldFailIfLoadModelInputFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+    size_t model_input_size = sizeof(data);
+
+    prepare_message(MESSAGE_TYPE_INFER, data, sizeof(data), &gp_message);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+    load_model_input_ExpectAndReturn(gp_message->payload, model_input_size, MODEL_STATUS_INV_STATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if infer callback fails when model run fails
+ */
+void test_RuntimeInferCallbackShouldFailIfRunModelFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+    size_t model_input_size = sizeof(data);
+
+    prepare_message(MESSAGE_TYPE_INFER, data, sizeof(data), &gp_message);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+    load_model_input_IgnoreAndReturn(STATUS_OK);
+    run_model_ExpectAndReturn(MODEL_STATUS_INV_STATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if infer callback fails when model input size retrieval fails
+ */
+void test_RuntimeInferCallbackShouldFailIfGetModelInputSizeFails(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_INFER, data, sizeof(data), &gp_message);
+
+    get_model_input_size_IgnoreAndReturn(MODEL_STATUS_INV_STATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+}
+
+/**
+ * Tests if infer callback fails for invalid pointer
+ */
+void test_RuntimeInferCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = infer_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+TEST_CASE(MESSAGE_TYPE_DATA)
+TEST_CASE(MESSAGE_TYPE_PROCESS)
+TEST_CASE(MESSAGE_TYPE_OUTPUT)
+/**
+ * Tests if infer callback fails for invalid request message type
+ */
+void test_RuntimeInferCallbackShouldFailForInvalidMessageType(MESSAGE_TYPE message_type)
+{
+    status_t status = STATUS_OK;
+
+    prepare_message(message_type, NULL, 0, &gp_message);
+
+    status = infer_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_MSG_TYPE, status);
+}
+
+// ========================================================
+// baudrate_callback
+// ========================================================
+
+/**
+ * Tests if baudrate callback acknowledges request and then changes baudrate
+ */
+void test_RuntimeBaudrateCallbackShouldSendResponseAndChangeBaudrate(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 921600;
+
+    prepare_message(MESSAGE_TYPE_BAUDRATE, (uint8_t *)&baudrate, sizeof(baudrate), &gp_message);
+    g_mock_csr = 1234;
+
+    uart_check_baudrate_ExpectAndReturn(baudrate, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+    send_message_IgnoreAndReturn(STATUS_OK);
+    uart_get_baudrate_ExpectAndReturn(115200);
+    uart_set_baudrate_ExpectAndReturn(baudrate, STATUS_OK);
+
+    status = baudrate_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(NULL, gp_message);
+    TEST_ASSERT_EQUAL_UINT(115200, g_fallback_baudrate);
+    TEST_ASSERT_EQUAL_UINT(1234, g_baudrate_change_time);
+}
+
+/**
+ * Tests if baudrate callback fails for unsupported baudrate
+ */
+void test_RuntimeBaudrateCallbackShouldFailForUnsupportedBaudrate(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 500000;
+
+    prepare_message(MESSAGE_TYPE_BAUDRATE, (uint8_t *)&baudrate, sizeof(baudrate), &gp_message);
+
+    uart_check_baudrate_ExpectAndReturn(baudrate, UART_STATUS_INV_ARG_BAUDRATE);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = baudrate_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_INV_ARG_BAUDRATE, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_fallback_baudrate);
+}
+
+/**
+ * Tests if baudrate callback fails for invalid payload size
+ */
+void test_RuntimeBaudrateCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_BAUDRATE, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = baudrate_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if baudrate callback fails for invalid pointer
+ */
+void test_RuntimeBaudrateCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = baudrate_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// check_baudrate_fallback
+// ========================================================
+
+/**
+ * Tests if valid message confirms baudrate change
+ */
+void test_RuntimeCheckBaudrateFallbackShouldConfirmChangeOnValidMessage(void)
+{
+    g_fallback_baudrate = 115200;
+
+    check_baudrate_fallback(true);
+
+    TEST_ASSERT_EQUAL_UINT(0, g_fallback_baudrate);
+}
+
+/**
+ * Tests if baudrate is restored when no valid message is received within timeout
+ */
+void test_RuntimeCheckBaudrateFallbackShouldRestoreBaudrateAfterTimeout(void)
+{
+    g_fallback_baudrate = 115200;
+    g_baudrate_change_time = 0;
+    g_mock_csr = (uint32_t)(BAUDRATE_FALLBACK_TIMEOUT_S * TIMER_CLOCK_FREQ) + 1;
+
+    uart_set_baudrate_ExpectAndReturn(115200, STATUS_OK);
+
+    check_baudrate_fallback(false);
+
+    TEST_ASSERT_EQUAL_UINT(0, g_fallback_baudrate);
+}
+
+/**
+ * Tests if baudrate change stays pending before timeout
+ */
+void test_RuntimeCheckBaudrateFallbackShouldWaitBeforeTimeout(void)
+{
+    g_fallback_baudrate = 115200;
+    g_baudrate_change_time = 0;
+    g_mock_csr = 1;
+
+    check_baudrate_fallback(false);
+
+    TEST_ASSERT_EQUAL_UINT(115200, g_fallback_baudrate);
+}
+
+// ========================================================
+// sensor_config_callback
+// ========================================================
+
+/**
+ * Tests if sensor config callback configures the sensor and sends success response
+ */
+void test_RuntimeSensorConfigCallbackShouldConfigureSensor(void)
+{
+    status_t status = STATUS_OK;
+    sensor_config_t config = {.data_rate = 400.0F, .range = 8};
+
+    prepare_message(MESSAGE_TYPE_SENSOR_CONFIG, (uint8_t *)&config, sizeof(config), &gp_message);
+
+    sensor_configure_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = sensor_config_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+TEST_CASE(SENSOR_STATUS_INV_ARG)
+TEST_CASE(I2C_STATUS_TIMEOUT)
+/**
+ * Tests if sensor config callback fails when sensor configuration fails
+ */
+void test_RuntimeSensorConfigCallbackShouldFailIfSensorConfigureFails(status_t sensor_error)
+{
+    status_t status = STATUS_OK;
+    sensor_config_t config = {.data_rate = 1000.0F, .range = 8};
+
+    prepare_message(MESSAGE_TYPE_SENSOR_CONFIG, (uint8_t *)&config, sizeof(config), &gp_message);
+
+    sensor_configure_ExpectAndReturn(1000.0F, 8, sensor_error);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = sensor_config_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(sensor_error, status);
+}
+
+/**
+ * Tests if sensor config callback fails for invalid payload size
+ */
+void test_RuntimeSensorConfigCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_SENSOR_CONFIG, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = sensor_config_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if sensor config callback fails for invalid pointer
+ */
+void test_RuntimeSensorConfigCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_config_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// input_stride_callback
+// ========================================================
+
+/**
+ * Tests if input stride callback sets input stride and sends success response
+ */
+void test_RuntimeInputStrideCallbackShouldSetInputStride(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t stride = 25;
+
+    prepare_message(MESSAGE_TYPE_INPUT_STRIDE, (uint8_t *)&stride, sizeof(stride), &gp_message);
+
+    set_input_stride_ExpectAndReturn(stride, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = input_stride_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+TEST_CASE(SENSOR_STATUS_INV_ARG)
+TEST_CASE(INPUT_READER_STATUS_NOT_SUPPORTED)
+/**
+ * Tests if input stride callback fails when setting input stride fails
+ */
+void test_RuntimeInputStrideCallbackShouldFailIfSetInputStrideFails(status_t input_reader_error)
+{
+    status_t status = STATUS_OK;
+    uint32_t stride = 0;
+
+    prepare_message(MESSAGE_TYPE_INPUT_STRIDE, (uint8_t *)&stride, sizeof(stride), &gp_message);
+
+    set_input_stride_ExpectAndReturn(stride, input_reader_error);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = input_stride_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(input_reader_error, status);
+}
+
+/**
+ * Tests if input stride callback fails for invalid payload size
+ */
+void test_RuntimeInputStrideCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_INPUT_STRIDE, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = input_stride_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if input stride callback fails for invalid pointer
+ */
+void test_RuntimeInputStrideCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = input_stride_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// activity_threshold_callback
+// ========================================================
+
+/**
+ * Tests if activity threshold callback sets input activity threshold and sends success response
+ */
+void test_RuntimeActivityThresholdCallbackShouldSetInputActivityThreshold(void)
+{
+    status_t status = STATUS_OK;
+    float threshold = 25.0F;
+
+    prepare_message(MESSAGE_TYPE_ACTIVITY_THRESHOLD, (uint8_t *)&threshold, sizeof(threshold), &gp_message);
+
+    set_input_activity_threshold_ExpectAndReturn(threshold, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = activity_threshold_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+TEST_CASE(INPUT_READER_STATUS_INV_ARG)
+TEST_CASE(INPUT_READER_STATUS_NOT_SUPPORTED)
+/**
+ * Tests if activity threshold callback fails when setting input activity threshold fails
+ */
+void test_RuntimeActivityThresholdCallbackShouldFailIfSetThresholdFails(status_t input_reader_error)
+{
+    status_t status = STATUS_OK;
+    float threshold = -1.0F;
+
+    prepare_message(MESSAGE_TYPE_ACTIVITY_THRESHOLD, (uint8_t *)&threshold, sizeof(threshold), &gp_message);
+
+    set_input_activity_threshold_ExpectAndReturn(threshold, input_reader_error);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = activity_threshold_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(input_reader_error, status);
+}
+
+/**
+ * Tests if activity threshold callback fails for invalid payload size
+ */
+void test_RuntimeActivityThresholdCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_ACTIVITY_THRESHOLD, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = activity_threshold_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if activity threshold callback fails for invalid pointer
+ */
+void test_RuntimeActivityThresholdCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = activity_threshold_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// run_input_inference
+// ========================================================
+
+/**
+ * Tests if run input inference runs model and records its result along with the inference cycles
+ */
+void test_RuntimeRunInputInferenceShouldRunModelAndRecordResult(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_class = 3;
+    float top_score = 0.75F;
+
+    g_mock_csr = 100;
+    run_model_StubWithCallback(mock_run_model);
+    get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+    get_model_output_top_class_ReturnThruPtr_top_class(&top_class);
+    get_model_output_top_class_ReturnThruPtr_top_score(&top_score);
+
+    status = run_input_inference();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_result_ring_count);
+    TEST_ASSERT_EQUAL_UINT(100 + INFERENCE_CYCLES, g_result_ring[0].timestamp);
+    TEST_ASSERT_EQUAL_UINT(INFERENCE_CYCLES, g_result_ring[0].inference_cycles);
+    TEST_ASSERT_EQUAL_UINT(top_class, g_result_ring[0].top_class);
+    TEST_ASSERT_EQUAL_FLOAT(top_score, g_result_ring[0].top_score);
+}
+
+/**
+ * Tests if run input inference waits for the queued model output before running model
+ */
+void test_RuntimeRunInputInferenceShouldWaitForQueuedModelOutput(void)
+{
+    status_t status = STATUS_OK;
+
+    g_model_output_parts_queued = 1;
+    flush_messages_StubWithCallback(mock_flush_messages);
+    run_model_ExpectAndReturn(STATUS_OK);
+    get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+
+    status = run_input_inference();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(g_model_output_parts_queued, g_model_output_parts_sent);
+}
+
+/**
+ * Tests if run input inference fails if run model fails
+ */
+void test_RuntimeRunInputInferenceShouldFailIfRunModelFails(void)
+{
+    status_t status = STATUS_OK;
+
+    run_model_ExpectAndReturn(MODEL_STATUS_INV_STATE);
+
+    status = run_input_inference();
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_result_ring_count);
+}
+
+/**
+ * Tests if run input inference does not fail if recording the result fails
+ */
+void test_RuntimeRunInputInferenceShouldNotFailIfRecordResultFails(void)
+{
+    status_t status = STATUS_OK;
+
+    run_model_ExpectAndReturn(STATUS_OK);
+    get_model_output_top_class_ExpectAnyArgsAndReturn(MODEL_STATUS_INV_ARG);
+
+    status = run_input_inference();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_result_ring_count);
+}
+
+// ========================================================
+// record_result
+// ========================================================
+
+/**
+ * Tests if record result only stores the result if result mode is off
+ */
+void test_RuntimeRecordResultShouldNotPushResultIfResultModeIsOff(void)
+{
+    status_t status = STATUS_OK;
+
+    get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+
+    status = record_result(INFERENCE_CYCLES);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_result_ring_head);
+    TEST_ASSERT_EQUAL_UINT(1, g_result_ring_count);
+}
+
+/**
+ * Tests if record result pushes each result in RESULT_MODE_ALL mode
+ */
+void test_RuntimeRecordResultShouldPushEachResultInModeAll(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_class = 1;
+
+    g_result_mode = RESULT_MODE_ALL;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+        get_model_output_top_class_ReturnThruPtr_top_class(&top_class);
+        send_message_header_ExpectAndReturn(MESSAGE_TYPE_RESULT, sizeof(inference_result_t), STATUS_OK);
+        send_message_payload_ExpectAndReturn((uint8_t *)&g_result_ring[i], sizeof(inference_result_t), STATUS_OK);
+
+        status = record_result(INFERENCE_CYCLES);
+
+        TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    }
+    TEST_ASSERT_EQUAL_UINT(2, g_result_ring_count);
+}
+
+/**
+ * Tests if record result pushes result only when the top class changes in RESULT_MODE_ON_CHANGE mode
+ */
+void test_RuntimeRecordResultShouldPushResultOnTopClassChangeInModeOnChange(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t top_classes[] = {1, 1, 2};
+
+    g_result_mode = RESULT_MODE_ON_CHANGE;
+
+    for (int i = 0; i < sizeof(top_classes) / sizeof(top_classes[0]); ++i)
+    {
+        get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+        get_model_output_top_class_ReturnThruPtr_top_class(&top_classes[i]);
+        if (1 != i)
+        {
+            send_message_header_ExpectAndReturn(MESSAGE_TYPE_RESULT, sizeof(inference_result_t), STATUS_OK);
+            send_message_payload_ExpectAndReturn((uint8_t *)&g_result_ring[i], sizeof(inference_result_t), STATUS_OK);
+        }
+
+        status = record_result(INFERENCE_CYCLES);
+
+        TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    }
+    TEST_ASSERT_EQUAL_UINT(3, g_result_ring_count);
+    TEST_ASSERT_EQUAL_UINT(2, g_last_pushed_class);
+}
+
+/**
+ * Tests if record result overwrites the oldest result if the result ring is full
+ */
+void test_RuntimeRecordResultShouldOverwriteOldestResultIfRingIsFull(void)
+{
+    status_t status = STATUS_OK;
+
+    g_result_ring_head = RESULT_RING_LEN - 1;
+    g_result_ring_count = RESULT_RING_LEN;
+    get_model_output_top_class_ExpectAnyArgsAndReturn(STATUS_OK);
+
+    status = record_result(INFERENCE_CYCLES);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_result_ring_head);
+    TEST_ASSERT_EQUAL_UINT(RESULT_RING_LEN, g_result_ring_count);
+    TEST_ASSERT_EQUAL_UINT(INFERENCE_CYCLES, g_result_ring[RESULT_RING_LEN - 1].inference_cycles);
+}
+
+/**
+ * Tests if record result fails if getting top class of the model output fails
+ */
+void test_RuntimeRecordResultShouldFailIfGetModelOutputTopClassFails(void)
+{
+    status_t status = STATUS_OK;
+
+    g_result_mode = RESULT_MODE_ALL;
+    get_model_output_top_class_ExpectAnyArgsAndReturn(MODEL_STATUS_INV_STATE);
+
+    status = record_result(INFERENCE_CYCLES);
+
+    TEST_ASSERT_EQUAL_UINT(MODEL_STATUS_INV_STATE, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_result_ring_count);
+}
+
+// ========================================================
+// result_callback
+// ========================================================
+
+/**
+ * Tests if result callback returns results that were not fetched yet, oldest first, and marks them as fetched
+ */
+void test_RuntimeResultCallbackShouldReturnResultsOldestFirst(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t message_buffer[MAX_MESSAGE_SIZE_BYTES] = {0};
+    message_t *message = (message_t *)message_buffer;
+    size_t result_indices[] = {RESULT_RING_LEN - 2, RESULT_RING_LEN - 1, 0};
+
+    message->message_size = sizeof(message_type_t);
+    message->message_type = MESSAGE_TYPE_RESULT;
+    for (int i = 0; i < 3; ++i)
+    {
+        g_result_ring[result_indices[i]].top_class = i;
+    }
+    g_result_ring_head = 1;
+    g_result_ring_count = 3;
+
+    status = result_callback(&message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(MESSAGE_TYPE_OK, message->message_type);
+    TEST_ASSERT_EQUAL_UINT(sizeof(message_type_t) + 3 * sizeof(inference_result_t), message->message_size);
+    for (int i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT(i, ((inference_result_t *)message->payload)[i].top_class);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, g_result_ring_count);
+    TEST_ASSERT_EQUAL_UINT(1, g_result_ring_head);
+}
+
+/**
+ * Tests if result callback fails for invalid payload size
+ */
+void test_RuntimeResultCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_RESULT, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = result_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if result callback fails for invalid pointer
+ */
+void test_RuntimeResultCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = result_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// result_mode_callback
+// ========================================================
+
+TEST_CASE(RESULT_MODE_OFF)
+TEST_CASE(RESULT_MODE_ALL)
+TEST_CASE(RESULT_MODE_ON_CHANGE)
+/**
+ * Tests if result mode callback sets result mode and sends success response
+ */
+void test_RuntimeResultModeCallbackShouldSetResultMode(uint32_t result_mode)
+{
+    status_t status = STATUS_OK;
+
+    g_last_pushed_class = 1;
+    prepare_message(MESSAGE_TYPE_RESULT_MODE, (uint8_t *)&result_mode, sizeof(result_mode), &gp_message);
+
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = result_mode_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(result_mode, g_result_mode);
+    TEST_ASSERT_EQUAL_UINT(RESULT_NO_CLASS, g_last_pushed_class);
+}
+
+/**
+ * Tests if result mode callback fails for invalid result mode
+ */
+void test_RuntimeResultModeCallbackShouldFailForInvalidResultMode(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t result_mode = NUM_RESULT_MODES;
+
+    prepare_message(MESSAGE_TYPE_RESULT_MODE, (uint8_t *)&result_mode, sizeof(result_mode), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = result_mode_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(RESULT_MODE_OFF, g_result_mode);
+}
+
+/**
+ * Tests if result mode callback fails for invalid payload size
+ */
+void test_RuntimeResultModeCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_RESULT_MODE, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = result_mode_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if result mode callback fails for invalid pointer
+ */
+void test_RuntimeResultModeCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = result_mode_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// preprocessing_callback
+// ========================================================
+
+/**
+ * Tests if preprocessing callback configures preprocessing and sends success response
+ */
+void test_RuntimePreprocessingCallbackShouldConfigurePreprocessing(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = {.num_channels = 3, .output_type = PREPROCESSING_OUTPUT_I8};
+
+    prepare_message(MESSAGE_TYPE_PREPROCESSING, (uint8_t *)&config, sizeof(config), &gp_message);
+
+    preprocessing_configure_ExpectAndReturn(&config, STATUS_OK);
+    prepare_success_response_IgnoreAndReturn(STATUS_OK);
+
+    status = preprocessing_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+/**
+ * Tests if preprocessing callback fails when preprocessing configuration fails
+ */
+void test_RuntimePreprocessingCallbackShouldFailIfPreprocessingConfigureFails(void)
+{
+    status_t status = STATUS_OK;
+    preprocessing_config_t config = {.num_channels = PREPROCESSING_MAX_CHANNELS + 1};
+
+    prepare_message(MESSAGE_TYPE_PREPROCESSING, (uint8_t *)&config, sizeof(config), &gp_message);
+
+    preprocessing_configure_ExpectAndReturn(&config, PREPROCESSING_STATUS_INV_ARG);
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = preprocessing_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(PREPROCESSING_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if preprocessing callback fails for invalid payload size
+ */
+void test_RuntimePreprocessingCallbackShouldFailForInvalidPayloadSize(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    prepare_message(MESSAGE_TYPE_PREPROCESSING, data, sizeof(data), &gp_message);
+
+    prepare_failure_response_IgnoreAndReturn(STATUS_OK);
+
+    status = preprocessing_callback(&gp_message);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if preprocessing callback fails for invalid pointer
+ */
+void test_RuntimePreprocessingCallbackShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = preprocessing_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT(RUNTIME_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+const char *mock_get_status_str(status_t status, int num_calls) { return "STATUS_STR"; }
+
+void mock_csr_read_callback() {}
+
+status_t mock_run_model(int num_calls)
+{
+    g_mock_csr += INFERENCE_CYCLES;
+
+    return STATUS_OK;
+}
+
+status_t mock_flush_messages(int num_calls)
+{
+    g_model_output_parts_sent = g_model_output_parts_queued;
+
+    return STATUS_OK;
+}
+
+status_t mock_receive_message(message_t **msg, int num_calls)
+{
+    *msg = gp_message_to_receive;
+
+    return PROTOCOL_STATUS_DATA_READY;
+}
+
+status_t mock_send_message(const message_t *msg, int num_calls)
+{
+    gp_message_sent = malloc(sizeof(message_size_t) + msg->message_size);
+    memcpy(gp_message_sent, msg, sizeof(message_size_t) + msg->message_size);
+
+    return STATUS_OK;
+}
+
+status_t mock_send_message_async(const message_t *msg, message_sent_callback_t callback, int num_calls)
+{
+    status_t status = mock_send_message(msg, num_calls);
+
+    if (IS_VALID_POINTER(callback))
+    {
+        callback((const uint8_t *)msg, MESSAGE_SIZE_FULL(msg->message_size));
+    }
+
+    return status;
+}
+
+status_t mock_profiler_record(const PROFILER_PHASE phase, const profiler_timestamp_t *timestamp, int num_calls)
+{
+    ++g_profiler_records[phase];
+
+    return STATUS_OK;
+}
+
+status_t mock_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer, size_t *statistics_size,
+                             int num_calls)
+{
+    memset(statistics_buffer, MODEL_STATS_BYTE, MODEL_STATS_SIZE);
+    *statistics_size = MODEL_STATS_SIZE;
+
+    return STATUS_OK;
+}
+
+status_t mock_profiler_get_stats(const size_t buffer_size, uint8_t *buffer, size_t *stats_size, int num_calls)
+{
+    memset(buffer, PROFILER_STATS_BYTE, PROFILER_STATS_SIZE);
+    *stats_size = PROFILER_STATS_SIZE;
 
     return STATUS_OK;
 }
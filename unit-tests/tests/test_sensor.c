@@ -8,21 +8,61 @@
 #include "mock_adxl345.h"
 #include "mock_i2c.h"
 #include "mock_sensor_mock.h"
+#include "mock_timer.h"
 #include "mock_utils.h"
 #include "unity.h"
 
 #define TEST_CASE(...)
 
 uint32_t g_mock_csr = 0;
-extern sensor_data_t g_sensor_data_buffer[];
+extern sensor_buffer_t g_sensor_data_buffer;
+extern SENSOR_SAMPLE_FORMAT g_sensor_sample_format;
 extern ut_static size_t g_sensor_data_buffer_idx;
+extern uint32_t g_sensor_last_read_time;
+extern uint32_t g_sensor_read_interval;
+extern bool g_sensor_sampling;
+extern size_t g_sensor_stride;
+extern size_t g_sensor_new_samples;
+extern volatile uint32_t g_sensor_sampling_ticks;
+extern uint32_t g_sensor_sampling_ticks_read;
+extern volatile uint32_t g_sensor_last_tick_time;
+extern status_t sensor_sample();
+extern void sensor_sample_due();
+
+const uint8_t *gp_consumed_data = NULL;
+size_t g_consumed_data_size = 0;
+status_t g_consumer_status = STATUS_OK;
 
 /**
  * Callback that is called every read from timer register. It simulates time passing by incrementing this register.
  */
 void mock_csr_read_callback();
 
-void setUp(void) { g_sensor_data_buffer_idx = 0; }
+/**
+ * Mock of sensor data consumer that stores the passed window
+ *
+ * @param data window of the sensor data
+ * @param data_size size of the window
+ *
+ * @returns g_consumer_status
+ */
+status_t mock_sensor_data_consumer(const uint8_t *data, const size_t data_size);
+
+void setUp(void)
+{
+    g_sensor_data_buffer_idx = 0;
+    g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_FLOAT;
+    g_sensor_read_interval = (uint32_t)(SENSOR_READ_INTERVAL * TIMER_CLOCK_FREQ);
+    g_sensor_sampling = false;
+    g_sensor_stride = 1;
+    g_sensor_new_samples = 0;
+    g_sensor_sampling_ticks = 0;
+    g_sensor_sampling_ticks_read = 0;
+    g_sensor_last_tick_time = 0;
+    gp_consumed_data = NULL;
+    g_consumed_data_size = 0;
+    g_consumer_status = STATUS_OK;
+}
 
 void tearDown(void) {}
 
@@ -137,6 +177,22 @@ void test_GetDataSizeShouldReturnSizeRetrievedFromSensorsTable(void)
     TEST_ASSERT_EQUAL_UINT(sizeof(sensor_mock_data_t), data_size);
 }
 
+/**
+ * Tests if get data size returns size of the raw sample in the raw sample format
+ */
+void test_GetDataSizeShouldReturnRawSampleSizeInRawFormat(void)
+{
+    status_t status = STATUS_OK;
+    size_t data_size = 0;
+
+    g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+
+    status = sensor_get_data_size(&data_size);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(sizeof(sensor_mock_raw_data_t), data_size);
+}
+
 /**
  * Tests if get data size fails for invalid pointer
  */
@@ -149,6 +205,95 @@ void test_GetDataSizeShouldFailForInvalidPointer(void)
     TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_PTR, status);
 }
 
+// ========================================================
+// sensor_set_sample_format
+// ========================================================
+
+/**
+ * Tests if set sample format switches the format and discards the samples buffered in the previous one
+ */
+void test_SetSampleFormatShouldSwitchFormatAndDiscardBufferedSamples(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_data_buffer.data[3].a = 1.0f;
+    g_sensor_data_buffer_idx = 5;
+    g_sensor_new_samples = 7;
+
+    status = sensor_set_sample_format(SENSOR_SAMPLE_FORMAT_RAW);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(SENSOR_SAMPLE_FORMAT_RAW, g_sensor_sample_format);
+    TEST_ASSERT_EQUAL(0.0f, g_sensor_data_buffer.data[3].a);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_data_buffer_idx);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
+/**
+ * Tests if set sample format keeps the buffered samples if the format does not change
+ */
+void test_SetSampleFormatShouldKeepBufferedSamplesForSameFormat(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_data_buffer_idx = 5;
+    g_sensor_new_samples = 7;
+
+    status = sensor_set_sample_format(SENSOR_SAMPLE_FORMAT_FLOAT);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(5, g_sensor_data_buffer_idx);
+    TEST_ASSERT_EQUAL_UINT(7, g_sensor_new_samples);
+}
+
+/**
+ * Tests if set sample format fails for invalid format
+ */
+void test_SetSampleFormatShouldFailForInvalidFormat(void)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_set_sample_format(NUM_SENSOR_SAMPLE_FORMATS);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(SENSOR_SAMPLE_FORMAT_FLOAT, g_sensor_sample_format);
+}
+
+// ========================================================
+// sensor_set_stride
+// ========================================================
+
+TEST_CASE(1)
+TEST_CASE(25)
+TEST_CASE(SENSOR_BUFFER_LEN)
+/**
+ * Tests if set stride sets number of new samples after which the data is ready
+ */
+void test_SetStrideShouldSetStride(size_t stride)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_set_stride(stride);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(stride, g_sensor_stride);
+}
+
+TEST_CASE(0)
+TEST_CASE(SENSOR_BUFFER_LEN + 1)
+/**
+ * Tests if set stride fails for stride out of the buffer range
+ */
+void test_SetStrideShouldFailForInvalidStride(size_t stride)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_set_stride(stride);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_sensor_stride);
+}
+
 // ========================================================
 // sensor_read_data_into_buffer
 // ========================================================
@@ -174,8 +319,35 @@ void test_ReadDataIntoBufferShouldReadDataFromSensorAndInsertItIntoBuffer(size_t
 
     TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
     TEST_ASSERT_EQUAL_UINT(buffer_idx + 1, g_sensor_data_buffer_idx);
-    TEST_ASSERT_EQUAL(a, g_sensor_data_buffer[buffer_idx].a);
-    TEST_ASSERT_EQUAL(b, g_sensor_data_buffer[buffer_idx].b);
+    TEST_ASSERT_EQUAL(a, g_sensor_data_buffer.data[buffer_idx].a);
+    TEST_ASSERT_EQUAL(b, g_sensor_data_buffer.data[buffer_idx].b);
+    TEST_ASSERT_EQUAL(a, g_sensor_data_buffer.data[buffer_idx + SENSOR_BUFFER_LEN].a);
+    TEST_ASSERT_EQUAL(b, g_sensor_data_buffer.data[buffer_idx + SENSOR_BUFFER_LEN].b);
+}
+
+/**
+ * Tests if read data into buffer stores raw sample read from sensor in the raw sample format
+ */
+void test_ReadDataIntoBufferShouldStoreRawSampleInRawFormat(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_raw_data_t data = {.a = -123, .b = 456};
+
+    g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+    g_sensor_data_buffer_idx = 2;
+
+    sensor_mock_read_raw_data_ExpectAndReturn(NULL, STATUS_OK);
+    sensor_mock_read_raw_data_IgnoreArg_data();
+    sensor_mock_read_raw_data_ReturnThruPtr_data(&data);
+
+    status = sensor_read_data_into_buffer();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(3, g_sensor_data_buffer_idx);
+    TEST_ASSERT_EQUAL_INT16(data.a, g_sensor_data_buffer.raw_data[2].a);
+    TEST_ASSERT_EQUAL_INT16(data.b, g_sensor_data_buffer.raw_data[2].b);
+    TEST_ASSERT_EQUAL_INT16(data.a, g_sensor_data_buffer.raw_data[2 + SENSOR_BUFFER_LEN].a);
+    TEST_ASSERT_EQUAL_INT16(data.b, g_sensor_data_buffer.raw_data[2 + SENSOR_BUFFER_LEN].b);
 }
 
 /**
@@ -211,6 +383,569 @@ void test_ReadDataIntoBufferShouldFailWhenSensorReadFails(status_t sensor_error)
     TEST_ASSERT_EQUAL_HEX(sensor_error, status);
 }
 
+/**
+ * Tests if read data into buffer only checks for new samples if the sensor is sampled from the timer interrupt
+ */
+void test_ReadDataIntoBufferShouldCheckForNewSamplesWhenSampling(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_sampling = true;
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_NO_DATA, status);
+
+    g_sensor_new_samples = 1;
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+/**
+ * Tests if read data into buffer reports new data only after stride samples are read
+ */
+void test_ReadDataIntoBufferShouldReportNoDataUntilStrideSamplesAreRead(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_stride = 3;
+
+    sensor_mock_read_data_IgnoreAndReturn(STATUS_OK);
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_NO_DATA, status);
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_NO_DATA, status);
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(3, g_sensor_data_buffer_idx);
+}
+
+/**
+ * Tests if read data into buffer reports new data only after stride samples are stored by the timer interrupt
+ */
+void test_ReadDataIntoBufferShouldReportNoDataUntilStrideSamplesAreStoredWhenSampling(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_sampling = true;
+    g_sensor_stride = 8;
+    g_sensor_new_samples = 7;
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_NO_DATA, status);
+
+    g_sensor_new_samples = 8;
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+/**
+ * Tests if read data into buffer reads the sensor FIFO once the timer interrupt counts the elapsed sampling period
+ */
+void test_ReadDataIntoBufferShouldReadFIFOWhenSamplesAreDue(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t data[] = {{.a = 1.0f, .b = 2.0f}};
+    size_t count = 1;
+
+    g_sensor_sampling = true;
+
+    sensor_sample_due();
+
+    sensor_mock_read_fifo_ExpectAndReturn(NULL, SENSOR_FIFO_LEN, NULL, STATUS_OK);
+    sensor_mock_read_fifo_IgnoreArg_data();
+    sensor_mock_read_fifo_IgnoreArg_count();
+    sensor_mock_read_fifo_ReturnArrayThruPtr_data(data, count);
+    sensor_mock_read_fifo_ReturnThruPtr_count(&count);
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(g_sensor_sampling_ticks, g_sensor_sampling_ticks_read);
+    TEST_ASSERT_EQUAL(data[0].a, g_sensor_data_buffer.data[0].a);
+}
+
+TEST_CASE(SENSOR_MOCK_STATUS_INV_ARG)
+TEST_CASE(SENSOR_MOCK_STATUS_ERROR)
+/**
+ * Tests if read data into buffer reports the error of reading the due samples once
+ */
+void test_ReadDataIntoBufferShouldReportSamplingError(status_t sensor_error)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_sampling = true;
+
+    sensor_mock_read_fifo_IgnoreAndReturn(sensor_error);
+
+    sensor_sample_due();
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(sensor_error, status);
+
+    status = sensor_read_data_into_buffer();
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_NO_DATA, status);
+}
+
+// ========================================================
+// sensor_configure
+// ========================================================
+
+/**
+ * Tests if configure sets sensor range and data rate and updates the read interval
+ */
+void test_ConfigureShouldSetRangeAndDataRateAndUpdateReadInterval(void)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 400.0F;
+
+    sensor_mock_validate_config_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, STATUS_OK);
+    sensor_mock_set_data_rate_ExpectAndReturn(400.0F, NULL, STATUS_OK);
+    sensor_mock_set_data_rate_IgnoreArg_applied_rate();
+    sensor_mock_set_data_rate_ReturnThruPtr_applied_rate(&applied_rate);
+
+    status = sensor_configure(400.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(TIMER_CLOCK_FREQ / 400, g_sensor_read_interval);
+}
+
+/**
+ * Tests if configure derives the read interval from the data rate applied by the sensor instead of the requested one
+ */
+void test_ConfigureShouldDeriveReadIntervalFromAppliedDataRate(void)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 400.0F;
+
+    sensor_mock_validate_config_ExpectAndReturn(402.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, STATUS_OK);
+    sensor_mock_set_data_rate_ExpectAndReturn(402.0F, NULL, STATUS_OK);
+    sensor_mock_set_data_rate_IgnoreArg_applied_rate();
+    sensor_mock_set_data_rate_ReturnThruPtr_applied_rate(&applied_rate);
+
+    status = sensor_configure(402.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(TIMER_CLOCK_FREQ / 400, g_sensor_read_interval);
+}
+
+/**
+ * Tests if configure updates the sampling period according to the new data rate
+ */
+void test_ConfigureShouldUpdateSamplingPeriod(void)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 400.0F;
+
+    g_sensor_sampling = true;
+
+    sensor_mock_validate_config_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, STATUS_OK);
+    sensor_mock_set_data_rate_ExpectAndReturn(400.0F, NULL, STATUS_OK);
+    sensor_mock_set_data_rate_IgnoreArg_applied_rate();
+    sensor_mock_set_data_rate_ReturnThruPtr_applied_rate(&applied_rate);
+    timer_set_periodic_callback_ExpectAndReturn(TIMER_CLOCK_FREQ / 400 * SENSOR_FIFO_BURST_LEN, sensor_sample_due,
+                                                STATUS_OK);
+
+    status = sensor_configure(400.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_TRUE(g_sensor_sampling);
+}
+
+/**
+ * Tests if configure writes neither range nor data rate when any of them is invalid
+ */
+void test_ConfigureShouldNotWriteAnyValueIfValidationFails(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t read_interval = g_sensor_read_interval;
+
+    g_sensor_sampling = true;
+
+    sensor_mock_validate_config_ExpectAndReturn(1000.0F, 8, SENSOR_MOCK_STATUS_INV_ARG);
+
+    status = sensor_configure(1000.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_MOCK_STATUS_INV_ARG, status);
+    TEST_ASSERT_EQUAL_UINT(read_interval, g_sensor_read_interval);
+    TEST_ASSERT_TRUE(g_sensor_sampling);
+}
+
+TEST_CASE(SENSOR_MOCK_STATUS_INV_ARG)
+TEST_CASE(I2C_STATUS_TIMEOUT)
+/**
+ * Tests if configure keeps the read interval and the sampling period when setting data rate fails
+ */
+void test_ConfigureShouldKeepReadIntervalIfSettingDataRateFails(status_t sensor_error)
+{
+    status_t status = STATUS_OK;
+    uint32_t read_interval = g_sensor_read_interval;
+
+    g_sensor_sampling = true;
+
+    sensor_mock_validate_config_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, STATUS_OK);
+    sensor_mock_set_data_rate_ExpectAndReturn(400.0F, NULL, sensor_error);
+    sensor_mock_set_data_rate_IgnoreArg_applied_rate();
+
+    status = sensor_configure(400.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(sensor_error, status);
+    TEST_ASSERT_EQUAL_UINT(read_interval, g_sensor_read_interval);
+    TEST_ASSERT_TRUE(g_sensor_sampling);
+}
+
+TEST_CASE(SENSOR_MOCK_STATUS_INV_ARG)
+TEST_CASE(I2C_STATUS_TIMEOUT)
+/**
+ * Tests if configure fails without setting data rate when setting range fails
+ */
+void test_ConfigureShouldFailIfSettingRangeFails(status_t sensor_error)
+{
+    status_t status = STATUS_OK;
+
+    sensor_mock_validate_config_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, sensor_error);
+
+    status = sensor_configure(400.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(sensor_error, status);
+    TEST_ASSERT_EQUAL_UINT((uint32_t)(SENSOR_READ_INTERVAL * TIMER_CLOCK_FREQ), g_sensor_read_interval);
+}
+
+/**
+ * Tests if configure stops sampling when the sampling period cannot be updated
+ */
+void test_ConfigureShouldStopSamplingIfUpdatingSamplingPeriodFails(void)
+{
+    status_t status = STATUS_OK;
+    float applied_rate = 400.0F;
+
+    g_sensor_sampling = true;
+
+    sensor_mock_validate_config_ExpectAndReturn(400.0F, 8, STATUS_OK);
+    sensor_mock_set_range_ExpectAndReturn(8, STATUS_OK);
+    sensor_mock_set_data_rate_ExpectAndReturn(400.0F, NULL, STATUS_OK);
+    sensor_mock_set_data_rate_IgnoreArg_applied_rate();
+    sensor_mock_set_data_rate_ReturnThruPtr_applied_rate(&applied_rate);
+    timer_set_periodic_callback_ExpectAndReturn(TIMER_CLOCK_FREQ / 400 * SENSOR_FIFO_BURST_LEN, sensor_sample_due,
+                                                TIMER_STATUS_UNINIT);
+
+    status = sensor_configure(400.0F, 8);
+
+    TEST_ASSERT_EQUAL_HEX(TIMER_STATUS_UNINIT, status);
+    TEST_ASSERT_FALSE(g_sensor_sampling);
+}
+
+// ========================================================
+// sensor_start_sampling
+// ========================================================
+
+/**
+ * Tests if start sampling enables sensor FIFO and sets the periodic timer callback that marks the FIFO bursts as due
+ */
+void test_StartSamplingShouldEnableFIFOAndSetPeriodicTimerCallback(void)
+{
+    status_t status = STATUS_OK;
+
+    sensor_mock_enable_fifo_ExpectAndReturn(STATUS_OK);
+    timer_set_periodic_callback_ExpectAndReturn(
+        (uint32_t)(SENSOR_READ_INTERVAL * SENSOR_FIFO_BURST_LEN * TIMER_CLOCK_FREQ), sensor_sample_due, STATUS_OK);
+
+    status = sensor_start_sampling();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_TRUE(g_sensor_sampling);
+}
+
+TEST_CASE(SENSOR_MOCK_STATUS_INV_ARG)
+TEST_CASE(SENSOR_MOCK_STATUS_ERROR)
+/**
+ * Tests if start sampling fails when enabling sensor FIFO fails
+ */
+void test_StartSamplingShouldFailIfEnablingFIFOFails(status_t sensor_error)
+{
+    status_t status = STATUS_OK;
+
+    sensor_mock_enable_fifo_ExpectAndReturn(sensor_error);
+
+    status = sensor_start_sampling();
+
+    TEST_ASSERT_EQUAL_HEX(sensor_error, status);
+    TEST_ASSERT_FALSE(g_sensor_sampling);
+}
+
+TEST_CASE(TIMER_STATUS_UNINIT)
+TEST_CASE(TIMER_STATUS_INV_ARG)
+/**
+ * Tests if start sampling fails when setting the timer callback fails
+ */
+void test_StartSamplingShouldFailIfSettingTimerCallbackFails(status_t timer_error)
+{
+    status_t status = STATUS_OK;
+
+    sensor_mock_enable_fifo_IgnoreAndReturn(STATUS_OK);
+    timer_set_periodic_callback_IgnoreAndReturn(timer_error);
+
+    status = sensor_start_sampling();
+
+    TEST_ASSERT_EQUAL_HEX(timer_error, status);
+    TEST_ASSERT_FALSE(g_sensor_sampling);
+}
+
+// ========================================================
+// sensor_sample
+// ========================================================
+
+/**
+ * Tests if the timer callback only counts the elapsed sampling periods and records their time, without accessing the
+ * sensor
+ */
+void test_SensorSampleDueShouldOnlyCountElapsedPeriods(void)
+{
+    g_mock_csr = 1234;
+
+    sensor_sample_due();
+
+    TEST_ASSERT_EQUAL_UINT(1, g_sensor_sampling_ticks);
+    TEST_ASSERT_EQUAL_UINT(1234, g_sensor_last_tick_time);
+
+    sensor_sample_due();
+
+    TEST_ASSERT_EQUAL_UINT(2, g_sensor_sampling_ticks);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
+/**
+ * Tests if sensor sample drains the sensor FIFO once for all elapsed sampling periods
+ */
+void test_SensorSampleShouldReadFIFOOnceForAllElapsedPeriods(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t data[] = {{.a = 1.0f, .b = 2.0f}, {.a = 3.0f, .b = 4.0f}, {.a = 5.0f, .b = 6.0f}};
+    size_t count = 3;
+
+    g_sensor_sampling_ticks = 3;
+
+    sensor_mock_read_fifo_ExpectAndReturn(NULL, SENSOR_FIFO_LEN, NULL, STATUS_OK);
+    sensor_mock_read_fifo_IgnoreArg_data();
+    sensor_mock_read_fifo_IgnoreArg_count();
+    sensor_mock_read_fifo_ReturnArrayThruPtr_data(data, count);
+    sensor_mock_read_fifo_ReturnThruPtr_count(&count);
+
+    status = sensor_sample();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(3, g_sensor_sampling_ticks_read);
+    TEST_ASSERT_EQUAL_UINT(count, g_sensor_new_samples);
+}
+
+/**
+ * Tests if sensor sample marks the elapsed sampling periods as read when reading the samples fails
+ */
+void test_SensorSampleShouldMarkPeriodsAsReadOnFailure(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_sampling_ticks = 2;
+
+    sensor_mock_read_fifo_IgnoreAndReturn(SENSOR_MOCK_STATUS_ERROR);
+
+    status = sensor_sample();
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_MOCK_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(2, g_sensor_sampling_ticks_read);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
+/**
+ * Tests if sensor sample stores samples read from the sensor FIFO in the buffer and counts them as new
+ */
+void test_SensorSampleShouldStoreFIFOSamplesInBuffer(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t data[] = {{.a = 1.0f, .b = 2.0f}, {.a = 3.0f, .b = 4.0f}};
+    size_t count = 2;
+
+    g_sensor_data_buffer_idx = SENSOR_BUFFER_LEN - 1;
+    g_sensor_last_tick_time = 1234;
+    g_mock_csr = 2000;
+
+    sensor_mock_read_fifo_ExpectAndReturn(NULL, SENSOR_FIFO_LEN, NULL, STATUS_OK);
+    sensor_mock_read_fifo_IgnoreArg_data();
+    sensor_mock_read_fifo_IgnoreArg_count();
+    sensor_mock_read_fifo_ReturnArrayThruPtr_data(data, count);
+    sensor_mock_read_fifo_ReturnThruPtr_count(&count);
+
+    status = sensor_sample();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_sensor_data_buffer_idx);
+    TEST_ASSERT_EQUAL(data[0].a, g_sensor_data_buffer.data[SENSOR_BUFFER_LEN - 1].a);
+    TEST_ASSERT_EQUAL(data[0].b, g_sensor_data_buffer.data[SENSOR_BUFFER_LEN - 1].b);
+    TEST_ASSERT_EQUAL(data[1].a, g_sensor_data_buffer.data[0].a);
+    TEST_ASSERT_EQUAL(data[1].b, g_sensor_data_buffer.data[0].b);
+    TEST_ASSERT_EQUAL_UINT(count, g_sensor_new_samples);
+    TEST_ASSERT_EQUAL_UINT(1234, g_sensor_last_read_time);
+}
+
+/**
+ * Tests if sensor sample stores raw samples read from the sensor FIFO in the raw sample format
+ */
+void test_SensorSampleShouldStoreRawFIFOSamplesInRawFormat(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_raw_data_t data[] = {{.a = 1, .b = 2}, {.a = -3, .b = -4}};
+    size_t count = 2;
+
+    g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+    g_sensor_data_buffer_idx = SENSOR_BUFFER_LEN - 1;
+
+    sensor_mock_read_raw_fifo_ExpectAndReturn(NULL, SENSOR_FIFO_LEN, NULL, STATUS_OK);
+    sensor_mock_read_raw_fifo_IgnoreArg_data();
+    sensor_mock_read_raw_fifo_IgnoreArg_count();
+    sensor_mock_read_raw_fifo_ReturnArrayThruPtr_data(data, count);
+    sensor_mock_read_raw_fifo_ReturnThruPtr_count(&count);
+
+    status = sensor_sample();
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1, g_sensor_data_buffer_idx);
+    TEST_ASSERT_EQUAL_INT16(data[0].a, g_sensor_data_buffer.raw_data[SENSOR_BUFFER_LEN - 1].a);
+    TEST_ASSERT_EQUAL_INT16(data[0].b, g_sensor_data_buffer.raw_data[SENSOR_BUFFER_LEN - 1].b);
+    TEST_ASSERT_EQUAL_INT16(data[1].a, g_sensor_data_buffer.raw_data[0].a);
+    TEST_ASSERT_EQUAL_INT16(data[1].b, g_sensor_data_buffer.raw_data[0].b);
+    TEST_ASSERT_EQUAL_UINT(count, g_sensor_new_samples);
+}
+
+/**
+ * Tests if sensor sample keeps the last read time if the sensor FIFO is empty
+ */
+void test_SensorSampleShouldNotUpdateReadTimeIfFIFOIsEmpty(void)
+{
+    g_sensor_last_read_time = 1000;
+    g_sensor_last_tick_time = 1234;
+
+    sensor_mock_read_fifo_IgnoreAndReturn(STATUS_OK);
+
+    sensor_sample();
+
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+    TEST_ASSERT_EQUAL_UINT(1000, g_sensor_last_read_time);
+}
+
+// ========================================================
+// sensor_get_next_read_time
+// ========================================================
+
+/**
+ * Tests if get next read time returns time of the last read delayed by the read interval
+ */
+void test_GetNextReadTimeShouldReturnTimeOfTheNextRead(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 0;
+
+    g_sensor_last_read_time = 1234;
+
+    status = sensor_get_next_read_time(&next_read_time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1234 + (uint32_t)(SENSOR_READ_INTERVAL * TIMER_CLOCK_FREQ), next_read_time);
+}
+
+/**
+ * Tests if get next read time returns time of the last sample if there are new samples stored by the timer interrupt
+ */
+void test_GetNextReadTimeShouldReturnLastSampleTimeIfThereAreNewSamples(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 0;
+
+    g_sensor_last_read_time = 1234;
+    g_sensor_sampling = true;
+    g_sensor_new_samples = 1;
+
+    status = sensor_get_next_read_time(&next_read_time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1234, next_read_time);
+}
+
+/**
+ * Tests if get next read time returns time of the last sample if the timer interrupt counted unread sampling periods
+ */
+void test_GetNextReadTimeShouldReturnLastSampleTimeIfSamplesAreDue(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 0;
+
+    g_sensor_last_read_time = 1234;
+    g_sensor_sampling = true;
+
+    sensor_sample_due();
+
+    status = sensor_get_next_read_time(&next_read_time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1234, next_read_time);
+}
+
+/**
+ * Tests if get next read time returns time of the next FIFO burst read if there are no new samples
+ */
+void test_GetNextReadTimeShouldReturnNextBurstTimeWhenSampling(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 0;
+
+    g_sensor_last_read_time = 1234;
+    g_sensor_sampling = true;
+
+    status = sensor_get_next_read_time(&next_read_time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1234 + (uint32_t)(SENSOR_READ_INTERVAL * SENSOR_FIFO_BURST_LEN * TIMER_CLOCK_FREQ),
+                           next_read_time);
+}
+
+/**
+ * Tests if get next read time returns time of the next FIFO burst read if there are fewer new samples than stride
+ */
+void test_GetNextReadTimeShouldReturnNextBurstTimeUntilStrideSamplesAreStored(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 0;
+
+    g_sensor_last_read_time = 1234;
+    g_sensor_sampling = true;
+    g_sensor_stride = 8;
+    g_sensor_new_samples = 4;
+
+    status = sensor_get_next_read_time(&next_read_time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(1234 + g_sensor_read_interval * SENSOR_FIFO_BURST_LEN, next_read_time);
+}
+
+/**
+ * Tests if get next read time fails for invalid pointer
+ */
+void test_GetNextReadTimeShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_get_next_read_time(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_PTR, status);
+}
+
 // ========================================================
 // sensor_get_buffered_data
 // ========================================================
@@ -226,8 +961,8 @@ void test_GetBufferedDataShouldCopySensorDataToProvidedBuffer(size_t buffer_idx,
     status_t status = STATUS_OK;
     sensor_mock_data_t buffer[SENSOR_MOCK_BUFFER_LEN];
 
-    g_sensor_data_buffer[buffer_idx].a = a;
-    g_sensor_data_buffer[buffer_idx].b = b;
+    g_sensor_data_buffer.data[buffer_idx].a = a;
+    g_sensor_data_buffer.data[buffer_idx].b = b;
     g_sensor_data_buffer_idx = buffer_idx;
 
     status = sensor_get_buffered_data(SENSOR_MOCK_BUFFER_LEN * sizeof(sensor_mock_data_t), (uint8_t *)buffer);
@@ -237,6 +972,53 @@ void test_GetBufferedDataShouldCopySensorDataToProvidedBuffer(size_t buffer_idx,
     TEST_ASSERT_EQUAL(b, buffer[0].b);
 }
 
+/**
+ * Tests if get buffered data writes the whole window, from the oldest sample, after the buffer index wraps around
+ */
+void test_GetBufferedDataShouldCopyWholeWindowAfterIndexWrapsAround(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t buffer[SENSOR_MOCK_BUFFER_LEN];
+    sensor_mock_data_t data[] = {{.a = 1.0f}, {.a = 2.0f}, {.a = 3.0f}, {.a = 4.0f}};
+    size_t count = 4;
+
+    g_sensor_data_buffer.data[2].a = -1.0f;
+    g_sensor_data_buffer_idx = SENSOR_BUFFER_LEN - 2;
+
+    sensor_mock_read_fifo_ExpectAndReturn(NULL, SENSOR_FIFO_LEN, NULL, STATUS_OK);
+    sensor_mock_read_fifo_IgnoreArg_data();
+    sensor_mock_read_fifo_IgnoreArg_count();
+    sensor_mock_read_fifo_ReturnArrayThruPtr_data(data, count);
+    sensor_mock_read_fifo_ReturnThruPtr_count(&count);
+
+    sensor_sample();
+
+    status = sensor_get_buffered_data(SENSOR_MOCK_BUFFER_LEN * sizeof(sensor_mock_data_t), (uint8_t *)buffer);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL(-1.0f, buffer[0].a);
+    TEST_ASSERT_EQUAL(1.0f, buffer[SENSOR_MOCK_BUFFER_LEN - 4].a);
+    TEST_ASSERT_EQUAL(2.0f, buffer[SENSOR_MOCK_BUFFER_LEN - 3].a);
+    TEST_ASSERT_EQUAL(3.0f, buffer[SENSOR_MOCK_BUFFER_LEN - 2].a);
+    TEST_ASSERT_EQUAL(4.0f, buffer[SENSOR_MOCK_BUFFER_LEN - 1].a);
+}
+
+/**
+ * Tests if get buffered data marks the samples as consumed
+ */
+void test_GetBufferedDataShouldResetNewSamplesCount(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t buffer[SENSOR_MOCK_BUFFER_LEN];
+
+    g_sensor_new_samples = 3;
+
+    status = sensor_get_buffered_data(SENSOR_MOCK_BUFFER_LEN * sizeof(sensor_mock_data_t), (uint8_t *)buffer);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
 TEST_CASE(0)
 TEST_CASE(4)
 TEST_CASE(-1)
@@ -266,8 +1048,87 @@ void test_GetBufferedDataShouldFailForInvalidBufferPointer()
     TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_PTR, status);
 }
 
+// ========================================================
+// sensor_consume_buffered_data
+// ========================================================
+
+TEST_CASE(0)
+TEST_CASE(1)
+TEST_CASE(SENSOR_MOCK_BUFFER_LEN - 1)
+/**
+ * Tests if consume buffered data passes the window straight from the sensor buffer and marks the samples as consumed
+ */
+void test_ConsumeBufferedDataShouldPassWindowFromSensorBuffer(size_t buffer_idx)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_data_buffer_idx = buffer_idx;
+    g_sensor_new_samples = 3;
+
+    status = sensor_consume_buffered_data(mock_sensor_data_consumer);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&g_sensor_data_buffer.data[buffer_idx], gp_consumed_data);
+    TEST_ASSERT_EQUAL_UINT(SENSOR_MOCK_BUFFER_LEN * sizeof(sensor_mock_data_t), g_consumed_data_size);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
+/**
+ * Tests if consume buffered data passes the window of raw samples in the raw sample format
+ */
+void test_ConsumeBufferedDataShouldPassRawWindowInRawFormat(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+    g_sensor_data_buffer_idx = 5;
+
+    status = sensor_consume_buffered_data(mock_sensor_data_consumer);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(&g_sensor_data_buffer.raw_data[5], gp_consumed_data);
+    TEST_ASSERT_EQUAL_UINT(SENSOR_MOCK_BUFFER_LEN * sizeof(sensor_mock_raw_data_t), g_consumed_data_size);
+}
+
+/**
+ * Tests if consume buffered data returns the consumer status and marks the samples as consumed anyway, so that the
+ * skipped window is not passed again
+ */
+void test_ConsumeBufferedDataShouldMarkSamplesAsConsumedIfConsumerFails(void)
+{
+    status_t status = STATUS_OK;
+
+    g_sensor_new_samples = 3;
+    g_consumer_status = SENSOR_MOCK_STATUS_ERROR;
+
+    status = sensor_consume_buffered_data(mock_sensor_data_consumer);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_MOCK_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_sensor_new_samples);
+}
+
+/**
+ * Tests if consume buffered data fails for invalid consumer
+ */
+void test_ConsumeBufferedDataShouldFailForInvalidConsumer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = sensor_consume_buffered_data(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_INV_PTR, status);
+}
+
 // ========================================================
 // mocks
 // ========================================================
 
 void mock_csr_read_callback() { g_mock_csr += TIMER_CLOCK_FREQ >> 4; }
+
+status_t mock_sensor_data_consumer(const uint8_t *data, const size_t data_size)
+{
+    gp_consumed_data = data;
+    g_consumed_data_size = data_size;
+
+    return g_consumer_status;
+}
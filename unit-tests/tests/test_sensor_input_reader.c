@@ -11,9 +11,43 @@
 #include "mocks/sensor_mock.h"
 #include "unity.h"
 
+#include <math.h>
+
 #define TEST_CASE(...)
 
-void setUp(void) {}
+extern float g_activity_threshold;
+extern SENSOR_SAMPLE_FORMAT g_sample_format;
+
+/**
+ * Mock of sensor consume buffered data that passes the window to the consumer
+ */
+status_t mock_sensor_consume_buffered_data(sensor_data_consumer_t consumer, int num_calls);
+
+/**
+ * Fills window of sensor data with constant offset and triangle wave of given amplitude on the first channel
+ *
+ * @param window window to be filled
+ * @param offset value of every channel
+ * @param amplitude amplitude of the wave added to the first channel
+ */
+static void fill_window(sensor_mock_data_t *window, float offset, float amplitude);
+
+/**
+ * Fills window of raw sensor data with constant offset and triangle wave of given amplitude on the first channel
+ *
+ * @param window window to be filled
+ * @param offset value of every channel
+ * @param amplitude amplitude of the wave added to the first channel
+ */
+static void fill_raw_window(sensor_mock_raw_data_t *window, int16_t offset, int16_t amplitude);
+
+void setUp(void)
+{
+    g_activity_threshold = 0.0F;
+    g_sample_format = SENSOR_SAMPLE_FORMAT_FLOAT;
+    get_model_input_element_type_IgnoreAndReturn(STATUS_OK);
+    sensor_set_sample_format_IgnoreAndReturn(STATUS_OK);
+}
 
 void tearDown(void) {}
 
@@ -39,14 +73,53 @@ void test_ReadInputShouldReadDataFromSensorAndRunModel(void)
     get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
 
     sensor_read_data_into_buffer_IgnoreAndReturn(STATUS_OK);
-    sensor_get_buffered_data_IgnoreAndReturn(STATUS_OK);
-    load_model_input_IgnoreAndReturn(STATUS_OK);
+    sensor_consume_buffered_data_ExpectAndReturn(load_active_window, STATUS_OK);
 
     status = read_input();
 
     TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
 }
 
+TEST_CASE(IREE_HAL_ELEMENT_TYPE_INT_16, SENSOR_SAMPLE_FORMAT_RAW)
+TEST_CASE(IREE_HAL_ELEMENT_TYPE_FLOAT_32, SENSOR_SAMPLE_FORMAT_FLOAT)
+TEST_CASE(IREE_HAL_ELEMENT_TYPE_INT_8, SENSOR_SAMPLE_FORMAT_FLOAT)
+/**
+ * Tests if read input selects sensor sample format matching the model input element type
+ */
+void test_ReadInputShouldSelectSampleFormatForModelInput(iree_hal_element_type_t element_type,
+                                                         SENSOR_SAMPLE_FORMAT sample_format)
+{
+    status_t status = STATUS_OK;
+
+    get_model_input_element_type_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_element_type_IgnoreArg_element_type();
+    get_model_input_element_type_ReturnThruPtr_element_type(&element_type);
+    sensor_set_sample_format_ExpectAndReturn(sample_format, STATUS_OK);
+    sensor_get_data_size_ExpectAndReturn(NULL, SENSOR_STATUS_ERROR);
+    sensor_get_data_size_IgnoreArg_data_size();
+
+    status = read_input();
+
+    TEST_ASSERT_EQUAL_HEX(SENSOR_STATUS_ERROR, status);
+    TEST_ASSERT_EQUAL_UINT(sample_format, g_sample_format);
+}
+
+TEST_CASE(MODEL_STATUS_INV_STATE)
+/**
+ * Tests if read input fails if model input element type cannot be retrieved
+ */
+void test_ReadInputShouldFailIfGetModelInputElementTypeFails(uint32_t model_error)
+{
+    status_t status = STATUS_OK;
+
+    get_model_input_element_type_ExpectAndReturn(NULL, model_error);
+    get_model_input_element_type_IgnoreArg_element_type();
+
+    status = read_input();
+
+    TEST_ASSERT_EQUAL_HEX(model_error, status);
+}
+
 TEST_CASE(0)
 TEST_CASE(sizeof(sensor_mock_data_t) - 1)
 TEST_CASE(sizeof(sensor_mock_data_t) + 1)
@@ -139,6 +212,30 @@ void test_ReadInputShouldFailIfGetModelInputSizeFails(uint32_t model_error)
     TEST_ASSERT_EQUAL_HEX(model_error, status);
 }
 
+/**
+ * Tests if read input does not load model input if there are no new samples
+ */
+void test_ReadInputShouldNotReadIfThereAreNoNewSamples(void)
+{
+    status_t status = STATUS_OK;
+    size_t sensor_data_size = sizeof(sensor_mock_data_t);
+    size_t model_input_size = sizeof(sensor_mock_data_t) * SENSOR_MOCK_BUFFER_LEN;
+
+    sensor_get_data_size_ExpectAndReturn(NULL, STATUS_OK);
+    sensor_get_data_size_IgnoreArg_data_size();
+    sensor_get_data_size_ReturnThruPtr_data_size(&sensor_data_size);
+
+    get_model_input_size_ExpectAndReturn(NULL, STATUS_OK);
+    get_model_input_size_IgnoreArg_model_input_size();
+    get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
+
+    sensor_read_data_into_buffer_ExpectAndReturn(SENSOR_STATUS_NO_DATA);
+
+    status = read_input();
+
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_NO_READ, status);
+}
+
 TEST_CASE(SENSOR_STATUS_INV_SENSOR)
 TEST_CASE(SENSOR_STATUS_NO_SENSOR_AVAILABLE)
 /**
@@ -168,9 +265,9 @@ void test_ReadInputShouldFailWhenSensorDataReadFails(uint32_t sensor_error)
 TEST_CASE(SENSOR_STATUS_INV_SENSOR)
 TEST_CASE(SENSOR_STATUS_NO_SENSOR_AVAILABLE)
 /**
- * Tests if read input fails if get sensor data buffer fails
+ * Tests if read input fails if consuming sensor data buffer fails
  */
-void test_ReadInputShouldFailWhenGetSensorDataBufferFails(uint32_t sensor_error)
+void test_ReadInputShouldFailWhenConsumeSensorDataBufferFails(uint32_t sensor_error)
 {
     status_t status = STATUS_OK;
     size_t sensor_data_size = sizeof(sensor_mock_data_t);
@@ -185,7 +282,7 @@ void test_ReadInputShouldFailWhenGetSensorDataBufferFails(uint32_t sensor_error)
     get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
 
     sensor_read_data_into_buffer_IgnoreAndReturn(STATUS_OK);
-    sensor_get_buffered_data_IgnoreAndReturn(sensor_error);
+    sensor_consume_buffered_data_IgnoreAndReturn(sensor_error);
 
     status = read_input();
 
@@ -212,10 +309,235 @@ void test_ReadInputShouldFailWhenLoadModelInputFails(uint32_t model_error)
     get_model_input_size_ReturnThruPtr_model_input_size(&model_input_size);
 
     sensor_read_data_into_buffer_IgnoreAndReturn(STATUS_OK);
-    sensor_get_buffered_data_IgnoreAndReturn(STATUS_OK);
-    load_model_input_IgnoreAndReturn(model_error);
+    sensor_consume_buffered_data_StubWithCallback(mock_sensor_consume_buffered_data);
+    load_model_input_ExpectAndReturn(NULL, model_input_size, model_error);
+    load_model_input_IgnoreArg_model_input();
 
     status = read_input();
 
     TEST_ASSERT_EQUAL_HEX(model_error, status);
 }
+
+// ========================================================
+// get_next_input_time
+// ========================================================
+
+/**
+ * Tests if get next input time returns time of the next sensor read
+ */
+void test_GetNextInputTimeShouldReturnNextSensorReadTime(void)
+{
+    status_t status = STATUS_OK;
+    uint32_t next_read_time = 1234;
+    uint32_t time = 0;
+
+    sensor_get_next_read_time_ExpectAndReturn(&time, STATUS_OK);
+    sensor_get_next_read_time_ReturnThruPtr_time(&next_read_time);
+
+    status = get_next_input_time(&time);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(next_read_time, time);
+}
+
+/**
+ * Tests if get next input time fails for invalid pointer
+ */
+void test_GetNextInputTimeShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+
+    status = get_next_input_time(NULL);
+
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// set_input_stride
+// ========================================================
+
+TEST_CASE(STATUS_OK)
+TEST_CASE(SENSOR_STATUS_INV_ARG)
+/**
+ * Tests if set input stride sets stride of the sensor data
+ */
+void test_SetInputStrideShouldSetSensorStride(status_t sensor_status)
+{
+    status_t status = STATUS_OK;
+
+    sensor_set_stride_ExpectAndReturn(25, sensor_status);
+
+    status = set_input_stride(25);
+
+    TEST_ASSERT_EQUAL_HEX(sensor_status, status);
+}
+
+// ========================================================
+// load_active_window
+// ========================================================
+
+TEST_CASE(0.0F, 0.0F)
+TEST_CASE(1000.0F, 0.0F)
+TEST_CASE(1000.0F, 1.0F)
+/**
+ * Tests if load active window skips the window without activity
+ */
+void test_LoadActiveWindowShouldSkipWindowWithoutActivity(float offset, float amplitude)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t window[SENSOR_MOCK_BUFFER_LEN];
+
+    g_activity_threshold = 4.0F;
+    fill_window(window, offset, amplitude);
+
+    status = load_active_window((uint8_t *)window, sizeof(window));
+
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_NO_READ, status);
+}
+
+TEST_CASE(0.0F, 4.0F)
+TEST_CASE(1000.0F, 4.0F)
+TEST_CASE(-1000.0F, 100.0F)
+/**
+ * Tests if load active window loads the window with activity into model input
+ */
+void test_LoadActiveWindowShouldLoadWindowWithActivity(float offset, float amplitude)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t window[SENSOR_MOCK_BUFFER_LEN];
+
+    g_activity_threshold = 4.0F;
+    fill_window(window, offset, amplitude);
+
+    load_model_input_ExpectAndReturn((uint8_t *)window, sizeof(window), STATUS_OK);
+
+    status = load_active_window((uint8_t *)window, sizeof(window));
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+TEST_CASE(0, 0)
+TEST_CASE(-256, 1)
+TEST_CASE(256, 2)
+/**
+ * Tests if load active window skips the window of raw samples without activity
+ */
+void test_LoadActiveWindowShouldSkipRawWindowWithoutActivity(int16_t offset, int16_t amplitude)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_raw_data_t window[SENSOR_MOCK_BUFFER_LEN];
+
+    g_activity_threshold = 4.0F;
+    g_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+    fill_raw_window(window, offset, amplitude);
+
+    status = load_active_window((uint8_t *)window, sizeof(window));
+
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_NO_READ, status);
+}
+
+TEST_CASE(0, 4)
+TEST_CASE(-256, 100)
+/**
+ * Tests if load active window loads the window of raw samples with activity into model input
+ */
+void test_LoadActiveWindowShouldLoadRawWindowWithActivity(int16_t offset, int16_t amplitude)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_raw_data_t window[SENSOR_MOCK_BUFFER_LEN];
+
+    g_activity_threshold = 4.0F;
+    g_sample_format = SENSOR_SAMPLE_FORMAT_RAW;
+    fill_raw_window(window, offset, amplitude);
+
+    load_model_input_ExpectAndReturn((uint8_t *)window, sizeof(window), STATUS_OK);
+
+    status = load_active_window((uint8_t *)window, sizeof(window));
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+/**
+ * Tests if load active window loads every window into model input if activity threshold is not set
+ */
+void test_LoadActiveWindowShouldLoadEveryWindowIfThresholdIsNotSet(void)
+{
+    status_t status = STATUS_OK;
+    sensor_mock_data_t window[SENSOR_MOCK_BUFFER_LEN];
+
+    fill_window(window, 0.0F, 0.0F);
+
+    load_model_input_ExpectAndReturn((uint8_t *)window, sizeof(window), STATUS_OK);
+
+    status = load_active_window((uint8_t *)window, sizeof(window));
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+}
+
+// ========================================================
+// set_input_activity_threshold
+// ========================================================
+
+TEST_CASE(0.0F)
+TEST_CASE(25.0F)
+/**
+ * Tests if set input activity threshold sets the threshold
+ */
+void test_SetInputActivityThresholdShouldSetThreshold(float threshold)
+{
+    status_t status = STATUS_OK;
+
+    status = set_input_activity_threshold(threshold);
+
+    TEST_ASSERT_EQUAL_HEX(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_FLOAT(threshold, g_activity_threshold);
+}
+
+/**
+ * Tests if set input activity threshold fails for negative or NaN threshold
+ */
+void test_SetInputActivityThresholdShouldFailForInvalidThreshold(void)
+{
+    status_t status = STATUS_OK;
+
+    status = set_input_activity_threshold(-1.0F);
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_STATUS_INV_ARG, status);
+
+    status = set_input_activity_threshold(NAN);
+    TEST_ASSERT_EQUAL_HEX(INPUT_READER_STATUS_INV_ARG, status);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, g_activity_threshold);
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+status_t mock_sensor_consume_buffered_data(sensor_data_consumer_t consumer, int num_calls)
+{
+    sensor_mock_data_t data[SENSOR_MOCK_BUFFER_LEN];
+
+    return consumer((const uint8_t *)data, sizeof(data));
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void fill_window(sensor_mock_data_t *window, float offset, float amplitude)
+{
+    for (size_t i = 0; i < SENSOR_MOCK_BUFFER_LEN; ++i)
+    {
+        window[i].a = offset + ((i % 4) < 2 ? amplitude : -amplitude);
+        window[i].b = offset;
+    }
+}
+
+static void fill_raw_window(sensor_mock_raw_data_t *window, int16_t offset, int16_t amplitude)
+{
+    for (size_t i = 0; i < SENSOR_MOCK_BUFFER_LEN; ++i)
+    {
+        window[i].a = offset + ((i % 4) < 2 ? amplitude : -amplitude);
+        window[i].b = offset;
+    }
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "../iree-runtime/utils/timer.h"
+#include "mock_interrupts.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define TEST_CASE(...)
+
+clint_registers_t g_mock_clint_registers;
+uint32_t g_mock_csr = 0;
+uint32_t g_callback_calls = 0;
+extern clint_timer_t g_timer;
+
+/**
+ * Callback that is called every read from timer register
+ */
+void mock_csr_read_callback();
+
+/**
+ * Sets value of the mocked mtime register
+ *
+ * @param mtime value of the mtime register
+ */
+static void set_mtime(uint64_t mtime);
+
+/**
+ * Returns value of the mocked mtimecmp register
+ *
+ * @returns value of the mtimecmp register
+ */
+static uint64_t get_mtimecmp();
+
+/**
+ * Mock periodic callback that counts its calls
+ */
+static void mock_periodic_callback();
+
+void setUp(void)
+{
+    g_timer.initialized = false;
+    g_callback_calls = 0;
+    memset(&g_mock_clint_registers, 0, sizeof(g_mock_clint_registers));
+    interrupts_lock_IgnoreAndReturn(MSTATUS_MIE);
+    interrupts_unlock_Ignore();
+}
+
+void tearDown(void) {}
+
+// ========================================================
+// timer_init
+// ========================================================
+
+/**
+ * Tests if timer init disarms the alarm
+ */
+void test_TimerInitShouldDisarmAlarm(void)
+{
+    status_t status = STATUS_OK;
+
+    status = timer_init();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_TRUE(g_timer.initialized);
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_LO);
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_HI);
+}
+
+// ========================================================
+// timer_set_alarm
+// ========================================================
+
+TEST_CASE(0x0000000000001000, 0x00002000, 0x0000000000002000)
+TEST_CASE(0x00000001FFFFF000, 0x00001000, 0x0000000200001000)
+TEST_CASE(0x0000000100002000, 0x00001000, 0x0000000100002000)
+/**
+ * Tests if timer set alarm sets compare register to given time, handling the overflow of the low word and the time
+ * from the past
+ */
+void test_TimerSetAlarmShouldSetCompareRegister(uint64_t mtime, uint32_t time, uint64_t mtimecmp)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+    set_mtime(mtime);
+
+    status = timer_set_alarm(time);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX64(mtimecmp, get_mtimecmp());
+}
+
+/**
+ * Tests if timer set alarm fails if timer is not initialized
+ */
+void test_TimerSetAlarmShouldFailIfTimerIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+
+    status = timer_set_alarm(0x1000);
+
+    TEST_ASSERT_EQUAL_UINT(TIMER_STATUS_UNINIT, status);
+}
+
+// ========================================================
+// timer_cancel_alarm
+// ========================================================
+
+/**
+ * Tests if timer cancel alarm disarms the alarm
+ */
+void test_TimerCancelAlarmShouldDisarmAlarm(void)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+    timer_set_alarm(0x1000);
+
+    status = timer_cancel_alarm();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_LO);
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_HI);
+}
+
+/**
+ * Tests if timer cancel alarm keeps periodic callback armed
+ */
+void test_TimerCancelAlarmShouldKeepPeriodicCallback(void)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+    timer_set_periodic_callback(0x2000, mock_periodic_callback);
+    timer_set_alarm(0x1000);
+
+    status = timer_cancel_alarm();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX64(0x2000, get_mtimecmp());
+}
+
+/**
+ * Tests if timer cancel alarm fails if timer is not initialized
+ */
+void test_TimerCancelAlarmShouldFailIfTimerIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+
+    status = timer_cancel_alarm();
+
+    TEST_ASSERT_EQUAL_UINT(TIMER_STATUS_UNINIT, status);
+}
+
+// ========================================================
+// timer_set_periodic_callback
+// ========================================================
+
+/**
+ * Tests if timer set periodic callback arms the timer one period ahead, before the later alarm
+ */
+void test_TimerSetPeriodicCallbackShouldArmTimerOnePeriodAhead(void)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+    set_mtime(0x100);
+    timer_set_alarm(0x5000);
+
+    status = timer_set_periodic_callback(0x1000, mock_periodic_callback);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX64(0x1100, get_mtimecmp());
+}
+
+/**
+ * Tests if timer set periodic callback with NULL callback stops periodic calls
+ */
+void test_TimerSetPeriodicCallbackShouldStopPeriodicCalls(void)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+    timer_set_periodic_callback(0x1000, mock_periodic_callback);
+
+    status = timer_set_periodic_callback(0, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_HEX64(TIMER_DISABLED, get_mtimecmp());
+}
+
+/**
+ * Tests if timer set periodic callback fails for zero period
+ */
+void test_TimerSetPeriodicCallbackShouldFailForZeroPeriod(void)
+{
+    status_t status = STATUS_OK;
+
+    timer_init();
+
+    status = timer_set_periodic_callback(0, mock_periodic_callback);
+
+    TEST_ASSERT_EQUAL_UINT(TIMER_STATUS_INV_ARG, status);
+}
+
+/**
+ * Tests if timer set periodic callback fails if timer is not initialized
+ */
+void test_TimerSetPeriodicCallbackShouldFailIfTimerIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+
+    status = timer_set_periodic_callback(0x1000, mock_periodic_callback);
+
+    TEST_ASSERT_EQUAL_UINT(TIMER_STATUS_UNINIT, status);
+}
+
+// ========================================================
+// timer_irq_handler
+// ========================================================
+
+/**
+ * Tests if timer IRQ handler disarms the expired alarm
+ */
+void test_TimerIRQHandlerShouldDisarmExpiredAlarm(void)
+{
+    timer_init();
+    timer_set_alarm(0x1000);
+    set_mtime(0x1000);
+
+    timer_irq_handler();
+
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_LO);
+    TEST_ASSERT_EQUAL_HEX(MTIMECMP_DISABLED, g_mock_clint_registers.MTIMECMP_HI);
+}
+
+/**
+ * Tests if timer IRQ handler keeps the alarm that is not expired
+ */
+void test_TimerIRQHandlerShouldKeepPendingAlarm(void)
+{
+    timer_init();
+    timer_set_alarm(0x1000);
+    set_mtime(0x800);
+
+    timer_irq_handler();
+
+    TEST_ASSERT_EQUAL_HEX64(0x1000, get_mtimecmp());
+}
+
+TEST_CASE(0x1000, 1, 0x2000)
+TEST_CASE(0x1FFF, 1, 0x2000)
+TEST_CASE(0x3800, 1, 0x4000)
+/**
+ * Tests if timer IRQ handler calls periodic callback and arms the next period on the grid
+ */
+void test_TimerIRQHandlerShouldCallPeriodicCallback(uint64_t mtime, uint32_t calls, uint64_t mtimecmp)
+{
+    timer_init();
+    timer_set_periodic_callback(0x1000, mock_periodic_callback);
+    set_mtime(mtime);
+
+    timer_irq_handler();
+
+    TEST_ASSERT_EQUAL_UINT(calls, g_callback_calls);
+    TEST_ASSERT_EQUAL_HEX64(mtimecmp, get_mtimecmp());
+}
+
+/**
+ * Tests if timer IRQ handler does not call periodic callback before its time
+ */
+void test_TimerIRQHandlerShouldNotCallPeriodicCallbackBeforeItsTime(void)
+{
+    timer_init();
+    timer_set_periodic_callback(0x1000, mock_periodic_callback);
+    timer_set_alarm(0x800);
+    set_mtime(0x800);
+
+    timer_irq_handler();
+
+    TEST_ASSERT_EQUAL_UINT(0, g_callback_calls);
+    TEST_ASSERT_EQUAL_HEX64(0x1000, get_mtimecmp());
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+void mock_csr_read_callback() {}
+
+static void mock_periodic_callback() { ++g_callback_calls; }
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void set_mtime(uint64_t mtime)
+{
+    g_mock_clint_registers.MTIME_LO = (uint32_t)mtime;
+    g_mock_clint_registers.MTIME_HI = (uint32_t)(mtime >> 32);
+}
+
+static uint64_t get_mtimecmp()
+{
+    return ((uint64_t)g_mock_clint_registers.MTIMECMP_HI << 32) | g_mock_clint_registers.MTIMECMP_LO;
+}
@@ -14,12 +14,22 @@
 uart_registers_t g_mock_uart_registers;
 uint32_t g_mock_csr = 0;
 extern uart_t g_uart;
+const uint8_t *g_sent_data = NULL;
+size_t g_sent_data_length = 0;
 
 /**
  * Callback that is called every read from timer register. It simulates time passing by incrementing this register.
  */
 void mock_csr_read_callback();
 
+/**
+ * Callback that is called when UART async write is finished. It stores the sent buffer.
+ *
+ * @param data sent data
+ * @param data_length length of the sent data
+ */
+static void mock_uart_write_callback(const uint8_t *data, const size_t data_length);
+
 /**
  * Prepares example valid UART config
  *
@@ -52,13 +62,28 @@ static void clear_RSRECR_ERR_flag();
  */
 static void set_RSRECR_ERR_flag();
 
+/**
+ * Sets given flags in UART masked interrupt status register
+ *
+ * @param flags interrupt flags
+ */
+static void set_MIS_flags(uint32_t flags);
+
+/**
+ * Sets transmit FIFO full flag in UART flag register
+ */
+static void set_FR_TXFF_flag();
+
 void setUp(void)
 {
     g_uart.initialized = false;
+    g_uart.irq_enabled = false;
     memset(&g_mock_uart_registers, 0, sizeof(g_mock_uart_registers));
     clear_FR_RXFE_flag();
     clear_FR_TXFF_flag();
     clear_RSRECR_ERR_flag();
+    g_sent_data = NULL;
+    g_sent_data_length = 0;
 }
 
 void tearDown(void) {}
@@ -399,7 +424,7 @@ void test_UARTGetCharShouldFailForInvalidPointer(void)
 void test_UARTReadShouldReadDataFromDR(void)
 {
     status_t status = STATUS_OK;
-    const uint32_t dr = 0xABCD;
+    const uint32_t dr = 0xA0CD;
     const uint8_t c = (uint8_t)(dr & DR_DATA_MASK);
     uint8_t data[8];
 
@@ -412,6 +437,30 @@ void test_UARTReadShouldReadDataFromDR(void)
     TEST_ASSERT_EACH_EQUAL_UINT8(c, data, sizeof(data));
 }
 
+/**
+ * Tests if UART read takes received bytes that wrap around the end of the RX buffer in interrupt-driven mode
+ */
+void test_UARTReadShouldReadDataWrappedAroundRXBuffer(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    const uint8_t expected[] = {1, 2, 3, 4};
+    uint8_t data[sizeof(expected)] = {0};
+
+    uart_init(&config);
+    uart_irq_enable();
+    g_uart.rx_buffer.tail = UART_RX_BUFFER_SIZE - 2;
+    g_uart.rx_buffer.head = UART_RX_BUFFER_SIZE + 2;
+    memcpy(&g_uart.rx_buffer.data[UART_RX_BUFFER_SIZE - 2], expected, 2);
+    memcpy(g_uart.rx_buffer.data, &expected[2], 2);
+
+    status = uart_read(data, sizeof(data));
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, sizeof(expected));
+    TEST_ASSERT_EQUAL_UINT(g_uart.rx_buffer.head, g_uart.rx_buffer.tail);
+}
+
 /**
  * Tests if UART read fails if UART is not initalized
  */
@@ -467,7 +516,7 @@ void test_UARTReadShouldFailIfReceiveErrorOccurs(void)
     status_t status = STATUS_OK;
     uint8_t data[8];
 
-    set_RSRECR_ERR_flag();
+    g_mock_uart_registers.DR = 'a' | DR_ERR_MASK;
     g_uart.initialized = true;
 
     status = uart_read(data, sizeof(data));
@@ -491,12 +540,474 @@ void test_UARTReadShouldReturnTimeoutIfNoData(void)
     TEST_ASSERT_EQUAL_UINT(UART_STATUS_TIMEOUT, status);
 }
 
+// ========================================================
+// uart_check_baudrate
+// ========================================================
+
+TEST_CASE(110u)
+TEST_CASE(115200u)
+TEST_CASE(460800u)
+TEST_CASE(921600u)
+TEST_CASE(1500000u)
+/**
+ * Tests if UART check baudrate accepts supported baudrates
+ */
+void test_UARTCheckBaudrateShouldSucceedForSupportedBaudrate(uint32_t baudrate)
+{
+    status_t status = STATUS_OK;
+
+    status = uart_check_baudrate(baudrate);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+}
+
+TEST_CASE(0u)
+TEST_CASE(500000u)
+TEST_CASE(3000000u)
+TEST_CASE(-1)
+/**
+ * Tests if UART check baudrate rejects unsupported baudrates
+ */
+void test_UARTCheckBaudrateShouldFailForUnsupportedBaudrate(uint32_t baudrate)
+{
+    status_t status = STATUS_OK;
+
+    status = uart_check_baudrate(baudrate);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_INV_ARG_BAUDRATE, status);
+}
+
+// ========================================================
+// uart_set_baudrate
+// ========================================================
+
+TEST_CASE(9600u, 156u)
+TEST_CASE(115200u, 13u)
+TEST_CASE(921600u, 1u)
+TEST_CASE(1500000u, 1u)
+/**
+ * Tests if UART set baudrate reprograms baudrate divisor and keeps UART enabled
+ */
+void test_UARTSetBaudrateShouldWriteBaudrateDivisor(uint32_t baudrate, uint32_t ibrd)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+
+    status = uart_set_baudrate(baudrate);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(ibrd, g_mock_uart_registers.IBRD);
+    TEST_ASSERT_EQUAL_UINT(baudrate, uart_get_baudrate());
+    TEST_ASSERT_TRUE(g_mock_uart_registers.LCRH & LCRH_FEN);
+    TEST_ASSERT_TRUE(g_mock_uart_registers.CR & CR_UARTEN);
+}
+
+/**
+ * Tests if UART set baudrate fails for unsupported baudrate and keeps current one
+ */
+void test_UARTSetBaudrateShouldFailForUnsupportedBaudrate(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+
+    status = uart_set_baudrate(500000u);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_INV_ARG_BAUDRATE, status);
+    TEST_ASSERT_EQUAL_UINT(config.baudrate, uart_get_baudrate());
+}
+
+/**
+ * Tests if UART set baudrate fails if UART is not initialized
+ */
+void test_UARTSetBaudrateShouldFailIfUARTIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+
+    status = uart_set_baudrate(115200u);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_UNINIT, status);
+    TEST_ASSERT_EQUAL_UINT(0, uart_get_baudrate());
+}
+
+// ========================================================
+// uart_irq_enable
+// ========================================================
+
+/**
+ * Tests if UART IRQ enable unmasks receive interrupts
+ */
+void test_UARTIRQEnableShouldUnmaskReceiveInterrupts(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+
+    status = uart_irq_enable();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_TRUE(g_uart.irq_enabled);
+    TEST_ASSERT_EQUAL_HEX(INT_RX | INT_RT | INT_ERR_MASK, g_mock_uart_registers.IMSC);
+}
+
+/**
+ * Tests if UART IRQ enable fails if UART is not initialized
+ */
+void test_UARTIRQEnableShouldFailIfUARTIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+
+    status = uart_irq_enable();
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_UNINIT, status);
+    TEST_ASSERT_FALSE(g_uart.irq_enabled);
+    TEST_ASSERT_EQUAL_HEX(0, g_mock_uart_registers.IMSC);
+}
+
+// ========================================================
+// uart_irq_handler
+// ========================================================
+
+/**
+ * Tests if UART IRQ handler moves received bytes to the RX buffer
+ */
+void test_UARTIRQHandlerShouldMoveReceivedBytesToRXBuffer(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[2 * UART_FIFO_DEPTH] = {0};
+    size_t read = 0;
+
+    uart_init(&config);
+    uart_irq_enable();
+    g_mock_uart_registers.DR = 'a';
+    set_MIS_flags(INT_RX);
+
+    uart_irq_handler();
+    set_FR_RXFE_flag();
+    status = uart_read_nonblocking(data, sizeof(data), &read);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(UART_FIFO_DEPTH, read);
+    TEST_ASSERT_EACH_EQUAL_UINT8('a', data, read);
+    TEST_ASSERT_EQUAL_HEX(INT_RX, g_mock_uart_registers.ICR);
+}
+
+/**
+ * Tests if UART get char returns error if IRQ handler received byte with error
+ */
+void test_UARTIRQHandlerShouldReportReceiveError(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t c = 0;
+
+    uart_init(&config);
+    uart_irq_enable();
+    g_mock_uart_registers.DR = 'a' | DR_ERR_MASK;
+    set_MIS_flags(INT_RX);
+
+    uart_irq_handler();
+    status = uart_getchar(&c);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_RECV_ERROR, status);
+}
+
+/**
+ * Tests if UART IRQ handler sends bytes queued when transmit FIFO was full
+ */
+void test_UARTIRQHandlerShouldSendQueuedBytes(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+    uart_irq_enable();
+    set_FR_TXFF_flag();
+
+    status = uart_putchar('a');
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, g_mock_uart_registers.DR);
+    TEST_ASSERT_TRUE(g_mock_uart_registers.IMSC & INT_TX);
+
+    clear_FR_TXFF_flag();
+    set_MIS_flags(INT_TX);
+    uart_irq_handler();
+
+    TEST_ASSERT_EQUAL_UINT('a', g_mock_uart_registers.DR);
+    TEST_ASSERT_FALSE(g_mock_uart_registers.IMSC & INT_TX);
+}
+
+/**
+ * Tests if UART get char returns no data in interrupt-driven mode if nothing was received
+ */
+void test_UARTGetCharShouldReturnNoDataIfRXBufferIsEmpty(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t c = 0;
+
+    uart_init(&config);
+    uart_irq_enable();
+
+    status = uart_getchar(&c);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_NO_DATA, status);
+}
+
+// ========================================================
+// uart_write_nonblocking
+// ========================================================
+
+/**
+ * Tests if UART non-blocking write returns immediately when transmit FIFO is full
+ */
+void test_UARTWriteNonblockingShouldNotWaitIfTXFIFOIsFull(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[] = "abc";
+    size_t written = 1;
+
+    uart_init(&config);
+    set_FR_TXFF_flag();
+
+    status = uart_write_nonblocking(data, sizeof(data), &written);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, written);
+    TEST_ASSERT_EQUAL_UINT(0, g_mock_uart_registers.DR);
+}
+
+/**
+ * Tests if UART non-blocking write queues bytes in interrupt-driven mode
+ */
+void test_UARTWriteNonblockingShouldQueueBytesInIRQMode(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[] = "abc";
+    size_t written = 0;
+
+    uart_init(&config);
+    uart_irq_enable();
+    set_FR_TXFF_flag();
+
+    status = uart_write_nonblocking(data, sizeof(data), &written);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(sizeof(data), written);
+    TEST_ASSERT_TRUE(g_mock_uart_registers.IMSC & INT_TX);
+}
+
+/**
+ * Tests if UART non-blocking write fails for invalid pointer
+ */
+void test_UARTWriteNonblockingShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    size_t written = 0;
+
+    uart_init(&config);
+
+    status = uart_write_nonblocking(NULL, 1, &written);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// uart_write_async
+// ========================================================
+
+/**
+ * Tests if UART async write queues buffer in interrupt-driven mode and calls callback once it is sent
+ */
+void test_UARTWriteAsyncShouldQueueBufferInIRQMode(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[] = "abc";
+
+    uart_init(&config);
+    uart_irq_enable();
+    set_FR_TXFF_flag();
+
+    status = uart_write_async(data, sizeof(data), mock_uart_write_callback);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_NULL(g_sent_data);
+    TEST_ASSERT_TRUE(g_mock_uart_registers.IMSC & INT_TX);
+
+    clear_FR_TXFF_flag();
+    set_MIS_flags(INT_TX);
+    uart_irq_handler();
+
+    TEST_ASSERT_EQUAL_UINT(data[sizeof(data) - 1], g_mock_uart_registers.DR);
+    TEST_ASSERT_EQUAL_PTR(data, g_sent_data);
+    TEST_ASSERT_EQUAL_UINT(sizeof(data), g_sent_data_length);
+    TEST_ASSERT_FALSE(g_mock_uart_registers.IMSC & INT_TX);
+}
+
+/**
+ * Tests if UART async write sends data and calls callback immediately in polling mode
+ */
+void test_UARTWriteAsyncShouldSendDataImmediatelyInPollingMode(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[] = "abc";
+
+    uart_init(&config);
+
+    status = uart_write_async(data, sizeof(data), mock_uart_write_callback);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(data[sizeof(data) - 1], g_mock_uart_registers.DR);
+    TEST_ASSERT_EQUAL_PTR(data, g_sent_data);
+    TEST_ASSERT_EQUAL_UINT(sizeof(data), g_sent_data_length);
+}
+
+/**
+ * Tests if UART flush waits until queued buffers are sent
+ */
+void test_UARTFlushShouldSendQueuedBuffers(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[] = "abc";
+
+    uart_init(&config);
+    uart_irq_enable();
+
+    status = uart_write_async(data, sizeof(data), mock_uart_write_callback);
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+
+    status = uart_flush();
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_PTR(data, g_sent_data);
+}
+
+/**
+ * Tests if UART async write fails for invalid pointer
+ */
+void test_UARTWriteAsyncShouldFailForInvalidPointer(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+
+    status = uart_write_async(NULL, 1, NULL);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_INV_PTR, status);
+}
+
+// ========================================================
+// uart_read_nonblocking
+// ========================================================
+
+/**
+ * Tests if UART non-blocking read returns immediately when no data is received
+ */
+void test_UARTReadNonblockingShouldNotWaitIfNoDataIsReceived(void)
+{
+    status_t status = STATUS_OK;
+    uart_config_t config = get_valid_uart_config_t();
+    uint8_t data[4] = {0};
+    size_t read = 1;
+
+    uart_init(&config);
+    set_FR_RXFE_flag();
+
+    status = uart_read_nonblocking(data, sizeof(data), &read);
+
+    TEST_ASSERT_EQUAL_UINT(STATUS_OK, status);
+    TEST_ASSERT_EQUAL_UINT(0, read);
+}
+
+/**
+ * Tests if UART non-blocking read fails if UART is not initialized
+ */
+void test_UARTReadNonblockingShouldFailIfUARTIsNotInitialized(void)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[4] = {0};
+    size_t read = 0;
+
+    status = uart_read_nonblocking(data, sizeof(data), &read);
+
+    TEST_ASSERT_EQUAL_UINT(UART_STATUS_UNINIT, status);
+}
+
+// ========================================================
+// uart_rx_pending
+// ========================================================
+
+/**
+ * Tests if UART RX pending reports bytes stored in the RX buffer in interrupt-driven mode
+ */
+void test_UARTRXPendingShouldReportReceivedBytesInIRQMode(void)
+{
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+    uart_irq_enable();
+
+    TEST_ASSERT_FALSE(uart_rx_pending());
+
+    set_MIS_flags(INT_RX);
+    uart_irq_handler();
+
+    TEST_ASSERT_TRUE(uart_rx_pending());
+}
+
+/**
+ * Tests if UART RX pending checks receive FIFO in polling mode
+ */
+void test_UARTRXPendingShouldCheckReceiveFIFOInPollingMode(void)
+{
+    uart_config_t config = get_valid_uart_config_t();
+
+    uart_init(&config);
+
+    TEST_ASSERT_TRUE(uart_rx_pending());
+
+    set_FR_RXFE_flag();
+
+    TEST_ASSERT_FALSE(uart_rx_pending());
+}
+
+/**
+ * Tests if UART RX pending returns false if UART is not initialized
+ */
+void test_UARTRXPendingShouldReturnFalseIfUARTIsNotInitialized(void)
+{
+    bool pending = true;
+
+    pending = uart_rx_pending();
+
+    TEST_ASSERT_FALSE(pending);
+}
+
 // ========================================================
 // mocks
 // ========================================================
 
 void mock_csr_read_callback() { g_mock_csr += TIMER_CLOCK_FREQ >> 4; }
 
+static void mock_uart_write_callback(const uint8_t *data, const size_t data_length)
+{
+    g_sent_data = data;
+    g_sent_data_length = data_length;
+}
+
 // ========================================================
 // helper functions
 // ========================================================
@@ -528,3 +1039,15 @@ static void set_FR_RXFE_flag()
 static void clear_RSRECR_ERR_flag() { g_mock_uart_registers.RSRECR &= ~RSRECR_ERR_MASK; }
 
 static void set_RSRECR_ERR_flag() { g_mock_uart_registers.RSRECR |= RSRECR_ERR_MASK; }
+
+static void set_MIS_flags(uint32_t flags)
+{
+    uint32_t *MIS_ptr = (uint32_t *)&g_mock_uart_registers.MIS;
+    *MIS_ptr |= flags;
+}
+
+static void set_FR_TXFF_flag()
+{
+    uint32_t *FR_ptr = (uint32_t *)&g_mock_uart_registers.FR;
+    *FR_ptr |= FR_TXFF;
+}